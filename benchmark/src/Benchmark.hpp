@@ -0,0 +1,80 @@
+#ifndef INC_Benchmark_hpp
+#define INC_Benchmark_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <ctime> // clock_gettime()
+#include <string>
+#include <vector>
+
+struct Benchmark_Options
+{
+    uint32_t seed;
+    uint64_t nb_draws;
+    int      nb_ranks;
+    uint64_t nb_generators;
+};
+
+// Each benchmark prints its own report to stdout.
+typedef void (*Benchmark_Function)(const Benchmark_Options &options);
+
+// See Interleaved.cpp
+void Benchmark_Interleaved(const Benchmark_Options &options);
+// See Latency.cpp
+void Benchmark_Latency(const Benchmark_Options &options);
+// See Ranks.cpp
+void Benchmark_Ranks(const Benchmark_Options &options);
+// See Seeding.cpp
+void Benchmark_Seeding(const Benchmark_Options &options);
+// See Shuffle.cpp
+void Benchmark_Shuffle(const Benchmark_Options &options);
+
+// **************************************************************
+inline uint64_t Read_Cycle_Counter()
+/**
+ * Return the processor's time stamp counter on x86, or a nanoseconds
+ * clock elsewhere.
+ */
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t low, high;
+    __asm__ __volatile__ ("rdtsc" : "=a" (low), "=d" (high) : : "memory");
+    return (uint64_t(high) << 32) | uint64_t(low);
+#else
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * uint64_t(1000000000) + uint64_t(now.tv_nsec);
+#endif
+}
+
+// **************************************************************
+// Histogram of durations in cycles. Durations up to "nb_exact_bins"
+// cycles are counted exactly, longer ones in a single overflow bin
+// (the maximum is still kept).
+class Latency_Histogram
+{
+    std::vector<uint64_t> bins;
+    uint64_t count;
+    uint64_t total;
+    uint64_t maximum;
+
+    public:
+        static const uint64_t nb_exact_bins = 1 << 16;
+
+                     Latency_Histogram() : bins(nb_exact_bins + 1, 0), count(0), total(0), maximum(0) {}
+        inline void  Add(const uint64_t cycles)
+        {
+            bins[cycles < nb_exact_bins ? cycles : nb_exact_bins]++;
+            count++;
+            total += cycles;
+            if (cycles > maximum)
+                maximum = cycles;
+        }
+        uint64_t     Percentile(const double fraction) const;
+        double       Mean() const       { return (count == 0 ? 0.0 : double(total) / double(count)); }
+        uint64_t     Maximum() const    { return maximum; }
+        uint64_t     Count() const      { return count;   }
+};
+
+#endif // INC_Benchmark_hpp
+
+// ********** End of file ***************************************
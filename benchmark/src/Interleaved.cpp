@@ -0,0 +1,94 @@
+/***************************************************************
+ * Bulk generation throughput: one dSFMT state (PRNG::Fill_Array())
+ * against 4 and 8 interleaved states (PRNG_xN), consumed in chunks
+ * small enough to stay in cache.
+ ***************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <sys/time.h> // gettimeofday()
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <PRNG_xN.hpp>
+
+#include "Benchmark.hpp"
+
+// Numbers per Fill_Array() call
+const uint64_t interleaved_chunk = 8192;
+
+// **************************************************************
+static double Seconds()
+{
+    timeval now;
+    gettimeofday(&now, NULL);
+    return double(now.tv_sec) + 1.0e-6 * double(now.tv_usec);
+}
+
+// **************************************************************
+static void Print_Interleaved(const std::string &name, const double seconds, const uint64_t n, const double reference, const double checksum)
+{
+    std::cout << std::left  << std::setw(32) << name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(12) << seconds
+              << std::setprecision(3) << std::setw(16) << 1.0e9 * seconds / double(n)
+              << std::setprecision(2) << std::setw(12) << reference / seconds
+              << std::setprecision(1) << std::setw(16) << checksum << "\n";
+}
+
+// **************************************************************
+void Benchmark_Interleaved(const Benchmark_Options &options)
+{
+    const uint64_t nb_chunks = (options.nb_draws + interleaved_chunk - 1) / interleaved_chunk;
+    const uint64_t n = nb_chunks * interleaved_chunk;
+    std::vector<double> chunk(interleaved_chunk);
+
+    PRNG prng;
+    prng.Initialize(options.seed, true); // quiet = true
+    std::cout << prng.Get_Id_String() << ", " << PRNG_xN::Get_ISA() << " recursion, "
+              << n << " numbers in [0,1[ by chunks of " << interleaved_chunk << "\n"
+              << std::left  << std::setw(32) << "generator" << std::right
+              << std::setw(12) << "time (s)" << std::setw(16) << "ns/number"
+              << std::setw(12) << "speedup" << std::setw(16) << "checksum" << "\n";
+
+    double checksum = 0.0;
+    double start = Seconds();
+    for (uint64_t c = 0 ; c < nb_chunks ; c++)
+    {
+        prng.Fill_Array(&chunk[0], interleaved_chunk, PRNG_Close0_Open1);
+        checksum += chunk[c % interleaved_chunk];
+    }
+    const double reference = Seconds() - start;
+    Print_Interleaved("PRNG::Fill_Array()", reference, n, reference, checksum);
+
+    for (int nb_lanes = 4 ; nb_lanes <= 8 ; nb_lanes *= 2)
+    {
+        PRNG_xN prngs(nb_lanes);
+        prngs.Initialize(options.seed);
+
+        checksum = 0.0;
+        start = Seconds();
+        for (uint64_t c = 0 ; c < nb_chunks ; c++)
+        {
+            prngs.Fill_Array(&chunk[0], interleaved_chunk, PRNG_Close0_Open1);
+            checksum += chunk[c % interleaved_chunk];
+        }
+        std::ostringstream name;
+        name << "PRNG_xN(" << nb_lanes << ")::Fill_Array()";
+        Print_Interleaved(name.str(), Seconds() - start, n, reference, checksum);
+
+        checksum = 0.0;
+        start = Seconds();
+        for (uint64_t c = 0 ; c < nb_chunks ; c++)
+        {
+            prngs.Fill_Lanes(&chunk[0], interleaved_chunk / uint64_t(nb_lanes), PRNG_Close0_Open1);
+            checksum += chunk[c % interleaved_chunk];
+        }
+        name.str("");
+        name << "PRNG_xN(" << nb_lanes << ")::Fill_Lanes()";
+        Print_Interleaved(name.str(), Seconds() - start, n, reference, checksum);
+    }
+}
+
+// ********** End of file ***************************************
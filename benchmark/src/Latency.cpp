@@ -0,0 +1,106 @@
+/***************************************************************
+ * Per call latency of the one at a time generators. PRNG pays
+ * for a whole dSFMT block on the call exhausting the previous one,
+ * Incremental_PRNG spreads that cost over the block's calls, and
+ * Async_PRNG moves it to a helper thread.
+ ***************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Incremental_PRNG.hpp>
+#include <Async_PRNG.hpp>
+
+#include "Benchmark.hpp"
+
+// **************************************************************
+uint64_t Latency_Histogram::Percentile(const double fraction) const
+/**
+ * Return the smallest duration such that at least "fraction" of the
+ * durations are shorter or equal.
+ */
+{
+    const double target = fraction * double(count);
+    uint64_t cumulative = 0;
+    for (uint64_t i = 0 ; i < nb_exact_bins ; i++)
+    {
+        cumulative += bins[i];
+        if (double(cumulative) >= target)
+            return i;
+    }
+    return maximum;
+}
+
+// **************************************************************
+template <class Generator>
+void Measure_Latency(Generator &generator, const uint64_t nb_draws, Latency_Histogram &histogram)
+/**
+ * Time each call individually. The timer's own overhead is included;
+ * see the "timer only" line of the report.
+ */
+{
+    volatile double sink;
+    for (uint64_t i = 0 ; i < nb_draws ; i++)
+    {
+        const uint64_t start = Read_Cycle_Counter();
+        sink = generator.Get_Random_Close1_Open2();
+        histogram.Add(Read_Cycle_Counter() - start);
+    }
+    (void) sink;
+}
+
+// **************************************************************
+class No_Generator
+{
+    public:
+        double Get_Random_Close1_Open2() { return 1.0; }
+};
+
+// **************************************************************
+void Print_Latency(const std::string &name, const Latency_Histogram &histogram)
+{
+    std::cout << std::left  << std::setw(20) << name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1) << histogram.Mean()
+              << std::setw(10) << histogram.Percentile(0.5)
+              << std::setw(10) << histogram.Percentile(0.99)
+              << std::setw(10) << histogram.Percentile(0.999)
+              << std::setw(12) << histogram.Maximum() << "\n";
+}
+
+// **************************************************************
+void Benchmark_Latency(const Benchmark_Options &options)
+{
+    PRNG prng;
+    prng.Initialize(options.seed, true); // quiet = true
+    Incremental_PRNG incremental_prng;
+    incremental_prng.Initialize(options.seed, true); // quiet = true
+    Async_PRNG async_prng;
+    async_prng.Initialize(options.seed, true); // quiet = true
+    No_Generator no_generator;
+
+    std::cout << prng.Get_Id_String() << ", " << options.nb_draws << " draws, cycles per call\n"
+              << std::left  << std::setw(20) << "generator" << std::right
+              << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(12) << "max" << "\n";
+
+    // Warm up caches and the helper thread
+    Latency_Histogram warm_up;
+    Measure_Latency(prng,               options.nb_draws / 10 + 1, warm_up);
+    Measure_Latency(incremental_prng,   options.nb_draws / 10 + 1, warm_up);
+    Measure_Latency(async_prng,         options.nb_draws / 10 + 1, warm_up);
+
+    Latency_Histogram timer, bursty, incremental, async;
+    Measure_Latency(no_generator,       options.nb_draws, timer);
+    Measure_Latency(prng,               options.nb_draws, bursty);
+    Measure_Latency(incremental_prng,   options.nb_draws, incremental);
+    Measure_Latency(async_prng,         options.nb_draws, async);
+
+    Print_Latency("timer only",         timer);
+    Print_Latency("PRNG (bursty)",      bursty);
+    Print_Latency("Incremental_PRNG",   incremental);
+    Print_Latency("Async_PRNG",         async);
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,119 @@
+/***************************************************************
+ * Performance measurements of the library.
+ * Each benchmark compares implementations of the same feature
+ * and prints a table; see "./prng_benchmark --help".
+ ***************************************************************/
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <stdint.h> // (u)int64_t
+#include <unistd.h> // sysconf()
+
+#include "Benchmark.hpp"
+
+struct Benchmark
+{
+    const char         *name;
+    Benchmark_Function  function;
+    const char         *description;
+};
+
+const Benchmark benchmarks[] = {
+    {"interleaved", Benchmark_Interleaved, "Bulk throughput of one dSFMT state vs 4 and 8 interleaved ones"},
+    {"latency",     Benchmark_Latency,     "Per call latency (p50/p99/p99.9) of bursty vs incremental refill"},
+    {"ranks",       Benchmark_Ranks,       "Aggregate throughput of forked processes on rank substreams"},
+    {"seeding",     Benchmark_Seeding,     "Startup time of many generators: Initialize() vs seed sequences"},
+    {"shuffle",     Benchmark_Shuffle,     "Shuffling --draws indices: std::random_shuffle() vs prng::Shuffle()"}
+};
+const int nb_benchmarks = int(sizeof(benchmarks) / sizeof(Benchmark));
+
+void Usage(const char *program);
+bool Parse_Options(int argc, char *argv[], Benchmark_Options &options, std::string &name);
+
+// **************************************************************
+int main(int argc, char *argv[])
+{
+    Benchmark_Options options;
+    std::string name;
+    if (!Parse_Options(argc, argv, options, name))
+    {
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bool found = false;
+    for (int b = 0 ; b < nb_benchmarks ; b++)
+    {
+        if (name == "all" || name == benchmarks[b].name)
+        {
+            std::cout << "### " << benchmarks[b].name << ": " << benchmarks[b].description << "\n";
+            benchmarks[b].function(options);
+            std::cout << "\n" << std::flush;
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// **************************************************************
+void Usage(const char *program)
+{
+    std::cerr
+        << "Usage: " << program << " [options] [benchmark]\n"
+        << "Run a benchmark, or all of them (default).\n"
+        << "    --seed S        Seed (default: 5489)\n"
+        << "    --draws N       Number of draws (default: 10000000)\n"
+        << "    --ranks N       Maximum number of processes (default: number of processors)\n"
+        << "    --generators N  Number of generators to initialize (default: 100000)\n"
+        << "Benchmarks:\n";
+    for (int b = 0 ; b < nb_benchmarks ; b++)
+        std::cerr << "    " << std::string(benchmarks[b].name).append(16 - std::string(benchmarks[b].name).size(), ' ')
+                  << benchmarks[b].description << "\n";
+}
+
+// **************************************************************
+bool Parse_Options(int argc, char *argv[], Benchmark_Options &options, std::string &name)
+{
+    options.seed        = 5489;
+    options.nb_draws    = 10000000;
+    options.nb_ranks    = int(sysconf(_SC_NPROCESSORS_ONLN));
+    options.nb_generators = 100000;
+    name                = "all";
+
+    for (int i = 1 ; i < argc ; i++)
+    {
+        const std::string option(argv[i]);
+        if (option == "--help" || option == "-h")
+            return false;
+        else if (option[0] != '-')
+        {
+            name = option;
+            continue;
+        }
+        else if (i+1 >= argc)
+            return false;
+
+        const char *value = argv[++i];
+        if (option == "--seed")
+            options.seed = uint32_t(strtoul(value, NULL, 0));
+        else if (option == "--draws")
+            options.nb_draws = uint64_t(strtod(value, NULL));
+        else if (option == "--ranks")
+            options.nb_ranks = atoi(value);
+        else if (option == "--generators")
+            options.nb_generators = uint64_t(strtod(value, NULL));
+        else
+            return false;
+    }
+
+    return (options.nb_draws > 0 && options.nb_ranks > 0 && options.nb_generators > 0);
+}
+
+// ********** End of file ***************************************
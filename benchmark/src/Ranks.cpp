@@ -0,0 +1,146 @@
+/***************************************************************
+ * Aggregate throughput of many processes, one per rank, each
+ * drawing from its own substream (PRNG::Initialize_Rank()), as
+ * a parallel job would. The processes are forked locally.
+ ***************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h> // fork(), pipe()
+#include <sys/wait.h> // waitpid()
+#include <sys/time.h> // gettimeofday()
+
+#include <PseudoRandomNumberGenerator.hpp>
+
+#include "Benchmark.hpp"
+
+// What each rank reports back to the launcher
+struct Rank_Report
+{
+    double initialization;  // Seconds
+    double generation;      // Seconds
+    double sum;             // Keeps the numbers from being optimized away
+};
+
+// **************************************************************
+static double Seconds()
+{
+    timeval now;
+    gettimeofday(&now, NULL);
+    return double(now.tv_sec) + 1.0e-6 * double(now.tv_usec);
+}
+
+// **************************************************************
+static void Run_Rank(const Benchmark_Options &options, const int rank, const int nb_ranks, const int fd)
+/**
+ * Child process: draw "options.nb_draws" numbers by chunks and write
+ * the report to "fd".
+ */
+{
+    Rank_Report report;
+    const double start = Seconds();
+    PRNG prng;
+    prng.Initialize_Rank(options.seed, rank, nb_ranks, true); // quiet = true
+    report.initialization = Seconds() - start;
+
+    const uint64_t chunk_size = uint64_t(1) << 16;
+    std::vector<double> chunk(chunk_size);
+    report.sum = 0.0;
+    const double start_generation = Seconds();
+    for (uint64_t i = 0 ; i < options.nb_draws ; i += chunk_size)
+    {
+        const uint64_t n = (options.nb_draws - i < chunk_size ? options.nb_draws - i : chunk_size);
+        prng.Fill_Array_Close1_Open2(&chunk[0], n);
+        report.sum += chunk[0];
+    }
+    report.generation = Seconds() - start_generation;
+
+    const bool success = (write(fd, &report, sizeof(report)) == ssize_t(sizeof(report)));
+    close(fd);
+    _exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+// **************************************************************
+static bool Launch_Ranks(const Benchmark_Options &options, const int nb_ranks,
+                         double &wall, double &initialization, double &generation)
+/**
+ * Fork "nb_ranks" processes and wait for all of them. Return the wall
+ * time and the slowest rank's initialization and generation times.
+ */
+{
+    std::vector<pid_t> pids(nb_ranks);
+    std::vector<int> pipes(nb_ranks);
+
+    const double start = Seconds();
+    for (int rank = 0 ; rank < nb_ranks ; rank++)
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+            return false;
+        pids[rank] = fork();
+        if (pids[rank] < 0)
+            return false;
+        if (pids[rank] == 0)
+        {
+            close(fds[0]);
+            Run_Rank(options, rank, nb_ranks, fds[1]);
+        }
+        close(fds[1]);
+        pipes[rank] = fds[0];
+    }
+
+    bool success = true;
+    initialization  = 0.0;
+    generation      = 0.0;
+    for (int rank = 0 ; rank < nb_ranks ; rank++)
+    {
+        Rank_Report report;
+        success = (read(pipes[rank], &report, sizeof(report)) == ssize_t(sizeof(report))) && success;
+        close(pipes[rank]);
+        int status;
+        success = (waitpid(pids[rank], &status, 0) == pids[rank] && WIFEXITED(status)
+                   && WEXITSTATUS(status) == EXIT_SUCCESS) && success;
+        if (report.initialization > initialization)
+            initialization = report.initialization;
+        if (report.generation > generation)
+            generation = report.generation;
+    }
+    wall = Seconds() - start;
+
+    return success;
+}
+
+// **************************************************************
+void Benchmark_Ranks(const Benchmark_Options &options)
+{
+    PRNG prng;
+    prng.Initialize(options.seed, true); // quiet = true
+    std::cout << prng.Get_Id_String() << ", " << options.nb_draws << " draws per rank, up to "
+              << options.nb_ranks << " ranks\n"
+              << std::setw(8) << "ranks" << std::setw(12) << "init (s)" << std::setw(12) << "draws (s)"
+              << std::setw(12) << "wall (s)" << std::setw(16) << "total (M/s)" << std::setw(12) << "efficiency" << "\n";
+
+    double single = 0.0;
+    for (int nb_ranks = 1 ; ; nb_ranks = (2*nb_ranks < options.nb_ranks ? 2*nb_ranks : options.nb_ranks))
+    {
+        double wall, initialization, generation;
+        if (!Launch_Ranks(options, nb_ranks, wall, initialization, generation))
+        {
+            std::cout << "Couldn't run " << nb_ranks << " ranks\n";
+            return;
+        }
+        const double throughput = double(nb_ranks) * double(options.nb_draws) / wall;
+        if (nb_ranks == 1)
+            single = throughput;
+        std::cout << std::setw(8) << nb_ranks << std::fixed << std::setprecision(3)
+                  << std::setw(12) << initialization << std::setw(12) << generation << std::setw(12) << wall
+                  << std::setprecision(1) << std::setw(16) << 1.0e-6 * throughput
+                  << std::setprecision(2) << std::setw(12) << throughput / (double(nb_ranks) * single) << "\n";
+        if (nb_ranks >= options.nb_ranks)
+            break;
+    }
+}
+
+// ********** End of file ***************************************
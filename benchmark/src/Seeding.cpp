@@ -0,0 +1,62 @@
+/***************************************************************
+ * Startup cost of many generators (one per particle): the 32-bit
+ * Initialize() against seed sequence batch initialization.
+ ***************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <sys/time.h> // gettimeofday()
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Seed_Sequence.hpp>
+
+#include "Benchmark.hpp"
+
+// **************************************************************
+static double Seconds()
+{
+    timeval now;
+    gettimeofday(&now, NULL);
+    return double(now.tv_sec) + 1.0e-6 * double(now.tv_usec);
+}
+
+// **************************************************************
+static void Print_Seeding(const std::string &name, const double seconds, const uint64_t nb_generators)
+{
+    const double per_generator = seconds / double(nb_generators);
+    std::cout << std::left  << std::setw(32) << name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(12) << seconds
+              << std::setprecision(3) << std::setw(16) << 1.0e6 * per_generator
+              << std::setprecision(2) << std::setw(16) << 1.0e7 * per_generator << "\n";
+}
+
+// **************************************************************
+void Benchmark_Seeding(const Benchmark_Options &options)
+{
+    const uint64_t nb_generators = options.nb_generators;
+    PRNG prng;
+    prng.Initialize(options.seed, true); // quiet = true
+    std::cout << prng.Get_Id_String() << ", " << nb_generators << " generators\n"
+              << std::left  << std::setw(32) << "initialization" << std::right
+              << std::setw(12) << "total (s)" << std::setw(16) << "per gen. (us)"
+              << std::setw(16) << "10^7 gen. (s)" << "\n";
+
+    {
+        std::vector<PRNG> prngs(nb_generators);
+        const double start = Seconds();
+        for (uint64_t i = 0 ; i < nb_generators ; i++)
+            prngs[i].Initialize(uint32_t(options.seed + i), true); // quiet = true
+        Print_Seeding("Initialize(uint32_t)", Seconds() - start, nb_generators);
+    }
+
+    {
+        std::vector<PRNG> prngs(nb_generators);
+        const double start = Seconds();
+        PRNG::Initialize_Array(&prngs[0], nb_generators, Seed_Sequence(options.seed));
+        Print_Seeding("Initialize_Array(Seed_Sequence)", Seconds() - start, nb_generators);
+    }
+}
+
+// ********** End of file ***************************************
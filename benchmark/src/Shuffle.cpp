@@ -0,0 +1,80 @@
+/***************************************************************
+ * Shuffling an index array: std::random_shuffle() with a functor
+ * around Get_Random() against prng::Shuffle() (Fisher-Yates up to
+ * one chunk, parallel MergeShuffle above).
+ ***************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <sys/time.h> // gettimeofday()
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Shuffle.hpp>
+
+#include "Benchmark.hpp"
+
+// **************************************************************
+static double Seconds()
+{
+    timeval now;
+    gettimeofday(&now, NULL);
+    return double(now.tv_sec) + 1.0e-6 * double(now.tv_usec);
+}
+
+// **************************************************************
+// The usual std::random_shuffle() generator: an index in [0, n[
+struct Get_Random_Index
+{
+    PRNG &prng;
+    explicit Get_Random_Index(PRNG &new_prng) : prng(new_prng) {}
+    std::ptrdiff_t operator()(const std::ptrdiff_t n)
+    {
+        return std::ptrdiff_t(prng.Get_Random_Close0_Open1() * double(n));
+    }
+};
+
+// **************************************************************
+static void Print_Shuffle(const std::string &name, const double seconds, const uint64_t n, const double reference)
+{
+    std::cout << std::left  << std::setw(32) << name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(12) << seconds
+              << std::setprecision(2) << std::setw(16) << 1.0e9 * seconds / double(n)
+              << std::setprecision(2) << std::setw(12) << reference / seconds << "\n";
+}
+
+// **************************************************************
+void Benchmark_Shuffle(const Benchmark_Options &options)
+{
+    const uint64_t n = options.nb_draws;
+    PRNG prng;
+    prng.Initialize(options.seed, true); // quiet = true
+    std::cout << prng.Get_Id_String() << ", " << n << " entries (uint64_t)\n"
+              << std::left  << std::setw(32) << "shuffle" << std::right
+              << std::setw(12) << "time (s)" << std::setw(16) << "ns/entry"
+              << std::setw(12) << "speedup" << "\n";
+
+    std::vector<uint64_t> array(n);
+    for (uint64_t i = 0 ; i < n ; i++)
+        array[i] = i;
+
+    double start = Seconds();
+    Get_Random_Index random_index(prng);
+    std::random_shuffle(array.begin(), array.end(), random_index);
+    const double reference = Seconds() - start;
+    Print_Shuffle("std::random_shuffle(Get_Random)", reference, n, reference);
+
+    for (int nb_threads = 1 ; nb_threads <= options.nb_ranks ; nb_threads *= 2)
+    {
+        start = Seconds();
+        prng::Shuffle(prng, &array[0], n, nb_threads);
+        std::ostringstream name;
+        name << "prng::Shuffle(), " << nb_threads << " thread" << (nb_threads > 1 ? "s" : "");
+        Print_Shuffle(name.str(), Seconds() - start, n, reference);
+    }
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,208 @@
+
+#include <iostream>
+#include <cstdlib> // posix_memalign()
+#include <cassert>
+#include <ctime> // nanosleep()
+#include <sched.h> // sched_yield()
+
+#include <StdCout.hpp>
+
+#include "Async_PRNG.hpp"
+
+// **************************************************************
+static void Wait_A_Bit(int &nb_waits)
+/**
+ * Back off while waiting on the other side of the ring: spin first,
+ * then yield the processor, then sleep.
+ */
+{
+    ++nb_waits;
+    if (nb_waits < 64)
+        return;
+    else if (nb_waits < 128)
+        sched_yield();
+    else
+    {
+        timespec delay;
+        delay.tv_sec  = 0;
+        delay.tv_nsec = 20000; // 20 us
+        nanosleep(&delay, NULL);
+    }
+}
+
+// **************************************************************
+Async_PRNG::Async_PRNG(const int new_nb_blocks, const uint64_t new_block_size)
+/**
+ * @param   new_nb_blocks   Number of blocks in the ring [default: 16]
+ * @param   new_block_size  Number of doubles per block [default: 4096]
+ */
+{
+    assert(new_nb_blocks >= 2);
+    assert(new_block_size >= 2);
+
+    seed                = 0;
+    nb_blocks           = new_nb_blocks;
+    block_size          = new_block_size;
+    nb_produced         = 0;
+    nb_consumed         = 0;
+    stop                = 0;
+    producer_running    = false;
+    current             = NULL;
+    current_end         = NULL;
+
+    // Blocks are cache line aligned, and 16 bytes aligned for dSFMT's SSE2 bulk generation.
+    void *buffer = NULL;
+    if (posix_memalign(&buffer, 64, uint64_t(nb_blocks) * block_size * sizeof(double)) != 0)
+    {
+        std_cout << "Async_PRNG: Couldn't allocate the ring buffer. Aborting.\n" << std::flush;
+        abort();
+    }
+    ring = (double *) buffer;
+}
+
+// **************************************************************
+Async_PRNG::~Async_PRNG()
+{
+    Stop();
+    free(ring);
+    ring = NULL;
+}
+
+// **************************************************************
+void Async_PRNG::Initialize_Taking_Time_As_Seed(const bool quiet)
+{
+    Stop();
+    prng.Initialize_Taking_Time_As_Seed(quiet);
+    seed = prng.Get_Seed();
+    Start();
+}
+
+// **************************************************************
+void Async_PRNG::Initialize(const uint32_t new_seed, const bool quiet)
+{
+    Stop();
+    prng.Initialize(new_seed, quiet);
+    seed = new_seed;
+    Start();
+}
+
+// **************************************************************
+void Async_PRNG::Start()
+/**
+ * Empty the ring and start the helper thread.
+ */
+{
+    nb_produced = 0;
+    nb_consumed = 0;
+    stop        = 0;
+    current     = NULL;
+    current_end = NULL;
+    __sync_synchronize();
+
+    if (pthread_create(&producer, NULL, Producer_Loop, this) != 0)
+    {
+        std_cout << "Async_PRNG: Couldn't start the producer thread. Aborting.\n" << std::flush;
+        abort();
+    }
+    producer_running = true;
+}
+
+// **************************************************************
+void Async_PRNG::Stop()
+/**
+ * Stop the helper thread and wait for it to finish. The numbers
+ * already produced are discarded; call Initialize() to start again.
+ */
+{
+    if (!producer_running)
+        return;
+
+    stop = 1;
+    __sync_synchronize();
+    pthread_join(producer, NULL);
+    producer_running = false;
+    current     = NULL;
+    current_end = NULL;
+}
+
+// **************************************************************
+void *Async_PRNG::Producer_Loop(void *async_prng)
+/**
+ * Helper thread: fill the next free block, then publish it. When the
+ * ring is full, wait for the consumer (back-pressure).
+ */
+{
+    Async_PRNG *self = (Async_PRNG *) async_prng;
+
+    while (!self->stop)
+    {
+        int nb_waits = 0;
+        while (!self->stop && self->nb_produced - self->nb_consumed == uint64_t(self->nb_blocks))
+            Wait_A_Bit(nb_waits);
+        if (self->stop)
+            break;
+        // Make sure the consumer is done with this block before overwriting it
+        __sync_synchronize();
+
+        double *block = &self->ring[(self->nb_produced % uint64_t(self->nb_blocks)) * self->block_size];
+        self->prng.Fill_Array_Close1_Open2(block, self->block_size);
+
+        // Make the block's content visible before publishing it
+        __sync_synchronize();
+        self->nb_produced = self->nb_produced + 1;
+    }
+
+    return NULL;
+}
+
+// **************************************************************
+void Async_PRNG::Next_Block()
+/**
+ * Release the current block (if any) and wait for the next one.
+ */
+{
+    assert(producer_running);
+
+    if (current_end != NULL)
+    {
+        // Done reading the current block before handing it back
+        __sync_synchronize();
+        nb_consumed = nb_consumed + 1;
+    }
+
+    int nb_waits = 0;
+    while (nb_produced == nb_consumed)
+        Wait_A_Bit(nb_waits);
+    // Read the block's content only after seeing it published
+    __sync_synchronize();
+
+    current     = &ring[(nb_consumed % uint64_t(nb_blocks)) * block_size];
+    current_end = current + block_size;
+}
+
+// **************************************************************
+double Async_PRNG::Get_Random_Close0_Close1()
+/**
+ * Return a pseudo-random number in the interval [0,1]
+ * (including 0, including 1), as PRNG::Get_Random_Close0_Close1().
+ */
+{
+    double r;
+    do {
+        r = 2.0*Get_Random_Close0_Open1();
+    } while (r > 1.0);
+    return r;
+}
+
+// **************************************************************
+uint64_t Async_PRNG::Get_Nb_Calls()
+/**
+ * Return the number of pseudo-random numbers consumed.
+ */
+{
+    if (current_end == NULL)
+        return 0;
+    return nb_consumed * block_size + uint64_t(block_size - uint64_t(current_end - current));
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,71 @@
+#ifndef INC_Async_PRNG_hpp
+#define INC_Async_PRNG_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <pthread.h>
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Pseudo-random number generator whose numbers are produced ahead of
+// time by a helper thread, so the consumer never pays for dSFMT's
+// block regeneration. The helper fills blocks of a single-producer
+// single-consumer ring; the consumer only bumps a pointer inside the
+// current block. The sequence is the one a PRNG initialized with the
+// same seed gives.
+class Async_PRNG
+{
+    PRNG prng; // Only used by the helper thread once started
+
+    uint32_t seed;
+    int nb_blocks;
+    uint64_t block_size;
+    double *ring;
+
+    // Blocks produced and consumed since initialization. Each is only
+    // written by one side; the ring is full when they differ by nb_blocks.
+    volatile uint64_t nb_produced;
+    volatile uint64_t nb_consumed;
+    volatile int stop;
+
+    pthread_t producer;
+    bool producer_running;
+
+    // Consumer's current block
+    const double *current;
+    const double *current_end;
+
+    void        Start();
+    void        Next_Block();
+    static void *Producer_Loop(void *async_prng);
+
+    // Owns its thread and ring: not copyable (not implemented)
+                Async_PRNG(const Async_PRNG &);
+    Async_PRNG &operator=(const Async_PRNG &);
+
+    public:
+                     Async_PRNG(const int new_nb_blocks = 16, const uint64_t new_block_size = 4096);
+                    ~Async_PRNG();
+        void        Initialize_Taking_Time_As_Seed(const bool quiet = false);
+        void        Initialize(const uint32_t seed, const bool quiet = false);
+        void        Stop();
+
+        inline double Get_Random_Close1_Open2()     // [1,2[
+        {
+            if (current == current_end)
+                Next_Block();
+            return *current++;
+        }
+        double      Get_Random()                    { return (2.0 - Get_Random_Close1_Open2());         } // ]0,1]
+        double      Get_Random_Close0_Open1()       { return Get_Random_Close1_Open2() - 1.0;           } // [0,1[
+        double      Get_Random_Open0_Close1()       { return (2.0 - Get_Random_Close1_Open2());         } // ]0,1]
+        double      Get_Random_CloseN1_Open1()      { return ((2.0 * Get_Random_Close1_Open2()) - 3.0); } // [-1,1[
+        double      Get_Random_Close0_Close1();     // [0,1]
+        double      Get_Random_CloseN1_Close1()     { return (2.0*Get_Random_Close0_Close1() - 1.0);    } // [-1,1]
+        uint32_t    Get_Seed()                      { return seed; }
+        uint64_t    Get_Nb_Calls();
+};
+
+#endif // INC_Async_PRNG_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,306 @@
+#include <cassert>
+#include <cmath>        // std::frexp(), std::ldexp(), std::floor()
+#include <cstring>      // memset(), memcpy()
+#include <algorithm>    // std::upper_bound(), std::max(), std::min()
+#include <limits>
+#include <vector>
+
+#include "Bernoulli.hpp"
+#include "Vector_Math.hpp"
+#include "SIMD_Ops.hpp"
+
+#ifdef PRNG_SIMD
+typedef Double_Vector Bernoulli_Vector;
+#else
+typedef double Bernoulli_Vector;
+#endif // #ifdef PRNG_SIMD
+
+// Words of the mask (64 trials each) compared side by side
+const int bernoulli_batch = 8;
+// Comparison steps done for all words of a batch before checking
+// whether they are decided (a word needs about log2(64) + 2, a batch
+// a few more)
+const int bernoulli_unchecked_steps = 7;
+// Random words drawn at a time: a multiple of the 13 words
+// PRNG::Fill_Array_Uint64() packs from 16 numbers, none are discarded
+const int bernoulli_buffer_size = 1040;
+
+// **************************************************************
+// Random 64-bit words (PRNG::Fill_Array_Uint64()) drawn in bulk
+class Random_Words
+{
+    PRNG       &prng;
+    uint64_t    words[bernoulli_buffer_size];
+    int         next;
+
+    // **************************************************************
+    void Refill()
+    {
+        prng.Fill_Array_Uint64(words, bernoulli_buffer_size);
+        next = 0;
+    }
+
+    public:
+        explicit Random_Words(PRNG &new_prng) : prng(new_prng), next(bernoulli_buffer_size) {}
+
+        // **************************************************************
+        inline uint64_t Next()
+        {
+            if (next == bernoulli_buffer_size)
+                Refill();
+            return words[next++];
+        }
+
+        // **************************************************************
+        inline const uint64_t *Next(const int count)
+        /**
+         * "count" consecutive words; the rest of the buffer is skipped
+         * if they don't fit in it.
+         */
+        {
+            if (next + count > bernoulli_buffer_size)
+                Refill();
+            next += count;
+            return &words[next - count];
+        }
+};
+
+// **************************************************************
+template <class V>
+static inline void Compare_Step(const typename Ops<V>::Integer x, const uint64_t p_bit,
+                                typename Ops<V>::Integer &undecided, typename Ops<V>::Integer &trials)
+/**
+ * Bit j of the U of the trials, in the words "x", compared with bit j
+ * of p (all 0 or all 1 in "p_bit"): the undecided trials where they
+ * differ are decided, set if p's bit is 1.
+ */
+{
+    typedef Ops<V> O;
+    const typename O::Integer bit = O::Set64(p_bit);
+    trials    = O::Or64(trials, O::And64(O::And_Not64(x, undecided), bit));
+    undecided = O::And_Not64(O::Xor64(x, bit), undecided);
+}
+
+// **************************************************************
+template <class V>
+static void Compare_Batch(Random_Words &random, const uint64_t *p_bits, const size_t nb_p_bits, uint64_t *trials)
+/**
+ * A batch of words of trials, in vectors of V's lanes: the first steps
+ * without checking, then the next ones while some trials of the batch
+ * are undecided. The random words used don't depend on the lanes, so
+ * the trials are the same with any instruction set.
+ */
+{
+    typedef Ops<V> O;
+    typedef typename O::Integer Integer;
+    const int nb_vectors = bernoulli_batch / O::lanes;
+    Integer undecided[nb_vectors], decided[nb_vectors];
+    for (int v = 0 ; v < nb_vectors ; v++)
+    {
+        undecided[v] = O::Set64(~uint64_t(0));
+        decided[v]   = O::Set64(0);
+    }
+
+    const uint64_t *u = random.Next(bernoulli_unchecked_steps * bernoulli_batch);
+    for (int j = 0 ; j < bernoulli_unchecked_steps ; j++)
+        for (int v = 0 ; v < nb_vectors ; v++)
+            Compare_Step<V>(O::Load64(&u[j * bernoulli_batch + v * O::lanes]), p_bits[j], undecided[v], decided[v]);
+    for (size_t j = bernoulli_unchecked_steps ; j < nb_p_bits ; j++)
+    {
+        Integer any = undecided[0];
+        for (int v = 1 ; v < nb_vectors ; v++)
+            any = O::Or64(any, undecided[v]);
+        if (O::Is_Zero64(any))
+            break;
+        const uint64_t *x = random.Next(bernoulli_batch);
+        for (int v = 0 ; v < nb_vectors ; v++)
+            Compare_Step<V>(O::Load64(&x[v * O::lanes]), p_bits[j], undecided[v], decided[v]);
+    }
+
+    for (int v = 0 ; v < nb_vectors ; v++)
+        O::Store64(&trials[v * O::lanes], decided[v]);
+}
+
+namespace prng
+{
+// **************************************************************
+void Fill_Bernoulli_Bits(PRNG &prng, uint64_t *mask, const uint64_t nbits, const double p)
+/**
+ * Fill the "nbits" first bits of "mask" with Bernoulli trials of
+ * probability "p" (trial i is set when a uniform U_i < p).
+ *
+ * With p = 0.5 the bits are PRNG::Fill_Array_Uint64()'s. Otherwise
+ * trials are compared 64 at a time (bit-sliced), most significant bit
+ * first: the j-th random word holds bit j of the 64 U_i of a word of
+ * the mask, compared with bit j of p. A trial is decided at its first
+ * bit differing from p's (set if p's bit is 1), so a word needs about
+ * log2(64) + 2 random words, whatever p. Trials still undecided after
+ * p's last 1 bit have U >= p. Words are compared by batches of 8, in
+ * SIMD vectors (SIMD_Ops.hpp): the first 7 steps without branches, then
+ * the next ones while the batch has undecided trials.
+ */
+{
+    const uint64_t nb_words = (nbits + 63) / 64;
+    if (nb_words == 0)
+        return;
+
+    if (!(p > 0.0))
+        memset(mask, 0, size_t(nb_words) * sizeof(uint64_t));
+    else if (!(p < 1.0))
+        memset(mask, 0xFF, size_t(nb_words) * sizeof(uint64_t));
+    else if (p >= 0.5 && p <= 0.5)
+        prng.Fill_Array_Uint64(mask, nb_words);
+    else
+    {
+        // Bits of p after the binary point, as masks of 64 bits:
+        // p = 0.(-exponent 0s)(the mantissa's bits but trailing zeros)
+        int exponent;
+        const double fraction = std::frexp(p, &exponent);   // p = fraction * 2^exponent, fraction in [0.5,1[
+        uint64_t mantissa = uint64_t(std::ldexp(fraction, 53));
+        int nb_mantissa_bits = 53;
+        while ((mantissa & 1) == 0)
+        {
+            mantissa >>= 1;
+            nb_mantissa_bits--;
+        }
+        std::vector<uint64_t> p_bits(size_t(-exponent), 0);
+        for (int k = nb_mantissa_bits - 1 ; k >= 0 ; k--)
+            p_bits.push_back(((mantissa >> k) & 1) ? ~uint64_t(0) : 0);
+        // Unchecked steps past the last bit compare with zeros: no change
+        const size_t nb_p_bits = p_bits.size();
+        if (nb_p_bits < size_t(bernoulli_unchecked_steps))
+            p_bits.resize(bernoulli_unchecked_steps, 0);
+
+        // Batches of words of the mask
+        Random_Words random(prng);
+        for (uint64_t w = 0 ; w < nb_words ; w += bernoulli_batch)
+        {
+            uint64_t trials[bernoulli_batch];
+            Compare_Batch<Bernoulli_Vector>(random, &p_bits[0], nb_p_bits, trials);
+
+            const uint64_t nb_groups = std::min(uint64_t(bernoulli_batch), nb_words - w);
+            memcpy(&mask[w], trials, size_t(nb_groups) * sizeof(uint64_t));
+        }
+    }
+
+    if (nbits % 64 != 0)
+        mask[nb_words - 1] &= (uint64_t(1) << (nbits % 64)) - 1;
+}
+
+// **************************************************************
+uint64_t Bernoulli_Hits(PRNG &prng, const uint64_t n, const double p, std::vector<uint64_t> &hits)
+{
+    return Bernoulli_Hits(prng, &n, &p, 1, hits);
+}
+
+// **************************************************************
+uint64_t Bernoulli_Hits(PRNG &prng, const uint64_t *ends, const double *p, const int nb_ranges,
+                        std::vector<uint64_t> &hits)
+{
+    hits.clear();
+    if (nb_ranges == 0 || ends[nb_ranges - 1] == 0)
+        return 0;
+
+    Sparse_Bernoulli trials(prng, ends, p, nb_ranges);
+    for (uint64_t i = trials.Next() ; i != Sparse_Bernoulli::end ; i = trials.Next())
+        hits.push_back(i);
+    return hits.size();
+}
+} // namespace prng
+
+const uint64_t Sparse_Bernoulli::end;
+
+// **************************************************************
+static double Failure_Rate(const double p)
+/**
+ * -log(1 - p), the exponential rate of failures of a trial of
+ * probability "p". A few terms of its series for a small p, where 1 - p
+ * would lose p's last digits.
+ */
+{
+    if (!(p > 0.0))
+        return 0.0;
+    if (!(p < 1.0))
+        return std::numeric_limits<double>::infinity();
+    if (p < 1.0e-4)
+        return p + p * p * (0.5 + p * (1.0 / 3.0 + p * 0.25));
+    return 0.0 - prng::Log(1.0 - p);
+}
+
+// **************************************************************
+Sparse_Bernoulli::Sparse_Bernoulli(PRNG &new_prng, const double p)
+    : prng(new_prng), position(0), range(0)
+{
+    Set_Ranges(&end, &p, 1);
+}
+
+// **************************************************************
+Sparse_Bernoulli::Sparse_Bernoulli(PRNG &new_prng, const uint64_t *new_ends, const double *p, const int nb_ranges)
+    : prng(new_prng), position(0), range(0)
+{
+    Set_Ranges(new_ends, p, nb_ranges);
+}
+
+// **************************************************************
+void Sparse_Bernoulli::Set_Ranges(const uint64_t *new_ends, const double *p, const int nb_ranges)
+{
+    assert(nb_ranges >= 0);
+    ends.assign(new_ends, new_ends + nb_ranges);
+    rates.resize(size_t(nb_ranges));
+    for (int r = 0 ; r < nb_ranges ; r++)
+    {
+        assert(new_ends[r] > (r == 0 ? 0 : new_ends[r - 1]));
+        rates[size_t(r)] = Failure_Rate(p[r]);
+    }
+}
+
+// **************************************************************
+uint64_t Sparse_Bernoulli::Next()
+/**
+ * The exponential number is spent over the remaining trials of each
+ * range in turn; the trials of a range where it runs out are failures
+ * up to the success. Ranges of p = 0 ahead are passed first: none is
+ * drawn when no range left can succeed.
+ */
+{
+    for ( ; range < ends.size() && !(rates[range] > 0.0) ; range++)
+        position = ends[range];
+    if (range == ends.size())
+        return end;
+
+    double remaining = 0.0 - prng::Log(prng.Get_Random());
+    for ( ; range < ends.size() ; range++)
+    {
+        const double rate = rates[range];
+        const double length = double(ends[range] - position);
+        if (rate > 0.0)
+        {
+            const double failures = std::floor(remaining / rate);
+            if (failures < length)
+            {
+                const uint64_t hit = position + uint64_t(failures);
+                position = hit + 1;
+                if (position == ends[range])
+                    range++;
+                return hit;
+            }
+            // Rounding must not make it negative
+            remaining = std::max(0.0, remaining - rate * length);
+        }
+        position = ends[range];
+    }
+    return end;
+}
+
+// **************************************************************
+void Sparse_Bernoulli::Seek(const uint64_t index)
+/**
+ * Trials are independent: the next success from "index" does not
+ * depend on the earlier ones.
+ */
+{
+    range    = size_t(std::upper_bound(ends.begin(), ends.end(), index) - ends.begin());
+    position = index;
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,67 @@
+#ifndef INC_Bernoulli_hpp
+#define INC_Bernoulli_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <vector>
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Bernoulli trials in bulk, without one uniform number per trial.
+namespace prng
+{
+    // Bit i of "mask" (mask[i/64] >> (i%64) & 1) is 1 with probability
+    // "p", for i < nbits; the unused bits of the last word are 0. Exact
+    // for any double p (the bits of p are compared with random bits,
+    // 64 trials at a time).
+    void Fill_Bernoulli_Bits(PRNG &prng, uint64_t *mask, const uint64_t nbits, const double p);
+
+    // Indices of the successes among trials [0, n[ of probability "p"
+    // (Sparse_Bernoulli), in increasing order, replacing the content of
+    // "hits". Returns their number.
+    uint64_t Bernoulli_Hits(PRNG &prng, const uint64_t n, const double p, std::vector<uint64_t> &hits);
+    // Same with probability p[r] for trials [ends[r-1], ends[r][ (ends[-1]
+    // being 0), n = ends[nb_ranges-1].
+    uint64_t Bernoulli_Hits(PRNG &prng, const uint64_t *ends, const double *p, const int nb_ranges,
+                            std::vector<uint64_t> &hits);
+}
+
+// **************************************************************
+// Successes of a sequence of rare Bernoulli trials, without drawing a
+// number per trial: the number of failures before the next success is
+// geometric, drawn with one log per success. Trials can have a
+// probability per range of indices (piecewise constant): an
+// exponential number E = -log(u) is spent over the ranges at a rate of
+// -log(1 - p) per trial, the success being the trial where it runs
+// out. Ranges of p = 0 are jumped over without any drawing.
+class Sparse_Bernoulli
+{
+    PRNG                   &prng;
+    std::vector<uint64_t>   ends;       // Range r is [ends[r-1], ends[r][
+    std::vector<double>     rates;      // -log(1 - p) of each range
+    uint64_t                position;   // Next trial not decided
+    size_t                  range;      // Range of "position"
+
+    void Set_Ranges(const uint64_t *new_ends, const double *p, const int nb_ranges);
+
+    public:
+        // Index returned by Next() once there are no more successes
+        static const uint64_t end = ~uint64_t(0);
+
+        // Infinite sequence of trials of probability "p"
+        Sparse_Bernoulli(PRNG &new_prng, const double p);
+        // Trials [0, ends[nb_ranges-1][, trial i with the probability p[r]
+        // of its range (ends[r-1] <= i < ends[r], ends strictly increasing)
+        Sparse_Bernoulli(PRNG &new_prng, const uint64_t *new_ends, const double *p, const int nb_ranges);
+
+        // Index of the next success, or "end" if there is none left
+        uint64_t Next();
+        // Continue from trial "index" (trials before it are not drawn)
+        void     Seek(const uint64_t index);
+
+        uint64_t Get_Position() const   { return position; }
+};
+
+#endif // INC_Bernoulli_hpp
+
+// ********** End of file ***************************************
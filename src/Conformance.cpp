@@ -0,0 +1,343 @@
+#include <cstdlib> // posix_memalign(), free()
+#include <cstring> // memcpy()
+#include <sstream>
+#include <iomanip>
+#include <algorithm> // std::min()
+
+#include <StdCout.hpp>
+
+#ifdef RAND_DSFMT
+#include "dSFMT/dSFMT.hpp"
+#endif // #ifdef RAND_DSFMT
+
+#include "Conformance.hpp"
+#include "PseudoRandomNumberGenerator.hpp"
+#include "Vector_Math.hpp"
+
+// Numbers compared at a time
+const uint64_t conformance_block = uint64_t(1) << 16;
+
+// First output of a method where the SIMD kernel and the scalar
+// reference disagree
+struct Divergence
+{
+    uint64_t nb_compared;
+    bool     found;
+    uint64_t index;
+    double   value;
+    double   expected;
+};
+
+// **************************************************************
+static void *Allocate(const size_t size)
+{
+    void *buffer = NULL;
+    if (posix_memalign(&buffer, 64, size) != 0)
+    {
+        std_cout << "prng::Check_Conformance(): Couldn't allocate " << size << " bytes. Aborting.\n" << std::flush;
+        abort();
+    }
+    return buffer;
+}
+
+// **************************************************************
+static uint64_t Bits(const double d)
+{
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    return u;
+}
+
+// **************************************************************
+static bool Compare(const double *values, const double *expected, const uint64_t n, Divergence &divergence)
+/**
+ * Compare the bits of "n" numbers, recording the first difference.
+ * Returns false once a divergence is found.
+ */
+{
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        if (Bits(values[i]) != Bits(expected[i]))
+        {
+            divergence.found    = true;
+            divergence.index    = divergence.nb_compared + i;
+            divergence.value    = values[i];
+            divergence.expected = expected[i];
+            divergence.nb_compared += i;
+            return false;
+        }
+    }
+    divergence.nb_compared += n;
+    return true;
+}
+
+// **************************************************************
+static void Report(const char *method, const char *isa, const Divergence &divergence, std::ostringstream &report)
+{
+    report << "    " << method << " (" << isa << " vs scalar reference): ";
+    if (divergence.found)
+    {
+        report << "first divergence at output " << divergence.index << ": "
+               << std::hex << std::setfill('0')
+               << "0x" << std::setw(16) << Bits(divergence.value) << " != 0x" << std::setw(16) << Bits(divergence.expected)
+               << std::dec << std::setfill(' ') << std::setprecision(17)
+               << " (" << divergence.value << " != " << divergence.expected << ")\n";
+    }
+    else
+    {
+        report << divergence.nb_compared << " outputs identical\n";
+    }
+}
+
+// **************************************************************
+static double Reference_Convert(const double r, const int interval)
+/**
+ * Scalar conversion of a number in [1,2[ to one of PRNG_Intervals.
+ */
+{
+    switch (interval)
+    {
+        case PRNG_Close0_Open1:
+            return r - 1.0;
+        case PRNG_Open0_Close1:
+            return 2.0 - r;
+        case PRNG_Open0_Open1:
+        {
+            double d;
+            const uint64_t u = Bits(r) | 1;
+            memcpy(&d, &u, sizeof(d));
+            return d - 1.0;
+        }
+        case PRNG_CloseN1_Open1:
+            return (2.0 * r) - 3.0;
+        default:
+            return r;
+    }
+}
+
+#ifdef RAND_DSFMT
+// **************************************************************
+static Divergence Check_dSFMT(const int interval, const uint64_t nb_outputs, const uint32_t seed)
+/**
+ * dSFMT's bulk generation (vectorized recursion and conversion)
+ * against the standard C recursion and a scalar conversion.
+ */
+{
+    dsfmt_t *dsfmt     = (dsfmt_t *) Allocate(sizeof(dsfmt_t));
+    dsfmt_t *reference = (dsfmt_t *) Allocate(sizeof(dsfmt_t));
+    dsfmt_chk_init_gen_rand(dsfmt, seed, DSFMT_MEXP);
+    memcpy(reference, dsfmt, sizeof(dsfmt_t));
+
+    // Whole reference blocks
+    const uint64_t block = (conformance_block / uint64_t(DSFMT_N64) + 1) * uint64_t(DSFMT_N64);
+    double *values   = (double *) Allocate(size_t(block) * sizeof(double));
+    double *expected = (double *) Allocate(size_t(block) * sizeof(double));
+
+    Divergence divergence = {0, false, 0, 0.0, 0.0};
+    while (divergence.nb_compared < nb_outputs)
+    {
+        switch (interval)
+        {
+            case PRNG_Close0_Open1:
+                dsfmt_fill_array_close_open(dsfmt, values, int(block));
+                break;
+            case PRNG_Open0_Close1:
+                dsfmt_fill_array_open_close(dsfmt, values, int(block));
+                break;
+            case PRNG_Open0_Open1:
+                dsfmt_fill_array_open_open(dsfmt, values, int(block));
+                break;
+            default:
+                dsfmt_fill_array_close1_open2(dsfmt, values, int(block));
+                break;
+        }
+        for (uint64_t i = 0 ; i < block ; i += uint64_t(DSFMT_N64))
+        {
+            dsfmt_gen_rand_all_reference(reference);
+            for (int j = 0 ; j < DSFMT_N64 ; j++)
+                expected[i + uint64_t(j)] = Reference_Convert(reference->status[j / 2].d[j % 2], interval);
+        }
+        const uint64_t n = std::min(block, nb_outputs - divergence.nb_compared);
+        if (!Compare(values, expected, n, divergence))
+            break;
+    }
+
+    free(expected);
+    free(values);
+    free(reference);
+    free(dsfmt);
+    return divergence;
+}
+#endif // #ifdef RAND_DSFMT
+
+// **************************************************************
+static Divergence Check_Fill_Array(const int interval, const uint64_t nb_outputs, const uint32_t seed)
+/**
+ * PRNG::Fill_Array()'s bulk transforms against a scalar conversion of
+ * numbers drawn one at a time.
+ */
+{
+    PRNG bulk, scalar;
+    bulk.Initialize(seed, true);    // quiet == true
+    scalar.Initialize(seed, true);  // quiet == true
+
+    double *values   = (double *) Allocate(size_t(conformance_block) * sizeof(double));
+    double *expected = (double *) Allocate(size_t(conformance_block) * sizeof(double));
+
+    Divergence divergence = {0, false, 0, 0.0, 0.0};
+    while (divergence.nb_compared < nb_outputs)
+    {
+        const uint64_t n = std::min(conformance_block, nb_outputs - divergence.nb_compared);
+        bulk.Fill_Array(values, n, interval);
+        for (uint64_t i = 0 ; i < n ; i++)
+            expected[i] = Reference_Convert(scalar.Get_Random_Close1_Open2(), interval);
+        if (!Compare(values, expected, n, divergence))
+            break;
+    }
+
+    free(expected);
+    free(values);
+    return divergence;
+}
+
+// Vector_Math.hpp kernels
+enum Conformance_Kernels
+{
+    KERNEL_LOG,
+    KERNEL_EXP,
+    KERNEL_SINCOS,
+    KERNEL_BOX_MULLER
+};
+
+// **************************************************************
+static Divergence Check_Kernel(const int kernel, const uint64_t nb_outputs, const uint32_t seed)
+/**
+ * A Vector_Math.hpp array function against its scalar reference, on
+ * pseudo-random arguments covering the ranges the distributions use.
+ * Sincos and Box-Muller have two outputs per argument, compared as
+ * (sine, cosine) and (z0, z1) pairs.
+ */
+{
+    PRNG prng;
+    prng.Initialize(seed, true); // quiet == true
+
+    const uint64_t half = conformance_block / 2;
+    double *x        = (double *) Allocate(size_t(conformance_block) * sizeof(double));
+    double *values   = (double *) Allocate(size_t(conformance_block) * sizeof(double));
+    double *expected = (double *) Allocate(size_t(conformance_block) * sizeof(double));
+    double *cosines  = (double *) Allocate(size_t(half) * sizeof(double));
+
+    Divergence divergence = {0, false, 0, 0.0, 0.0};
+    while (divergence.nb_compared < nb_outputs)
+    {
+        const uint64_t n = std::min(conformance_block, nb_outputs - divergence.nb_compared);
+        switch (kernel)
+        {
+            case KERNEL_LOG:
+                prng.Fill_Array(x, n, PRNG_Open0_Close1);
+                prng::Log_Array(x, values, n);
+                for (uint64_t i = 0 ; i < n ; i++)
+                    expected[i] = prng::Log(x[i]);
+                break;
+            case KERNEL_EXP:
+                prng.Fill_Array(x, n, PRNG_CloseN1_Open1);
+                for (uint64_t i = 0 ; i < n ; i++)
+                    x[i] *= 750.0;
+                prng::Exp_Array(x, values, n);
+                for (uint64_t i = 0 ; i < n ; i++)
+                    expected[i] = prng::Exp(x[i]);
+                break;
+            case KERNEL_SINCOS:
+                prng.Fill_Array(x, half, PRNG_CloseN1_Open1);
+                for (uint64_t i = 0 ; i < half ; i++)
+                    x[i] *= 1.0e5;
+                prng::Sincos_Array(x, &values[half], cosines, half);
+                for (uint64_t i = 0 ; i < half ; i++)
+                {
+                    values[2*i]     = values[half + i];
+                    values[2*i + 1] = cosines[i];
+                    prng::Sincos(x[i], expected[2*i], expected[2*i + 1]);
+                }
+                break;
+            default:
+                prng.Fill_Array(x, half, PRNG_Open0_Close1);
+                prng.Fill_Array(&x[half], half, PRNG_Close0_Open1);
+                prng::Box_Muller_Array(x, &x[half], 0.0, 1.0, values, half);
+                for (uint64_t i = 0 ; i < half ; i++)
+                    prng::Box_Muller(x[i], x[half + i], 0.0, 1.0, expected[2*i], expected[2*i + 1]);
+                break;
+        }
+        if (!Compare(values, expected, n, divergence))
+            break;
+    }
+
+    free(cosines);
+    free(expected);
+    free(values);
+    free(x);
+    return divergence;
+}
+
+namespace prng
+{
+// **************************************************************
+bool Strict_FP_Mode()
+{
+#ifdef PRNG_STRICT_FP
+    return true;
+#else
+    return false;
+#endif // #ifdef PRNG_STRICT_FP
+}
+
+// **************************************************************
+bool Check_Conformance(const uint64_t nb_outputs, std::string &report, const uint32_t seed)
+{
+    static const int intervals[5] = {PRNG_Close1_Open2, PRNG_Close0_Open1, PRNG_Open0_Close1,
+                                     PRNG_Open0_Open1, PRNG_CloseN1_Open1};
+    static const char *interval_names[5] = {"[1,2[", "[0,1[", "]0,1]", "]0,1[", "[-1,1["};
+#if defined(HAVE_SSE2)
+    const char *dsfmt_isa = "SSE2";
+#elif defined(HAVE_ALTIVEC)
+    const char *dsfmt_isa = "AltiVec";
+#else
+    const char *dsfmt_isa = "standard C";
+#endif
+
+    std::ostringstream output;
+    bool identical = true;
+    Divergence divergence;
+    std::string method;
+
+#ifdef RAND_DSFMT
+    for (int i = 0 ; i < 4 ; i++)
+    {
+        divergence = Check_dSFMT(intervals[i], nb_outputs, seed);
+        method = std::string("dSFMT ") + interval_names[i];
+        Report(method.c_str(), dsfmt_isa, divergence, output);
+        identical = identical && !divergence.found;
+    }
+#endif // #ifdef RAND_DSFMT
+
+    for (int i = 0 ; i < 5 ; i++)
+    {
+        divergence = Check_Fill_Array(intervals[i], nb_outputs, seed);
+        method = std::string("PRNG::Fill_Array() ") + interval_names[i];
+        Report(method.c_str(), dsfmt_isa, divergence, output);
+        identical = identical && !divergence.found;
+    }
+
+    static const char *kernel_names[4] = {"prng::Log_Array()", "prng::Exp_Array()", "prng::Sincos_Array()", "prng::Box_Muller_Array()"};
+    for (int kernel = KERNEL_LOG ; kernel <= KERNEL_BOX_MULLER ; kernel++)
+    {
+        divergence = Check_Kernel(kernel, nb_outputs, seed);
+        Report(kernel_names[kernel], Vector_Math_ISA(), divergence, output);
+        identical = identical && !divergence.found;
+    }
+
+    report = output.str();
+    return identical;
+}
+} // namespace prng
+
+// ********** End of file ***************************************
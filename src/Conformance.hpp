@@ -0,0 +1,31 @@
+#ifndef INC_Conformance_hpp
+#define INC_Conformance_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <string>
+
+// **************************************************************
+// Cross-ISA reproducibility. The library gives the same numbers on
+// every instruction set when:
+//   - the SIMD code paths give the same bits as the scalar ones (what
+//     Check_Conformance() verifies on the machine it runs on);
+//   - no transform depends on FMA contraction or on the system's libm,
+//     which is what the strict mode ("make strict": -ffp-contract=off
+//     and -DPRNG_STRICT_FP) pins down.
+namespace prng
+{
+    // Compiled with PRNG_STRICT_FP
+    bool        Strict_FP_Mode();
+
+    // Run each SIMD kernel (dSFMT's recursion and conversions, the
+    // bulk interval transforms, Vector_Math.hpp's kernels) side by side
+    // with its scalar reference on "nb_outputs" outputs per method and
+    // compare the bits. "report" gets one line per method: the number
+    // of identical outputs, or the first divergence. Returns true if
+    // no method diverged.
+    bool        Check_Conformance(const uint64_t nb_outputs, std::string &report, const uint32_t seed = 0);
+}
+
+#endif // INC_Conformance_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,293 @@
+#include <cassert>
+#include <cmath>     // std::sqrt()
+#include <algorithm> // std::min()
+#include <vector>
+
+#include <pthread.h>
+
+#include <StdCout.hpp>
+
+#include "Distributions.hpp"
+#include "Vector_Math.hpp"
+
+// Numbers converted at a time, so the generation, log and scaling
+// passes stay in cache
+const uint64_t distributions_chunk = 1024;
+
+// Particles per stream of Parallel_Fill_Maxwell_Boltzmann()
+const uint64_t maxwell_boltzmann_block = 65536;
+
+// **************************************************************
+static void Fill_Minus_Log(PRNG &prng, double *array, const uint64_t n)
+/**
+ * array[i] = -log(u) with u in ]0,1]. -log(1) is +0.
+ */
+{
+    prng.Fill_Array(array, n, PRNG_Open0_Close1);
+    prng::Log_Array(array, array, n);
+    for (uint64_t i = 0 ; i < n ; i++)
+        array[i] = 0.0 - array[i];
+}
+
+// **************************************************************
+static void Maxwell_Boltzmann(PRNG &prng, double *vx, double *vy, double *vz, const uint64_t n,
+                              const double kT, const double mass, const double *masses, const int *species)
+/**
+ * Velocities of "n" particles, by chunks: normal numbers for the
+ * chunk's vx, then vy, then vz, scaled by each particle's
+ * sqrt(kT/m). The mass is "mass" if "masses" is NULL.
+ */
+{
+    assert(kT >= 0.0);
+    for (uint64_t i = 0 ; i < n ; i += distributions_chunk)
+    {
+        const uint64_t size = std::min(distributions_chunk, n - i);
+        prng.Fill_Array_Normal(&vx[i], size);
+        prng.Fill_Array_Normal(&vy[i], size);
+        prng.Fill_Array_Normal(&vz[i], size);
+        for (uint64_t j = i ; j < i + size ; j++)
+        {
+            const double m = (masses == NULL ? mass : (species == NULL ? masses[j] : masses[species[j]]));
+            assert(m > 0.0);
+            const double sigma = std::sqrt(kT / m);
+            vx[j] *= sigma;
+            vy[j] *= sigma;
+            vz[j] *= sigma;
+        }
+    }
+}
+
+// Blocks of particles of Parallel_Fill_Maxwell_Boltzmann(), shared by
+// the threads: thread t does blocks t, t + nb_threads, ...
+struct Maxwell_Boltzmann_Blocks
+{
+    const Seed_Sequence *seeds;
+    uint64_t      first_stream;
+    double       *vx, *vy, *vz;
+    uint64_t      n;
+    double        kT;
+    double        mass;
+    const double *masses;
+    const int    *species;
+    uint64_t      nb_blocks;
+    int           nb_threads;
+};
+
+// One thread of Parallel_Fill_Maxwell_Boltzmann()
+struct Maxwell_Boltzmann_Thread
+{
+    const Maxwell_Boltzmann_Blocks *blocks;
+    int thread;
+};
+
+// **************************************************************
+static void *Maxwell_Boltzmann_Worker(void *maxwell_boltzmann_thread)
+{
+    const Maxwell_Boltzmann_Thread *worker = (const Maxwell_Boltzmann_Thread *) maxwell_boltzmann_thread;
+    const Maxwell_Boltzmann_Blocks &b = *worker->blocks;
+    for (uint64_t block = uint64_t(worker->thread) ; block < b.nb_blocks ; block += uint64_t(b.nb_threads))
+    {
+        PRNG prng;
+        prng.Initialize(*b.seeds, b.first_stream + block, true); // quiet = true
+        const uint64_t first = block * maxwell_boltzmann_block;
+        const uint64_t size  = std::min(maxwell_boltzmann_block, b.n - first);
+        Maxwell_Boltzmann(prng, &b.vx[first], &b.vy[first], &b.vz[first], size, b.kT, b.mass,
+                          b.masses, (b.species == NULL ? NULL : &b.species[first]));
+    }
+    return NULL;
+}
+
+// **************************************************************
+static uint64_t Parallel_Maxwell_Boltzmann(const Seed_Sequence &seeds, const uint64_t first_stream,
+                                           double *vx, double *vy, double *vz, const uint64_t n,
+                                           const double kT, const double mass, const double *masses,
+                                           const int *species, const int nb_threads)
+/**
+ * Blocks of Maxwell_Boltzmann() on "nb_threads" threads (see
+ * prng::Parallel_Fill_Maxwell_Boltzmann()).
+ */
+{
+    assert(nb_threads >= 1);
+    Maxwell_Boltzmann_Blocks blocks;
+    blocks.seeds        = &seeds;
+    blocks.first_stream = first_stream;
+    blocks.vx           = vx;
+    blocks.vy           = vy;
+    blocks.vz           = vz;
+    blocks.n            = n;
+    blocks.kT           = kT;
+    blocks.mass         = mass;
+    blocks.masses       = masses;
+    blocks.species      = species;
+    blocks.nb_blocks    = (n + maxwell_boltzmann_block - 1) / maxwell_boltzmann_block;
+    blocks.nb_threads   = int(std::min(uint64_t(nb_threads), std::max(blocks.nb_blocks, uint64_t(1))));
+
+    std::vector<Maxwell_Boltzmann_Thread> workers(blocks.nb_threads);
+    std::vector<pthread_t> threads(blocks.nb_threads);
+    for (int t = 0 ; t < blocks.nb_threads ; t++)
+    {
+        workers[t].blocks = &blocks;
+        workers[t].thread = t;
+    }
+    // The calling thread does the first thread's blocks
+    for (int t = 1 ; t < blocks.nb_threads ; t++)
+    {
+        if (pthread_create(&threads[t], NULL, Maxwell_Boltzmann_Worker, &workers[t]) != 0)
+        {
+            std_cout << "prng::Parallel_Fill_Maxwell_Boltzmann(): Couldn't start a thread. Aborting.\n" << std::flush;
+            abort();
+        }
+    }
+    Maxwell_Boltzmann_Worker(&workers[0]);
+    for (int t = 1 ; t < blocks.nb_threads ; t++)
+        pthread_join(threads[t], NULL);
+
+    return blocks.nb_blocks;
+}
+
+namespace prng
+{
+// **************************************************************
+void Fill_Exponential(PRNG &prng, double *array, const uint64_t n, const double rate)
+/**
+ * Fill "array" with "n" exponentially distributed numbers of mean
+ * 1/rate (rate > 0).
+ */
+{
+    assert(rate > 0.0);
+    for (uint64_t i = 0 ; i < n ; i += distributions_chunk)
+    {
+        const uint64_t size = std::min(distributions_chunk, n - i);
+        double *chunk = &array[i];
+        Fill_Minus_Log(prng, chunk, size);
+        for (uint64_t j = 0 ; j < size ; j++)
+            chunk[j] /= rate;
+    }
+}
+
+// **************************************************************
+void Fill_Exponential(PRNG &prng, double *array, const uint64_t n, const double *rates)
+/**
+ * Fill "array" with "n" exponentially distributed numbers, array[i]
+ * of mean 1/rates[i] (rates[i] > 0), e.g. free paths of particles in
+ * materials of cross sections "rates". "array" and "rates" can be the
+ * same.
+ */
+{
+    for (uint64_t i = 0 ; i < n ; i += distributions_chunk)
+    {
+        const uint64_t size = std::min(distributions_chunk, n - i);
+        double chunk[distributions_chunk];
+        Fill_Minus_Log(prng, chunk, size);
+        for (uint64_t j = 0 ; j < size ; j++)
+        {
+            assert(rates[i + j] > 0.0);
+            array[i + j] = chunk[j] / rates[i + j];
+        }
+    }
+}
+
+// **************************************************************
+uint64_t Poisson_Process(PRNG &prng, const double rate, const double begin, const double end,
+                         std::vector<double> &times)
+/**
+ * Replace "times" with the arrival times of a Poisson process of
+ * intensity "rate" (rate > 0) in [begin, end[: begin plus the
+ * cumulated sums of exponential gaps, while they are before "end".
+ * The gaps are drawn in bulk, by chunks: the generator advances by a
+ * multiple of the chunk size, not by the number of arrivals.
+ */
+{
+    assert(rate > 0.0);
+    times.clear();
+    if (!(end > begin))
+        return 0;
+
+    // Enough gaps for most windows in one chunk, without drawing far
+    // more than needed for short ones
+    const double expected = rate * (end - begin);
+    const uint64_t chunk_size = (expected < double(distributions_chunk) ?
+                                 std::min(uint64_t(expected) + 16, distributions_chunk) : distributions_chunk);
+    times.reserve(size_t(expected < 1.0e9 ? expected + 16.0 : 1.0e9));
+
+    double gaps[distributions_chunk];
+    double t = begin;
+    for (;;)
+    {
+        Fill_Exponential(prng, gaps, chunk_size, rate);
+        for (uint64_t i = 0 ; i < chunk_size ; i++)
+        {
+            t += gaps[i];
+            if (!(t < end))
+                return uint64_t(times.size());
+            times.push_back(t);
+        }
+    }
+}
+
+// **************************************************************
+void Fill_Maxwell_Boltzmann(PRNG &prng, double *vx, double *vy, double *vz, const uint64_t n,
+                            const double kT, const double mass)
+/**
+ * Fill the velocity components "vx", "vy" and "vz" of "n" particles of
+ * mass "mass" (> 0) with a Maxwell-Boltzmann distribution at
+ * temperature "kT" (kT/m in the velocities' units squared). The
+ * normal numbers come from PRNG::Fill_Array_Normal(), so no state is
+ * shared with other generators (unlike gasdev()).
+ */
+{
+    Maxwell_Boltzmann(prng, vx, vy, vz, n, kT, mass, NULL, NULL);
+}
+
+// **************************************************************
+void Fill_Maxwell_Boltzmann(PRNG &prng, double *vx, double *vy, double *vz, const uint64_t n,
+                            const double kT, const double *masses, const int *species)
+/**
+ * Same, particle i having mass masses[i], or masses[species[i]] if
+ * "species" is given (one mass per species).
+ */
+{
+    if (masses == NULL)
+    {
+        std_cout << "prng::Fill_Maxwell_Boltzmann(): No masses given. Aborting.\n" << std::flush;
+        abort();
+    }
+    Maxwell_Boltzmann(prng, vx, vy, vz, n, kT, 0.0, masses, species);
+}
+
+// **************************************************************
+uint64_t Parallel_Fill_Maxwell_Boltzmann(const Seed_Sequence &seeds, const uint64_t first_stream,
+                                         double *vx, double *vy, double *vz, const uint64_t n,
+                                         const double kT, const double mass, const int nb_threads)
+/**
+ * Fill_Maxwell_Boltzmann() with a single mass on "nb_threads" threads
+ * (including the calling one). Particles are split in blocks of 65536,
+ * block b drawn from its own PRNG initialized with stream
+ * first_stream + b of "seeds": the result only depends on the seeds
+ * and "first_stream". The streams used are first_stream to
+ * first_stream + (returned value) - 1; a next call should start after
+ * them.
+ */
+{
+    return Parallel_Maxwell_Boltzmann(seeds, first_stream, vx, vy, vz, n, kT, mass, NULL, NULL, nb_threads);
+}
+
+// **************************************************************
+uint64_t Parallel_Fill_Maxwell_Boltzmann(const Seed_Sequence &seeds, const uint64_t first_stream,
+                                         double *vx, double *vy, double *vz, const uint64_t n,
+                                         const double kT, const double *masses, const int *species,
+                                         const int nb_threads)
+/**
+ * Same, with per-particle or per-species masses.
+ */
+{
+    if (masses == NULL)
+    {
+        std_cout << "prng::Parallel_Fill_Maxwell_Boltzmann(): No masses given. Aborting.\n" << std::flush;
+        abort();
+    }
+    return Parallel_Maxwell_Boltzmann(seeds, first_stream, vx, vy, vz, n, kT, 0.0, masses, species, nb_threads);
+}
+} // namespace prng
+
+// ********** End of file ***************************************
@@ -0,0 +1,48 @@
+#ifndef INC_Distributions_hpp
+#define INC_Distributions_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <vector>
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Bulk non-uniform distributions, built on PRNG's bulk generation and
+// Vector_Math.hpp's kernels (so the numbers are the same on every ISA
+// and with any libm). All functions fill caller provided arrays.
+namespace prng
+{
+    // Exponential numbers, -log(u)/rate with u in ]0,1] (never
+    // log(0)): free paths, waiting times. With "rates", element i has
+    // rate rates[i]; both give the same numbers for the same rates.
+    void Fill_Exponential(PRNG &prng, double *array, const uint64_t n, const double rate);
+    void Fill_Exponential(PRNG &prng, double *array, const uint64_t n, const double *rates);
+
+    // Arrival times of a Poisson process of intensity "rate" in
+    // [begin, end[, in increasing order. Returns their number.
+    uint64_t Poisson_Process(PRNG &prng, const double rate, const double begin, const double end,
+                             std::vector<double> &times);
+
+    // Maxwell-Boltzmann velocities at temperature kT (in energy units):
+    // each component of particle i is normal of variance kT/m_i, with
+    // m_i = mass, masses[i] or (with "species") masses[species[i]]
+    // ("masses" can't be NULL).
+    void Fill_Maxwell_Boltzmann(PRNG &prng, double *vx, double *vy, double *vz, const uint64_t n,
+                                const double kT, const double mass);
+    void Fill_Maxwell_Boltzmann(PRNG &prng, double *vx, double *vy, double *vz, const uint64_t n,
+                                const double kT, const double *masses, const int *species = NULL);
+    // Same, on "nb_threads" threads: block b of particles uses stream
+    // first_stream + b of "seeds", so the velocities don't depend on
+    // the number of threads. Returns the number of streams used.
+    uint64_t Parallel_Fill_Maxwell_Boltzmann(const Seed_Sequence &seeds, const uint64_t first_stream,
+                                             double *vx, double *vy, double *vz, const uint64_t n,
+                                             const double kT, const double mass, const int nb_threads);
+    uint64_t Parallel_Fill_Maxwell_Boltzmann(const Seed_Sequence &seeds, const uint64_t first_stream,
+                                             double *vx, double *vy, double *vz, const uint64_t n,
+                                             const double kT, const double *masses, const int *species,
+                                             const int nb_threads);
+}
+
+#endif // INC_Distributions_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,268 @@
+
+#include <cassert>
+#include <algorithm> // std::swap()
+
+#ifdef HAVE_SSE2
+#include <emmintrin.h>
+#endif // #ifdef HAVE_SSE2
+
+#include "Feistel_Permutation.hpp"
+#include "Random_Integers.hpp"
+
+// **************************************************************
+static inline uint32_t Mask(const int nb_bits)
+{
+    return uint32_t((uint64_t(1) << nb_bits) - 1);
+}
+
+// **************************************************************
+static inline uint32_t Round_Function(const uint32_t half, const uint32_t key)
+/**
+ * 32-bit hash of a half keyed by the round's key (the "lowbias32"
+ * integer hash of C. Wellons, which only needs 32-bit operations).
+ */
+{
+    uint32_t h = half ^ key;
+    h ^= h >> 16;
+    h *= 0x7feb352dU;
+    h ^= h >> 15;
+    h *= 0x846ca68bU;
+    h ^= h >> 16;
+    return h;
+}
+
+// **************************************************************
+static uint64_t Feistel(const uint64_t x, const uint32_t *keys, const int high_bits, const int low_bits, const bool inverse)
+/**
+ * One pass of the Feistel network over [0, 2^(high_bits+low_bits)[.
+ * A round moves the low half up and xors the hashed low half into the
+ * high one, which becomes the new low half: the widths of the halves
+ * swap at each round and are back after an even number of rounds.
+ */
+{
+    uint32_t high = uint32_t(x >> low_bits);
+    uint32_t low  = uint32_t(x) & Mask(low_bits);
+    int high_width = high_bits;
+    int low_width  = low_bits;
+    for (int r = 0 ; r < Feistel_Permutation::nb_rounds ; r++)
+    {
+        if (!inverse)
+        {
+            const uint32_t new_low = high ^ (Round_Function(low, keys[r]) & Mask(high_width));
+            high = low;
+            low  = new_low;
+        }
+        else
+        {
+            const uint32_t new_high = low ^ (Round_Function(high, keys[Feistel_Permutation::nb_rounds - 1 - r]) & Mask(low_width));
+            low  = high;
+            high = new_high;
+        }
+        std::swap(high_width, low_width);
+    }
+    return (uint64_t(high) << low_width) | uint64_t(low);
+}
+
+#ifdef HAVE_SSE2
+// **************************************************************
+static inline __m128i Multiply_Low_32(const __m128i a, const __m128i b)
+{
+    // SSE2 only multiplies the even lanes (32x32 -> 64 bits)
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// **************************************************************
+static inline __m128i Round_Function(const __m128i half, const __m128i key)
+{
+    __m128i h = _mm_xor_si128(half, key);
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+    h = Multiply_Low_32(h, _mm_set1_epi32(int(0x7feb352dU)));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+    h = Multiply_Low_32(h, _mm_set1_epi32(int(0x846ca68bU)));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+    return h;
+}
+#endif // #ifdef HAVE_SSE2
+
+// **************************************************************
+Feistel_Permutation::Feistel_Permutation(const uint64_t n, PRNG &prng)
+/**
+ * @param   n       Number of indices to permute (at least 1)
+ * @param   prng    Generator giving the round keys
+ */
+{
+    assert(n >= 1);
+    size = n;
+    int nb_bits = 0;
+    while (nb_bits < 64 && (uint64_t(1) << nb_bits) < n)
+        nb_bits++;
+    low_bits  = nb_bits / 2;
+    high_bits = nb_bits - low_bits;
+
+    Random_Integers integers(prng);
+    for (int r = 0 ; r < nb_rounds ; r++)
+        keys[r] = integers.Next_Uint32();
+}
+
+// **************************************************************
+uint64_t Feistel_Permutation::Permute(const uint64_t index) const
+/**
+ * Return the image of "index": visiting Permute(0), Permute(1), ...
+ * visits all of [0, n[ in random order.
+ *
+ * @param   index   Index in [0, n[
+ */
+{
+    assert(index < size);
+    uint64_t x = index;
+    do
+    {
+        x = Feistel(x, keys, high_bits, low_bits, false);
+    } while (x >= size);
+    return x;
+}
+
+// **************************************************************
+uint64_t Feistel_Permutation::Inverse(const uint64_t position) const
+/**
+ * Return the index whose image is "position": Inverse(Permute(i)) == i,
+ * so the position of index "position" in the visiting order.
+ *
+ * @param   position    Position in [0, n[
+ */
+{
+    assert(position < size);
+    uint64_t x = position;
+    do
+    {
+        x = Feistel(x, keys, high_bits, low_bits, true);
+    } while (x >= size);
+    return x;
+}
+
+// **************************************************************
+void Feistel_Permutation::Batch(const uint64_t *indices, uint64_t *permuted, const uint64_t n, const bool inverse) const
+/**
+ * Cycle-walk blocks of indices with four lanes per SSE2 operation.
+ * Each pass applies the network to all the block's pending indices
+ * (without branches, so consecutive groups overlap in the pipeline),
+ * then keeps the ones outside [0, n[ for the next pass.
+ */
+{
+    uint64_t k = 0;
+#ifdef HAVE_SSE2
+    __m128i round_keys[nb_rounds];
+    __m128i masks[2]; // Width of the half xored into, at even and odd rounds
+    for (int r = 0 ; r < nb_rounds ; r++)
+        round_keys[r] = _mm_set1_epi32(int(keys[inverse ? nb_rounds - 1 - r : r]));
+    masks[0] = _mm_set1_epi32(int(Mask(inverse ? low_bits  : high_bits)));
+    masks[1] = _mm_set1_epi32(int(Mask(inverse ? high_bits : low_bits)));
+
+    const int block_size = 256; // Multiple of 8
+    uint32_t highs[block_size]     = {0};
+    uint32_t lows[block_size]      = {0};
+    uint32_t positions[block_size] = {0};
+    for ( ; k < n ; k += block_size)
+    {
+        const int block_n = int(std::min(n - k, uint64_t(block_size)));
+        for (int l = 0 ; l < block_n ; l++)
+        {
+            assert(indices[k + l] < size);
+            highs[l]     = uint32_t(indices[k + l] >> low_bits);
+            lows[l]      = uint32_t(indices[k + l]) & Mask(low_bits);
+            positions[l] = uint32_t(l);
+        }
+
+        int nb_pending = block_n;
+        while (nb_pending > 0)
+        {
+            // Two groups of four at a time, to hide the multiplications' latency
+            for (int l = 0 ; l < nb_pending ; l += 8)
+            {
+                __m128i high[2], low[2];
+                for (int g = 0 ; g < 2 ; g++)
+                {
+                    high[g] = _mm_loadu_si128((const __m128i *) &highs[l + 4*g]);
+                    low[g]  = _mm_loadu_si128((const __m128i *) &lows[l + 4*g]);
+                }
+                for (int r = 0 ; r < nb_rounds ; r++)
+                {
+                    for (int g = 0 ; g < 2 ; g++)
+                    {
+                        if (!inverse)
+                        {
+                            const __m128i new_low = _mm_xor_si128(high[g], _mm_and_si128(Round_Function(low[g], round_keys[r]), masks[r % 2]));
+                            high[g] = low[g];
+                            low[g]  = new_low;
+                        }
+                        else
+                        {
+                            const __m128i new_high = _mm_xor_si128(low[g], _mm_and_si128(Round_Function(high[g], round_keys[r]), masks[r % 2]));
+                            low[g]  = high[g];
+                            high[g] = new_high;
+                        }
+                    }
+                }
+                for (int g = 0 ; g < 2 ; g++)
+                {
+                    _mm_storeu_si128((__m128i *) &highs[l + 4*g], high[g]);
+                    _mm_storeu_si128((__m128i *) &lows[l + 4*g], low[g]);
+                }
+            }
+
+            // Keep walking the ones outside [0, n[
+            int nb_left = 0;
+            for (int l = 0 ; l < nb_pending ; l++)
+            {
+                const uint64_t x = (uint64_t(highs[l]) << low_bits) | uint64_t(lows[l]);
+                if (x < size)
+                    permuted[k + positions[l]] = x;
+                else
+                {
+                    highs[nb_left]     = highs[l];
+                    lows[nb_left]      = lows[l];
+                    positions[nb_left] = positions[l];
+                    nb_left++;
+                }
+            }
+            nb_pending = nb_left;
+        }
+    }
+#endif // #ifdef HAVE_SSE2
+    for ( ; k < n ; k++)
+        permuted[k] = (inverse ? Inverse(indices[k]) : Permute(indices[k]));
+}
+
+// **************************************************************
+void Feistel_Permutation::Permute_Array(const uint64_t *indices, uint64_t *permuted, const uint64_t n) const
+{
+    Batch(indices, permuted, n, false);
+}
+
+// **************************************************************
+void Feistel_Permutation::Inverse_Array(const uint64_t *positions, uint64_t *indices, const uint64_t n) const
+{
+    Batch(positions, indices, n, true);
+}
+
+// **************************************************************
+void Feistel_Permutation::Permute_Range(const uint64_t first, const uint64_t n, uint64_t *permuted) const
+/**
+ * Fill "permuted" with the images of "first" to first+n-1: workers
+ * can each take a range of a global visiting order.
+ *
+ * @param   first       First index
+ * @param   n           Number of indices (first+n <= Get_Size())
+ * @param   permuted    Array of "n" positions
+ */
+{
+    assert(first + n <= size);
+    for (uint64_t k = 0 ; k < n ; k++)
+        permuted[k] = first + k;
+    Batch(permuted, permuted, n, false);
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,47 @@
+#ifndef INC_Feistel_Permutation_hpp
+#define INC_Feistel_Permutation_hpp
+
+#include <stdint.h> // (u)int64_t
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Keyed pseudo-random permutation of [0, n[ in O(1) memory, to visit
+// huge index spaces in random order without storing them: a Feistel
+// network over the smallest power of two >= n (unbalanced halves of
+// at most 32 bits, so the domain is less than 2n) with cycle-walking,
+// which applies the network again until the index falls in [0, n[.
+// Workers can split the visiting order by ranges of positions
+// (Permute_Range()). The batch functions process four indices at a
+// time with SSE2 (HAVE_SSE2) and give exactly Permute()/Inverse()'s
+// results.
+class Feistel_Permutation
+{
+    public:
+        static const int nb_rounds = 6;
+
+    private:
+        uint64_t    size;
+        int         high_bits;
+        int         low_bits;
+        uint32_t    keys[nb_rounds];
+
+        void        Batch(const uint64_t *indices, uint64_t *permuted, const uint64_t n, const bool inverse) const;
+
+    public:
+                    Feistel_Permutation(const uint64_t n, PRNG &prng);
+        uint64_t    Get_Size() const    { return size; }
+
+        uint64_t    Permute(const uint64_t index) const;
+        uint64_t    Inverse(const uint64_t position) const;
+
+        // permuted[k] = Permute(indices[k]) (or Inverse()); the arrays can be the same
+        void        Permute_Array(const uint64_t *indices, uint64_t *permuted, const uint64_t n) const;
+        void        Inverse_Array(const uint64_t *positions, uint64_t *indices, const uint64_t n) const;
+        // permuted[k] = Permute(first + k)
+        void        Permute_Range(const uint64_t first, const uint64_t n, uint64_t *permuted) const;
+};
+
+#endif // INC_Feistel_Permutation_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,151 @@
+#include <cstring> // memcpy()
+#include <cassert>
+
+#include "SIMD_Ops.hpp"
+#include "Generator_Array.hpp"
+
+// **************************************************************
+template <class V>
+static inline V Step(V &s0, V &s1, V &s2, V &s3)
+/**
+ * One xoshiro128++ step (D. Blackman and S. Vigna) of "V::lanes"
+ * entities, returning their output.
+ */
+{
+    typedef Ops<V> O;
+    const V result = O::Add(O::Rotate_Left(O::Add(s0, s3), 7), s0);
+    const V t = O::Shift_Left(s1, 9);
+    s2 = O::Xor(s2, s0);
+    s3 = O::Xor(s3, s1);
+    s1 = O::Xor(s1, s2);
+    s0 = O::Xor(s0, s3);
+    s2 = O::Xor(s2, t);
+    s3 = O::Rotate_Left(s3, 11);
+    return result;
+}
+
+// **************************************************************
+template <class V>
+static inline void Step_Uint32_Kernel(uint32_t **s, const uint64_t i, uint32_t *out)
+{
+    typedef Ops<V> O;
+    V s0 = O::Load(&s[0][i]), s1 = O::Load(&s[1][i]), s2 = O::Load(&s[2][i]), s3 = O::Load(&s[3][i]);
+    O::Store(&out[i], Step(s0, s1, s2, s3));
+    O::Store(&s[0][i], s0); O::Store(&s[1][i], s1); O::Store(&s[2][i], s2); O::Store(&s[3][i], s3);
+}
+
+// **************************************************************
+template <class V>
+static inline void Step_Close0_Open1_Kernel(uint32_t **s, const uint64_t i, double *out)
+{
+    typedef Ops<V> O;
+    V s0 = O::Load(&s[0][i]), s1 = O::Load(&s[1][i]), s2 = O::Load(&s[2][i]), s3 = O::Load(&s[3][i]);
+    const V high = Step(s0, s1, s2, s3);
+    const V low  = Step(s0, s1, s2, s3);
+    O::Store_Close0_Open1(&out[i], high, low);
+    O::Store(&s[0][i], s0); O::Store(&s[1][i], s1); O::Store(&s[2][i], s2); O::Store(&s[3][i], s3);
+}
+
+// **************************************************************
+Generator_Array::Generator_Array(const uint64_t n, const Seed_Sequence &seeds, const uint64_t first_id)
+/**
+ * "n" generators, slot i holding entity first_id + i.
+ */
+{
+    Resize(n);
+    for (uint64_t i = 0 ; i < n ; i++)
+        Seed(i, seeds, first_id + i);
+}
+
+// **************************************************************
+void Generator_Array::Resize(const uint64_t n)
+{
+    for (int w = 0 ; w < state_size ; w++)
+        s[w].resize(size_t(n));
+}
+
+// **************************************************************
+void Generator_Array::Seed(const uint64_t i, const Seed_Sequence &seeds, const uint64_t id)
+{
+    assert(i < Get_Size());
+    uint32_t state[state_size];
+    seeds.Generate(state, state_size, id);
+    // The all zero state is the only one xoshiro can't leave
+    if ((state[0] | state[1] | state[2] | state[3]) == 0)
+        state[0] = 1;
+    Set_State(i, state);
+}
+
+// **************************************************************
+void Generator_Array::Get_State(const uint64_t i, uint32_t state[state_size]) const
+{
+    assert(i < Get_Size());
+    for (int w = 0 ; w < state_size ; w++)
+        state[w] = s[w][i];
+}
+
+// **************************************************************
+void Generator_Array::Set_State(const uint64_t i, const uint32_t state[state_size])
+{
+    assert(i < Get_Size());
+    for (int w = 0 ; w < state_size ; w++)
+        s[w][i] = state[w];
+}
+
+// **************************************************************
+uint32_t Generator_Array::Next_Uint32(const uint64_t i)
+{
+    assert(i < Get_Size());
+    return Step<uint32_t>(s[0][i], s[1][i], s[2][i], s[3][i]);
+}
+
+// **************************************************************
+double Generator_Array::Next_Close0_Open1(const uint64_t i)
+/**
+ * Number of [0,1[ (52 random bits) from the entity's next two outputs,
+ * the first one giving the most significant bits.
+ */
+{
+    const uint32_t high = Next_Uint32(i);
+    const uint32_t low  = Next_Uint32(i);
+    double d;
+    Ops<uint32_t>::Store_Close0_Open1(&d, high, low);
+    return d;
+}
+
+// **************************************************************
+void Generator_Array::Step_Uint32(uint32_t *out)
+{
+    const uint64_t n = Get_Size();
+    if (n == 0)
+        return;
+    uint32_t *states[state_size] = {&s[0][0], &s[1][0], &s[2][0], &s[3][0]};
+    uint64_t i = 0;
+#ifdef PRNG_SIMD
+    for ( ; i + Ops<Word_Vector>::lanes <= n ; i += Ops<Word_Vector>::lanes)
+        Step_Uint32_Kernel<Word_Vector>(states, i, out);
+#endif // #ifdef PRNG_SIMD
+    for ( ; i < n ; i++)
+        Step_Uint32_Kernel<uint32_t>(states, i, out);
+}
+
+// **************************************************************
+void Generator_Array::Step_Close0_Open1(double *out)
+/**
+ * out[i] = Next_Close0_Open1(i) for all entities.
+ */
+{
+    const uint64_t n = Get_Size();
+    if (n == 0)
+        return;
+    uint32_t *states[state_size] = {&s[0][0], &s[1][0], &s[2][0], &s[3][0]};
+    uint64_t i = 0;
+#ifdef PRNG_SIMD
+    for ( ; i + Ops<Word_Vector>::lanes <= n ; i += Ops<Word_Vector>::lanes)
+        Step_Close0_Open1_Kernel<Word_Vector>(states, i, out);
+#endif // #ifdef PRNG_SIMD
+    for ( ; i < n ; i++)
+        Step_Close0_Open1_Kernel<uint32_t>(states, i, out);
+}
+
+// ********** End of file ***************************************
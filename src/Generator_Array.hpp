@@ -0,0 +1,51 @@
+#ifndef INC_Generator_Array_hpp
+#define INC_Generator_Array_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <vector>
+
+#include "Seed_Sequence.hpp"
+
+// **************************************************************
+// One small generator per entity (particle, cell, ...) where a PRNG
+// per entity (a few KB of dSFMT state) would not fit in memory: each
+// entity has a xoshiro128++ state (16 bytes, period 2^128 - 1), stored
+// structure-of-arrays so Step_*() advances all of them together with
+// SSE2 (HAVE_SSE2, 4 entities per instruction), AVX2 (8) or AVX-512
+// (16). The results are the same whatever the instruction set.
+// Entity "id"'s state comes from the seed sequence's stream "id", so
+// an entity's numbers only depend on the seed and its id: the state
+// can follow the entity (Get_State()/Set_State()) when it moves to
+// another process, whatever slot it gets there.
+class Generator_Array
+{
+    public:
+        static const int state_size = 4; // 32-bit words
+
+    private:
+        // s[w][i]: word w of entity i's state
+        std::vector<uint32_t> s[state_size];
+
+    public:
+                    Generator_Array(const uint64_t n, const Seed_Sequence &seeds, const uint64_t first_id = 0);
+        uint64_t    Get_Size() const    { return uint64_t(s[0].size()); }
+        // New slots are seeded with Seed() or Set_State()
+        void        Resize(const uint64_t n);
+
+        // Slot "i" gets entity "id"'s initial state
+        void        Seed(const uint64_t i, const Seed_Sequence &seeds, const uint64_t id);
+        void        Get_State(const uint64_t i, uint32_t state[state_size]) const;
+        void        Set_State(const uint64_t i, const uint32_t state[state_size]);
+
+        // Entity "i" alone
+        uint32_t    Next_Uint32(const uint64_t i);
+        double      Next_Close0_Open1(const uint64_t i);  // Two steps
+
+        // All entities: out[i] is entity i's next number
+        void        Step_Uint32(uint32_t *out);
+        void        Step_Close0_Open1(double *out);       // Two steps
+};
+
+#endif // INC_Generator_Array_hpp
+
+// ********** End of file ***************************************
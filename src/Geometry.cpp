@@ -0,0 +1,463 @@
+#include <cassert>
+#include <cmath>     // std::sqrt()
+#include <algorithm> // std::min()
+
+#include <StdCout.hpp>
+
+#include "Geometry.hpp"
+#include "Vector_Math.hpp"
+
+// Elements generated at a time, so the passes over them stay in cache
+const uint64_t geometry_chunk = 512;
+
+const double two_pi = 6.283185307179586476925286766559;
+
+// Unit quaternions of a chunk, structure of arrays
+struct Quaternion_Chunk
+{
+    double w[geometry_chunk];
+    double x[geometry_chunk];
+    double y[geometry_chunk];
+    double z[geometry_chunk];
+};
+
+// **************************************************************
+static void Store_Chunk(double *array, const uint64_t n, const uint64_t first, const uint64_t size,
+                        const int nb_components, const double *const *components, const int layout)
+/**
+ * Write elements first to first + size - 1 of an array of "n"
+ * elements of "nb_components" components in "layout" (one of
+ * PRNG_Layouts), from the chunk's arrays of components.
+ */
+{
+    if (layout == PRNG_SoA)
+    {
+        for (int c = 0 ; c < nb_components ; c++)
+        {
+            double *to = &array[uint64_t(c) * n + first];
+            for (uint64_t j = 0 ; j < size ; j++)
+                to[j] = components[c][j];
+        }
+    }
+    else
+    {
+        const uint64_t k = uint64_t(nb_components);
+        double *to = &array[k * first];
+        for (uint64_t j = 0 ; j < size ; j++)
+            for (uint64_t c = 0 ; c < k ; c++)
+                to[k*j + c] = components[c][j];
+    }
+}
+
+// **************************************************************
+static void Random_Quaternions(PRNG &prng, Quaternion_Chunk &q, const uint64_t n)
+/**
+ * Shoemake's uniform unit quaternions ("Uniform random rotations",
+ * Graphics Gems III, 1992) from u1, u2, u3 in [0,1[:
+ *      (w, x, y, z) = (sqrt(u1) cos(2 pi u3), sqrt(1-u1) sin(2 pi u2),
+ *                      sqrt(1-u1) cos(2 pi u2), sqrt(u1) sin(2 pi u3))
+ * The chunk's u1 are drawn first, then its u2, then its u3.
+ */
+{
+    assert(n <= geometry_chunk);
+    double u[3 * geometry_chunk];
+    double *u1 = u, *u2 = &u[n], *u3 = &u[2*n];
+    prng.Fill_Array(u, 3 * n, PRNG_Close0_Open1);
+
+    double r1[geometry_chunk], r2[geometry_chunk];
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        r1[i] = 1.0 - u1[i];
+        u2[i] *= two_pi;
+        u3[i] *= two_pi;
+    }
+    prng::Sqrt_Array(r1, r1, n);
+    prng::Sqrt_Array(u1, r2, n);
+    prng::Sincos_Array(u2, q.x, q.y, n);
+    prng::Sincos_Array(u3, q.z, q.w, n);
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        q.w[i] *= r2[i];
+        q.x[i] *= r1[i];
+        q.y[i] *= r1[i];
+        q.z[i] *= r2[i];
+    }
+}
+
+// **************************************************************
+static void Points_In_Triangles(const double *u, const double *v, const uint64_t size,
+                                const double *origin, const double *edge1, const double *edge2,
+                                const uint64_t stride, double *xyz[3])
+/**
+ * Point j is origin + u' edge1 + v' edge2, where (u', v') is (u[j],
+ * v[j]) reflected into the triangle u' + v' <= 1 if needed (uniform
+ * in the triangle without rejection). Triangle j's vectors start at
+ * element j * stride (0: the same triangle for all points).
+ */
+{
+    for (uint64_t j = 0 ; j < size ; j++)
+    {
+        double s = u[j], t = v[j];
+        if (s + t > 1.0)
+        {
+            s = 1.0 - s;
+            t = 1.0 - t;
+        }
+        const uint64_t k = 3 * j * stride;
+        for (int c = 0 ; c < 3 ; c++)
+            xyz[c][j] = origin[k + c] + s * edge1[k + c] + t * edge2[k + c];
+    }
+}
+
+namespace prng
+{
+// **************************************************************
+void Fill_Random_Quaternions(PRNG &prng, double *q, const uint64_t n, const int layout)
+/**
+ * Fill "q" with "n" uniformly distributed unit quaternions (4n
+ * numbers), in "layout" (one of PRNG_Layouts). A unit quaternion and
+ * its opposite are the same rotation, so these are also uniform
+ * rotations (Haar measure on SO(3)).
+ */
+{
+    Quaternion_Chunk chunk;
+    for (uint64_t i = 0 ; i < n ; i += geometry_chunk)
+    {
+        const uint64_t size = std::min(geometry_chunk, n - i);
+        Random_Quaternions(prng, chunk, size);
+        const double *components[4] = {chunk.w, chunk.x, chunk.y, chunk.z};
+        Store_Chunk(q, n, i, size, 4, components, layout);
+    }
+}
+
+// **************************************************************
+void Fill_Random_Rotation_Matrices(PRNG &prng, double *R, const uint64_t n, const int layout)
+/**
+ * Fill "R" with "n" uniformly distributed 3x3 rotation matrices (9n
+ * numbers), in "layout" (one of PRNG_Layouts), computed from unit
+ * quaternions: no Gram-Schmidt, and orthonormal to rounding.
+ */
+{
+    Quaternion_Chunk chunk;
+    double m[9][geometry_chunk];
+    const double *components[9] = {m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]};
+    for (uint64_t i = 0 ; i < n ; i += geometry_chunk)
+    {
+        const uint64_t size = std::min(geometry_chunk, n - i);
+        Random_Quaternions(prng, chunk, size);
+        for (uint64_t j = 0 ; j < size ; j++)
+        {
+            const double w = chunk.w[j], x = chunk.x[j], y = chunk.y[j], z = chunk.z[j];
+            m[0][j] = 1.0 - 2.0 * (y*y + z*z);  m[1][j] = 2.0 * (x*y - w*z);        m[2][j] = 2.0 * (x*z + w*y);
+            m[3][j] = 2.0 * (x*y + w*z);        m[4][j] = 1.0 - 2.0 * (x*x + z*z);  m[5][j] = 2.0 * (y*z - w*x);
+            m[6][j] = 2.0 * (x*z - w*y);        m[7][j] = 2.0 * (y*z + w*x);        m[8][j] = 1.0 - 2.0 * (x*x + y*y);
+        }
+        Store_Chunk(R, n, i, size, 9, components, layout);
+    }
+}
+
+// **************************************************************
+void Fill_Points_In_Box(PRNG &prng, double *points, const uint64_t n, const double low[3], const double high[3],
+                        const int layout)
+/**
+ * Fill "points" with "n" points uniform in the box [low, high[ (per
+ * coordinate), in "layout" (one of PRNG_Layouts).
+ */
+{
+    double u[3 * geometry_chunk];
+    for (uint64_t i = 0 ; i < n ; i += geometry_chunk)
+    {
+        const uint64_t size = std::min(geometry_chunk, n - i);
+        prng.Fill_Array(u, 3 * size, PRNG_Close0_Open1);
+        for (int c = 0 ; c < 3 ; c++)
+        {
+            double *coordinates = &u[uint64_t(c) * size];
+            const double width = high[c] - low[c];
+            for (uint64_t j = 0 ; j < size ; j++)
+                coordinates[j] = low[c] + width * coordinates[j];
+        }
+        const double *components[3] = {u, &u[size], &u[2*size]};
+        Store_Chunk(points, n, i, size, 3, components, layout);
+    }
+}
+
+// **************************************************************
+void Fill_Points_In_Ball(PRNG &prng, double *points, const uint64_t n, const double center[3], const double radius,
+                         const int layout)
+/**
+ * Fill "points" with "n" points uniform in the ball of radius
+ * "radius" (> 0) around "center", in "layout" (one of PRNG_Layouts).
+ */
+{
+    Fill_Points_In_Shell(prng, points, n, center, 0.0, radius, layout);
+}
+
+// **************************************************************
+void Fill_Points_In_Shell(PRNG &prng, double *points, const uint64_t n, const double center[3],
+                          const double inner_radius, const double outer_radius, const int layout)
+/**
+ * Fill "points" with "n" points uniform in the spherical shell
+ * between "inner_radius" (>= 0) and "outer_radius" (> inner_radius)
+ * around "center", in "layout" (one of PRNG_Layouts). From u1, u2, u3
+ * in ]0,1]: a direction of z = 2 u1 - 1 and azimuth 2 pi u2 (uniform
+ * on the sphere, Archimedes), at a radius of cube
+ * r_in^3 + u3 (r_out^3 - r_in^3), its cube root computed as
+ * exp(log(.)/3).
+ */
+{
+    assert(inner_radius >= 0.0 && outer_radius > inner_radius);
+    const double inner_cube = inner_radius * inner_radius * inner_radius;
+    const double cube_width = outer_radius * outer_radius * outer_radius - inner_cube;
+
+    double u[3 * geometry_chunk];
+    double sines[geometry_chunk], cosines[geometry_chunk];
+    for (uint64_t i = 0 ; i < n ; i += geometry_chunk)
+    {
+        const uint64_t size = std::min(geometry_chunk, n - i);
+        prng.Fill_Array(u, 3 * size, PRNG_Open0_Close1);
+        double *z = u, *phi = &u[size], *r = &u[2*size];
+        for (uint64_t j = 0 ; j < size ; j++)
+        {
+            z[j]    = 2.0 * z[j] - 1.0;
+            phi[j] *= two_pi;
+            r[j]    = inner_cube + r[j] * cube_width;
+        }
+        prng::Log_Array(r, r, size);
+        for (uint64_t j = 0 ; j < size ; j++)
+            r[j] /= 3.0;
+        prng::Exp_Array(r, r, size);
+        prng::Sincos_Array(phi, sines, cosines, size);
+        // phi's storage now gets r sin(theta)
+        for (uint64_t j = 0 ; j < size ; j++)
+            phi[j] = 1.0 - z[j] * z[j];
+        prng::Sqrt_Array(phi, phi, size);
+        for (uint64_t j = 0 ; j < size ; j++)
+        {
+            phi[j]     *= r[j];
+            cosines[j]  = center[0] + phi[j] * cosines[j];
+            sines[j]    = center[1] + phi[j] * sines[j];
+            z[j]        = center[2] + r[j] * z[j];
+        }
+        const double *components[3] = {cosines, sines, z};
+        Store_Chunk(points, n, i, size, 3, components, layout);
+    }
+}
+
+// **************************************************************
+void Fill_Points_In_Disk(PRNG &prng, double *points, const uint64_t n, const double center[2], const double radius,
+                         const int layout)
+/**
+ * Fill "points" with "n" points (x, y) uniform in the disk of radius
+ * "radius" around "center", in "layout" (one of PRNG_Layouts): radius
+ * r sqrt(u1) and angle 2 pi u2, with u1, u2 in [0,1[.
+ */
+{
+    double u[2 * geometry_chunk];
+    double sines[geometry_chunk], cosines[geometry_chunk];
+    for (uint64_t i = 0 ; i < n ; i += geometry_chunk)
+    {
+        const uint64_t size = std::min(geometry_chunk, n - i);
+        prng.Fill_Array(u, 2 * size, PRNG_Close0_Open1);
+        double *r = u, *phi = &u[size];
+        prng::Sqrt_Array(r, r, size);
+        for (uint64_t j = 0 ; j < size ; j++)
+            phi[j] *= two_pi;
+        prng::Sincos_Array(phi, sines, cosines, size);
+        for (uint64_t j = 0 ; j < size ; j++)
+        {
+            const double rho = radius * r[j];
+            cosines[j] = center[0] + rho * cosines[j];
+            sines[j]   = center[1] + rho * sines[j];
+        }
+        const double *components[2] = {cosines, sines};
+        Store_Chunk(points, n, i, size, 2, components, layout);
+    }
+}
+
+// **************************************************************
+void Fill_Points_In_Triangle(PRNG &prng, double *points, const uint64_t n,
+                             const double a[3], const double b[3], const double c[3], const int layout)
+/**
+ * Fill "points" with "n" points uniform in the triangle (a, b, c), in
+ * "layout" (one of PRNG_Layouts).
+ */
+{
+    const double edge1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const double edge2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    double u[2 * geometry_chunk];
+    double x[geometry_chunk], y[geometry_chunk], z[geometry_chunk];
+    double *xyz[3] = {x, y, z};
+    for (uint64_t i = 0 ; i < n ; i += geometry_chunk)
+    {
+        const uint64_t size = std::min(geometry_chunk, n - i);
+        prng.Fill_Array(u, 2 * size, PRNG_Close0_Open1);
+        Points_In_Triangles(u, &u[size], size, a, edge1, edge2, 0, xyz);
+        const double *components[3] = {x, y, z};
+        Store_Chunk(points, n, i, size, 3, components, layout);
+    }
+}
+
+// **************************************************************
+void Fill_Points_In_Tetrahedron(PRNG &prng, double *points, const uint64_t n,
+                                const double a[3], const double b[3], const double c[3], const double d[3],
+                                const int layout)
+/**
+ * Fill "points" with "n" points uniform in the tetrahedron (a, b, c,
+ * d), in "layout" (one of PRNG_Layouts): the unit cube's (s, t, u) is
+ * folded into the unit tetrahedron s + t + u <= 1 by reflections that
+ * preserve volume (C. Rocchini and P. Cignoni, "Generating random
+ * points in a tetrahedron", Journal of Graphics Tools, 2000), then
+ * mapped to a + s (b-a) + t (c-a) + u (d-a).
+ */
+{
+    double e[3][3];
+    for (int k = 0 ; k < 3 ; k++)
+    {
+        e[0][k] = b[k] - a[k];
+        e[1][k] = c[k] - a[k];
+        e[2][k] = d[k] - a[k];
+    }
+    double u[3 * geometry_chunk];
+    for (uint64_t i = 0 ; i < n ; i += geometry_chunk)
+    {
+        const uint64_t size = std::min(geometry_chunk, n - i);
+        prng.Fill_Array(u, 3 * size, PRNG_Close0_Open1);
+        double *x = u, *y = &u[size], *z = &u[2*size];
+        for (uint64_t j = 0 ; j < size ; j++)
+        {
+            double s = x[j], t = y[j], v = z[j];
+            if (s + t > 1.0)
+            {
+                s = 1.0 - s;
+                t = 1.0 - t;
+            }
+            if (t + v > 1.0)
+            {
+                const double old_v = v;
+                v = 1.0 - s - t;
+                t = 1.0 - old_v;
+            }
+            else if (s + t + v > 1.0)
+            {
+                const double old_v = v;
+                v = s + t + v - 1.0;
+                s = 1.0 - t - old_v;
+            }
+            x[j] = a[0] + s * e[0][0] + t * e[1][0] + v * e[2][0];
+            y[j] = a[1] + s * e[0][1] + t * e[1][1] + v * e[2][1];
+            z[j] = a[2] + s * e[0][2] + t * e[1][2] + v * e[2][2];
+        }
+        const double *components[3] = {x, y, z};
+        Store_Chunk(points, n, i, size, 3, components, layout);
+    }
+}
+} // namespace prng
+
+// **************************************************************
+Triangle_Mesh_Sampler::Triangle_Mesh_Sampler(const double *vertices, const uint32_t *triangles, const uint32_t nb_triangles)
+/**
+ * Copy the triangles and build the alias table of their areas
+ * (Vose's method): the uniform probability 1/nb_triangles of each
+ * "column" is split between the triangle and one alias.
+ */
+    : origins(3 * size_t(nb_triangles)), edges1(3 * size_t(nb_triangles)), edges2(3 * size_t(nb_triangles)),
+      probabilities(nb_triangles), aliases(nb_triangles), area(0.0)
+{
+    std::vector<double> areas(nb_triangles);
+    for (uint32_t t = 0 ; t < nb_triangles ; t++)
+    {
+        const double *a = &vertices[3 * uint64_t(triangles[3*t])];
+        const double *b = &vertices[3 * uint64_t(triangles[3*t + 1])];
+        const double *c = &vertices[3 * uint64_t(triangles[3*t + 2])];
+        double *origin = &origins[3*t], *edge1 = &edges1[3*t], *edge2 = &edges2[3*t];
+        for (int k = 0 ; k < 3 ; k++)
+        {
+            origin[k] = a[k];
+            edge1[k]  = b[k] - a[k];
+            edge2[k]  = c[k] - a[k];
+        }
+        const double normal[3] = {edge1[1] * edge2[2] - edge1[2] * edge2[1],
+                                  edge1[2] * edge2[0] - edge1[0] * edge2[2],
+                                  edge1[0] * edge2[1] - edge1[1] * edge2[0]};
+        areas[t] = 0.5 * std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        area    += areas[t];
+    }
+    if (!(area > 0.0))
+    {
+        std_cout << "Triangle_Mesh_Sampler::Triangle_Mesh_Sampler(): The mesh has no area (" << nb_triangles
+                 << " triangles). Aborting.\n" << std::flush;
+        abort();
+    }
+
+    // Columns below and above the average area
+    std::vector<uint32_t> small, large;
+    for (uint32_t t = 0 ; t < nb_triangles ; t++)
+    {
+        probabilities[t] = areas[t] * double(nb_triangles) / area;
+        aliases[t]       = t;
+        if (probabilities[t] < 1.0)
+            small.push_back(t);
+        else
+            large.push_back(t);
+    }
+    while (!small.empty() && !large.empty())
+    {
+        const uint32_t s = small.back();
+        const uint32_t l = large.back();
+        small.pop_back();
+        aliases[s] = l;
+        probabilities[l] -= 1.0 - probabilities[s];
+        if (probabilities[l] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Left overs are full columns (up to rounding)
+    for (size_t k = 0 ; k < small.size() ; k++)
+        probabilities[small[k]] = 1.0;
+    for (size_t k = 0 ; k < large.size() ; k++)
+        probabilities[large[k]] = 1.0;
+}
+
+// **************************************************************
+void Triangle_Mesh_Sampler::Fill_Points(PRNG &prng, double *points, const uint64_t n, const int layout,
+                                        uint32_t *triangle_indices) const
+/**
+ * Fill "points" with "n" points uniform on the mesh's surface, in
+ * "layout" (one of PRNG_Layouts). For each chunk, one uniform number
+ * per point picks its triangle (column of the alias table, then the
+ * triangle or its alias), then two more place it in the triangle.
+ */
+{
+    const uint32_t nb_triangles = Get_Nb_Triangles();
+    double u[3 * geometry_chunk];
+    double origin[3 * geometry_chunk], edge1[3 * geometry_chunk], edge2[3 * geometry_chunk];
+    double x[geometry_chunk], y[geometry_chunk], z[geometry_chunk];
+    double *xyz[3] = {x, y, z};
+    for (uint64_t i = 0 ; i < n ; i += geometry_chunk)
+    {
+        const uint64_t size = std::min(geometry_chunk, n - i);
+        prng.Fill_Array(u, 3 * size, PRNG_Close0_Open1);
+        for (uint64_t j = 0 ; j < size ; j++)
+        {
+            const double column = u[j] * double(nb_triangles);
+            uint32_t t = std::min(uint32_t(column), nb_triangles - 1);
+            if (column - double(t) >= probabilities[t])
+                t = aliases[t];
+            if (triangle_indices != NULL)
+                triangle_indices[i + j] = t;
+            for (int k = 0 ; k < 3 ; k++)
+            {
+                origin[3*j + k] = origins[3*t + k];
+                edge1[3*j + k]  = edges1[3*t + k];
+                edge2[3*j + k]  = edges2[3*t + k];
+            }
+        }
+        Points_In_Triangles(&u[size], &u[2*size], size, origin, edge1, edge2, 1, xyz);
+        const double *components[3] = {x, y, z};
+        Store_Chunk(points, n, i, size, 3, components, layout);
+    }
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,78 @@
+#ifndef INC_Geometry_hpp
+#define INC_Geometry_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <vector>
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// Layouts of arrays of small vectors (k components per element)
+enum PRNG_Layouts
+{
+    PRNG_AoS,   // Array of structures: component c of element i is array[k*i + c]
+    PRNG_SoA    // Structure of arrays: component c of element i is array[c*n + i]
+};
+
+// **************************************************************
+// Uniform random orientations and points, in bulk: built on PRNG's
+// bulk generation and Vector_Math.hpp's kernels, so they are the same
+// on every ISA (with "make strict"). None of them rejects samples:
+// each costs a fixed number of uniform numbers (2 in a disk or a
+// triangle, 3 otherwise).
+namespace prng
+{
+    // Unit quaternions (w, x, y, z), uniform on the 3-sphere (Shoemake)
+    void Fill_Random_Quaternions(PRNG &prng, double *q, const uint64_t n, const int layout = PRNG_AoS);
+
+    // Rotation matrices, row major (component 3*row + column): the
+    // matrices of the quaternions Fill_Random_Quaternions() would give
+    // from the same generator state
+    void Fill_Random_Rotation_Matrices(PRNG &prng, double *R, const uint64_t n, const int layout = PRNG_AoS);
+
+    // Points (x, y, z) uniform in a volume or (x, y) in a disk
+    void Fill_Points_In_Box(PRNG &prng, double *points, const uint64_t n, const double low[3], const double high[3],
+                            const int layout = PRNG_AoS);
+    void Fill_Points_In_Ball(PRNG &prng, double *points, const uint64_t n, const double center[3], const double radius,
+                             const int layout = PRNG_AoS);
+    void Fill_Points_In_Shell(PRNG &prng, double *points, const uint64_t n, const double center[3],
+                              const double inner_radius, const double outer_radius, const int layout = PRNG_AoS);
+    void Fill_Points_In_Disk(PRNG &prng, double *points, const uint64_t n, const double center[2], const double radius,
+                             const int layout = PRNG_AoS);
+    void Fill_Points_In_Triangle(PRNG &prng, double *points, const uint64_t n,
+                                 const double a[3], const double b[3], const double c[3], const int layout = PRNG_AoS);
+    void Fill_Points_In_Tetrahedron(PRNG &prng, double *points, const uint64_t n,
+                                    const double a[3], const double b[3], const double c[3], const double d[3],
+                                    const int layout = PRNG_AoS);
+}
+
+// **************************************************************
+// Points uniform on the surface of a triangle mesh: a triangle is
+// picked with probability proportional to its area through an alias
+// table (one uniform number), then a point in it (two more). The mesh
+// is copied, so it can be freed after construction.
+class Triangle_Mesh_Sampler
+{
+    // Per triangle: first vertex and the two edges from it
+    std::vector<double>     origins;
+    std::vector<double>     edges1;
+    std::vector<double>     edges2;
+    // Alias table: triangle k is kept with probability probabilities[k],
+    // otherwise aliases[k] is taken
+    std::vector<double>     probabilities;
+    std::vector<uint32_t>   aliases;
+    double                  area;
+
+    public:
+        // "vertices": (x, y, z) of each vertex; "triangles": three
+        // vertex indices per triangle
+                    Triangle_Mesh_Sampler(const double *vertices, const uint32_t *triangles, const uint32_t nb_triangles);
+        uint32_t    Get_Nb_Triangles() const    { return uint32_t(probabilities.size()); }
+        double      Get_Area() const            { return area; }
+        // "n" points, and the index of the triangle of each if "triangle_indices" is given
+        void        Fill_Points(PRNG &prng, double *points, const uint64_t n, const int layout = PRNG_AoS,
+                                uint32_t *triangle_indices = NULL) const;
+};
+
+#endif // INC_Geometry_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,157 @@
+
+#include <iostream>
+#include <cstdlib>
+#include <cassert>
+#include <cstring> // memset()
+#include <cstdio> // getchar()
+
+#include <StdCout.hpp>
+
+#ifdef RAND_DSFMT
+#include "dSFMT/dSFMT.hpp"
+#endif // #ifdef RAND_DSFMT
+
+#include "Incremental_PRNG.hpp"
+
+const int Incremental_PRNG_is_initialized     = 12345;
+const int Incremental_PRNG_is_NOT_initialized = 0;
+
+// **************************************************************
+Incremental_PRNG::Incremental_PRNG()
+{
+    is_initialized  = Incremental_PRNG_is_NOT_initialized;
+    nb_calls        = 0;
+    seed            = 0;
+    current_data    = NULL;
+    next_data       = NULL;
+}
+
+// **************************************************************
+Incremental_PRNG::~Incremental_PRNG()
+{
+#ifdef RAND_DSFMT
+    delete ((dsfmt_t *) current_data);
+    delete ((dsfmt_t *) next_data);
+#endif // #ifdef RAND_DSFMT
+    current_data    = NULL;
+    next_data       = NULL;
+}
+
+// **************************************************************
+void Incremental_PRNG::Initialize_Taking_Time_As_Seed(const bool quiet)
+{
+    // Same seed PRNG would pick
+    PRNG prng;
+    prng.Initialize_Taking_Time_As_Seed(true); // quiet = true
+    Initialize(prng.Get_Seed(), quiet);
+}
+
+// **************************************************************
+void Incremental_PRNG::Initialize(const uint32_t new_seed, const bool quiet)
+/**
+ * Initialize the generator and generate the first block; only this
+ * first block is generated at once.
+ */
+{
+    seed            = new_seed;
+    nb_calls        = 0;
+    is_initialized  = Incremental_PRNG_is_initialized;
+
+#ifdef RAND_DSFMT
+    if (current_data == NULL)
+    {
+        current_data = new dsfmt_t;
+        next_data    = new dsfmt_t;
+    }
+    dsfmt_t *current = (dsfmt_t *) current_data;
+    dsfmt_t *next    = (dsfmt_t *) next_data;
+    memset(current, 0, sizeof(dsfmt_t));
+    memset(next,    0, sizeof(dsfmt_t));
+
+    dsfmt_init_gen_rand(current, new_seed);
+    dsfmt_gen_rand_all(current);
+    current->idx = 0;
+    next->status[DSFMT_N] = current->status[DSFMT_N];
+
+    if (!quiet)
+    {
+        std_cout
+            << "Using SIMD-oriented Fast Mersenne Twister (SFMT)\n"
+            << "pseudo-random number generator (PRNG), incremental refill\n"
+            << "See http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/SFMT/#dSFMT\n";
+    }
+#else  // #ifdef RAND_DSFMT
+    std_cout
+        << "###################################################################\n"
+        << "WARNING!!!! Using plain (crappy) C/C++ rand() function!!!\n"
+        << "Please recompile with -DRAND_DSFMT (see Makefile) for a better\n"
+        << "pseudo-random number generator.\n"
+        << "Enter to continue, Ctrl+C to cancel\n";
+
+    getchar();
+    srand(seed);
+#endif // #ifdef RAND_DSFMT
+    if (!quiet)
+    {
+        std_cout << "Library's PRNG's seed: " << seed << std::endl;
+    }
+}
+
+// **************************************************************
+double Incremental_PRNG::Get_Random_Close1_Open2()
+/**
+ * Return a pseudo-random number in the interval [1,2[
+ * (including 1, excluding 2), as PRNG::Get_Random_Close1_Open2().
+ * Each 128 bits word holds two numbers: the calls reading the first
+ * number of word "i" also compute word "i" of the next block.
+ */
+{
+    assert(is_initialized == Incremental_PRNG_is_initialized);
+
+    nb_calls++;
+#ifdef RAND_DSFMT
+    dsfmt_t *current = (dsfmt_t *) current_data;
+    const int idx = current->idx;
+
+    if ((idx & 1) == 0)
+        dsfmt_gen_rand_words((dsfmt_t *) next_data, current, idx / 2, idx / 2 + 1);
+
+    const double r = current->status[0].d[idx];
+
+    if (idx + 1 < DSFMT_N64)
+    {
+        current->idx = idx + 1;
+    }
+    else
+    {
+        // Current block exhausted: the next one is ready, swap them.
+        void *tmp    = current_data;
+        current_data = next_data;
+        next_data    = tmp;
+
+        current = (dsfmt_t *) current_data;
+        current->idx = 0;
+        ((dsfmt_t *) next_data)->status[DSFMT_N] = current->status[DSFMT_N];
+    }
+
+    return r;
+#else  // #ifdef RAND_DSFMT
+    return 1.0 + (double(rand()) / (double(RAND_MAX) - 1.0)); // [1,2[
+#endif // #ifdef RAND_DSFMT
+}
+
+// **************************************************************
+double Incremental_PRNG::Get_Random_Close0_Close1()
+/**
+ * Return a pseudo-random number in the interval [0,1]
+ * (including 0, including 1), as PRNG::Get_Random_Close0_Close1().
+ */
+{
+    double r;
+    do {
+        r = 2.0*Get_Random_Close0_Open1();
+    } while (r > 1.0);
+    return r;
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,47 @@
+#ifndef INC_Incremental_PRNG_hpp
+#define INC_Incremental_PRNG_hpp
+
+#include <stdint.h> // (u)int64_t
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Pseudo-random number generator with a flat cost per call. dSFMT
+// regenerates its whole state (DSFMT_N 128 bits words) on the call
+// that exhausts the current block, which shows up as tail latency.
+// Here the state is double buffered: while numbers are read from the
+// current block, every other call also computes one word of the next
+// block, which is complete when the current one is exhausted.
+// The sequence is the one a PRNG initialized with the same seed gives.
+class Incremental_PRNG
+{
+    int is_initialized;
+    uint64_t nb_calls;
+    uint32_t seed;
+
+    void *current_data; // Block being read
+    void *next_data;    // Next block, computed incrementally
+
+    // Owns its two states: not copyable (not implemented)
+                      Incremental_PRNG(const Incremental_PRNG &);
+    Incremental_PRNG &operator=(const Incremental_PRNG &);
+
+    public:
+                     Incremental_PRNG();
+                    ~Incremental_PRNG();
+        void        Initialize_Taking_Time_As_Seed(const bool quiet = false);
+        void        Initialize(const uint32_t seed, const bool quiet = false);
+        double      Get_Random_Close1_Open2();      // [1,2[
+        double      Get_Random()                    { return (2.0 - Get_Random_Close1_Open2());         } // ]0,1]
+        double      Get_Random_Close0_Open1()       { return Get_Random_Close1_Open2() - 1.0;           } // [0,1[
+        double      Get_Random_Open0_Close1()       { return (2.0 - Get_Random_Close1_Open2());         } // ]0,1]
+        double      Get_Random_CloseN1_Open1()      { return ((2.0 * Get_Random_Close1_Open2()) - 3.0); } // [-1,1[
+        double      Get_Random_Close0_Close1();     // [0,1]
+        double      Get_Random_CloseN1_Close1()     { return (2.0*Get_Random_Close0_Close1() - 1.0);    } // [-1,1]
+        uint32_t    Get_Seed()                      { return seed;     }
+        uint64_t    Get_Nb_Calls()                  { return nb_calls; }
+};
+
+#endif // INC_Incremental_PRNG_hpp
+
+// ********** End of file ***************************************
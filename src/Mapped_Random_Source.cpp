@@ -0,0 +1,275 @@
+
+#include <iostream>
+#include <cstdlib> // posix_memalign()
+#include <cassert>
+#include <cstdio>
+#include <cstring> // memset()
+#include <cerrno>
+#include <algorithm> // std::min()
+#include <sys/mman.h> // mmap()
+#include <sys/stat.h> // fstat()
+#include <fcntl.h> // open()
+#include <unistd.h> // close(), pwrite()
+
+#include <StdCout.hpp>
+
+#include "Mapped_Random_Source.hpp"
+
+const char     pool_magic[8]    = {'P','R','N','G','P','O','O','L'};
+const uint32_t pool_version     = 1;
+
+// **************************************************************
+Mapped_Random_Source::Mapped_Random_Source()
+{
+    fd              = -1;
+    mapping         = NULL;
+    mapping_size    = 0;
+    values          = NULL;
+    position        = 0;
+    memset(&header, 0, sizeof(header));
+}
+
+// **************************************************************
+Mapped_Random_Source::~Mapped_Random_Source()
+{
+    Close();
+}
+
+// **************************************************************
+bool Mapped_Random_Source::Generate(const std::string &filename, const uint32_t seed,
+                                    const uint64_t count, const int interval, const bool quiet)
+/**
+ * Generate a pool of "count" pseudo-random numbers, in the interval
+ * "interval" (one of PRNG_Intervals), using a PRNG initialized with
+ * "seed". The values are the ones PRNG::Fill_Array() would give.
+ *
+ * @param   filename    File to create (overwritten if it exists)
+ * @param   seed        PRNG's seed
+ * @param   count       Number of doubles in the pool
+ * @param   interval    Interval of the values [default: ]0,1] as Get_Random()]
+ * @param   quiet       Don't print anything [default: false]
+ */
+{
+    assert(sizeof(Random_Pool_Header) <= pool_header_size);
+
+    const int file = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+    {
+        std_cout << "Mapped_Random_Source: Couldn't open " << filename << " for writing: " << strerror(errno) << "\n" << std::flush;
+        return false;
+    }
+
+    PRNG prng;
+    prng.Initialize(seed, true); // quiet = true
+
+    Random_Pool_Header new_header;
+    memset(&new_header, 0, sizeof(new_header));
+    memcpy(new_header.magic, pool_magic, sizeof(pool_magic));
+    new_header.version      = pool_version;
+    new_header.seed         = seed;
+    new_header.mexp         = prng.Get_Mersenne_Exponent();
+    new_header.interval     = interval;
+    new_header.header_size  = pool_header_size;
+    new_header.count        = count;
+    new_header.digest       = 0;
+    strncpy(new_header.id_string, prng.Get_Id_String(), sizeof(new_header.id_string) - 1);
+
+    // Generate and write by chunks, digesting along the way.
+    const uint64_t chunk_size = uint64_t(1) << 20;
+    void *buffer = NULL;
+    if (posix_memalign(&buffer, 64, chunk_size * sizeof(double)) != 0)
+    {
+        std_cout << "Mapped_Random_Source: Couldn't allocate memory. Aborting.\n" << std::flush;
+        abort();
+    }
+    double *chunk = (double *) buffer;
+
+    bool success = true;
+    uint64_t offset = pool_header_size;
+    for (uint64_t i = 0 ; success && i < count ; i += chunk_size)
+    {
+        const uint64_t n = std::min(chunk_size, count - i);
+        prng.Fill_Array(chunk, n, interval);
+        new_header.digest = prng::Digest(chunk, n, new_header.digest);
+
+        const char *data = (const char *) chunk;
+        uint64_t size = n * sizeof(double);
+        while (success && size > 0)
+        {
+            const ssize_t written = pwrite(file, data, size, off_t(offset));
+            if (written < 0 && errno == EINTR)
+                continue;
+            success = (written > 0);
+            if (success)
+            {
+                data   += written;
+                size   -= uint64_t(written);
+                offset += uint64_t(written);
+            }
+        }
+    }
+    free(buffer);
+
+    // The header is written last, once the digest is known.
+    if (success)
+    {
+        char header_block[pool_header_size];
+        memset(header_block, 0, sizeof(header_block));
+        memcpy(header_block, &new_header, sizeof(new_header));
+        success = (pwrite(file, header_block, sizeof(header_block), 0) == ssize_t(sizeof(header_block)));
+    }
+    success = (close(file) == 0) && success;
+
+    if (!success)
+    {
+        std_cout << "Mapped_Random_Source: Couldn't write " << filename << ": " << strerror(errno) << "\n" << std::flush;
+    }
+    else if (!quiet)
+    {
+        std_cout << "Saved pool of " << count << " pseudo-random numbers (seed " << seed << ") to " << filename << "\n";
+    }
+
+    return success;
+}
+
+// **************************************************************
+bool Mapped_Random_Source::Open(const std::string &filename, const bool quiet)
+/**
+ * Map a pool file read-only. The header is checked but the values are
+ * not; call Verify() to compare them against the digest.
+ */
+{
+    Close();
+
+    fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std_cout << "Mapped_Random_Source: Couldn't open " << filename << ": " << strerror(errno) << "\n" << std::flush;
+        return false;
+    }
+
+    struct stat file_stat;
+    bool valid = (fstat(fd, &file_stat) == 0 && uint64_t(file_stat.st_size) >= pool_header_size);
+    if (valid)
+    {
+        mapping_size = uint64_t(file_stat.st_size);
+        void *address = mmap(NULL, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            std_cout << "Mapped_Random_Source: Couldn't map " << filename << ": " << strerror(errno) << "\n" << std::flush;
+            mapping = NULL;
+            Close();
+            return false;
+        }
+        mapping = (const char *) address;
+        memcpy(&header, mapping, sizeof(header));
+
+        valid = (memcmp(header.magic, pool_magic, sizeof(pool_magic)) == 0)
+             && (header.version == pool_version)
+             && (header.header_size % sizeof(double) == 0)
+             && (header.header_size <= mapping_size)
+             && (header.count <= (mapping_size - header.header_size) / sizeof(double));
+    }
+    if (!valid)
+    {
+        std_cout << "Mapped_Random_Source: " << filename << " is not a valid pool file\n" << std::flush;
+        Close();
+        return false;
+    }
+
+    values   = (const double *) (mapping + header.header_size);
+    position = 0;
+
+    // Values are mostly read in order: read ahead aggressively.
+    madvise((void *) mapping, mapping_size, MADV_SEQUENTIAL);
+
+    if (!quiet)
+    {
+        std_cout << "Mapped pool of " << header.count << " pseudo-random numbers from " << filename << "\n"
+                 << "    Generator: " << header.id_string << ", seed " << header.seed << "\n";
+    }
+
+    return true;
+}
+
+// **************************************************************
+void Mapped_Random_Source::Close()
+{
+    if (mapping != NULL)
+        munmap((void *) mapping, mapping_size);
+    if (fd >= 0)
+        close(fd);
+
+    fd              = -1;
+    mapping         = NULL;
+    mapping_size    = 0;
+    values          = NULL;
+    position        = 0;
+    memset(&header, 0, sizeof(header));
+}
+
+// **************************************************************
+bool Mapped_Random_Source::Verify()
+/**
+ * Compare the digest of the mapped values to the one in the header.
+ */
+{
+    assert(values != NULL);
+    return (prng::Digest(values, header.count) == header.digest);
+}
+
+// **************************************************************
+double Mapped_Random_Source::Get_Random()
+/**
+ * Return the next value of the pool.
+ */
+{
+    assert(values != NULL);
+    if (position >= header.count)
+    {
+        std_cout << "Mapped_Random_Source: Pool of " << header.count << " numbers exhausted. Aborting.\n" << std::flush;
+        abort();
+    }
+    return values[position++];
+}
+
+// **************************************************************
+const double *Mapped_Random_Source::Get_Block(const uint64_t n)
+/**
+ * Return a pointer to the next "n" values of the pool, without
+ * copying them, and advance past them.
+ */
+{
+    assert(values != NULL);
+    if (n > header.count - position)
+    {
+        std_cout << "Mapped_Random_Source: Pool of " << header.count << " numbers exhausted. Aborting.\n" << std::flush;
+        abort();
+    }
+    const double *block = &values[position];
+    position += n;
+    return block;
+}
+
+// **************************************************************
+double Mapped_Random_Source::Get_Value(const uint64_t offset)
+/**
+ * Return the value at "offset", without changing the position.
+ */
+{
+    assert(values != NULL);
+    assert(offset < header.count);
+    return values[offset];
+}
+
+// **************************************************************
+void Mapped_Random_Source::Seek(const uint64_t new_position)
+/**
+ * Set the position of the next value returned by Get_Random().
+ */
+{
+    assert(new_position <= header.count);
+    position = new_position;
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,69 @@
+#ifndef INC_Mapped_Random_Source_hpp
+#define INC_Mapped_Random_Source_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <string>
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Pool of pre-generated pseudo-random numbers saved to a file.
+// The file starts with a header of "pool_header_size" bytes
+// (see Random_Pool_Header) followed by the doubles, so the values
+// are page aligned once the file is mapped in memory.
+const uint64_t pool_header_size = 4096;
+
+struct Random_Pool_Header
+{
+    char     magic[8];          // "PRNGPOOL"
+    uint32_t version;
+    uint32_t seed;
+    int32_t  mexp;
+    int32_t  interval;          // One of PRNG_Intervals
+    uint64_t header_size;       // Offset of the first value
+    uint64_t count;             // Number of doubles
+    uint64_t digest;            // prng::Digest() of all values
+    char     id_string[128];    // PRNG::Get_Id_String() of the generator
+};
+
+// **************************************************************
+// Read-only access to a pool file mapped in memory. Processes mapping
+// the same file share its pages through the page cache.
+class Mapped_Random_Source
+{
+    int fd;
+    const char *mapping;
+    uint64_t mapping_size;
+
+    Random_Pool_Header header;
+    const double *values;
+    uint64_t position;
+
+    // Owns the mapping: not copyable (not implemented)
+                     Mapped_Random_Source(const Mapped_Random_Source &);
+    Mapped_Random_Source &operator=(const Mapped_Random_Source &);
+
+    public:
+                     Mapped_Random_Source();
+                    ~Mapped_Random_Source();
+        static bool  Generate(const std::string &filename, const uint32_t seed, const uint64_t count,
+                              const int interval = PRNG_Open0_Close1, const bool quiet = false);
+        bool         Open(const std::string &filename, const bool quiet = false);
+        void         Close();
+        bool         Verify();
+        double       Get_Random();                                  // Next value
+        const double *Get_Block(const uint64_t n);                  // Next n values, without copying
+        const double *Get_Values()          { return values;          }  // All values, without copying
+        double       Get_Value(const uint64_t offset);              // Value at "offset"
+        void         Seek(const uint64_t new_position);
+        uint64_t     Get_Position()         { return position;        }
+        uint64_t     Get_Count()            { return header.count;    }
+        uint32_t     Get_Seed()             { return header.seed;     }
+        int          Get_Mersenne_Exponent(){ return header.mexp;     }
+        int          Get_Interval()         { return header.interval; }
+        uint64_t     Get_Digest()           { return header.digest;   }
+};
+
+#endif // INC_Mapped_Random_Source_hpp
+
+// ********** End of file ***************************************
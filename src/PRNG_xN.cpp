@@ -0,0 +1,378 @@
+#include <cstdlib> // posix_memalign(), free()
+#include <cstring> // memcpy(), memset()
+#include <cassert>
+#include <algorithm> // std::min()
+
+#include <StdCout.hpp>
+
+#ifdef RAND_DSFMT
+#include "dSFMT/dSFMT-params.hpp"  // Recursion's parameters
+#include "dSFMT/dSFMT-jump.hpp"
+#endif // #ifdef RAND_DSFMT
+
+// The vector recursion is dSFMT's SSE2 one, on 2 or 4 words at a time
+#if defined(RAND_DSFMT) && defined(HAVE_SSE2)
+#include <immintrin.h>
+#if defined(__AVX512F__)
+#define PRNG_XN_AVX512
+#elif defined(__AVX2__)
+#define PRNG_XN_AVX2
+#else
+#define PRNG_XN_SSE2
+#endif
+#endif // #if defined(RAND_DSFMT) && defined(HAVE_SSE2)
+
+#include "PRNG_xN.hpp"
+
+#ifdef RAND_DSFMT
+// **************************************************************
+// dSFMT's recursion on "words_per_vector" lanes' words at a time:
+// word "r" (also "a", updated in place) from word "b" and the lanes'
+// lung "u".
+#if defined(PRNG_XN_AVX512)
+typedef __m512i Word_Vector;
+const int words_per_vector = 4;
+static inline Word_Vector Load(const w128_t *p)             { return _mm512_load_si512((const void *) p); }
+static inline void        Store(w128_t *p, Word_Vector v)   { _mm512_store_si512((void *) p, v); }
+static inline Word_Vector Mask()
+{
+    return _mm512_set4_epi32(DSFMT_MSK32_3, DSFMT_MSK32_4, DSFMT_MSK32_1, DSFMT_MSK32_2);
+}
+// Zero-masked forms with all lanes: GCC 12's unmasked shifts and
+// shuffle start from an undefined vector (-Wmaybe-uninitialized)
+static inline void Recursion(w128_t *r, const w128_t *b, Word_Vector &u, const Word_Vector mask)
+{
+    const Word_Vector x = Load(r);
+    const Word_Vector z = _mm512_xor_si512(_mm512_maskz_slli_epi64(0xFF, x, DSFMT_SL1), Load(b));
+    const Word_Vector y = _mm512_xor_si512(_mm512_maskz_shuffle_epi32(0xFFFF, u, (_MM_PERM_ENUM) SSE2_SHUFF), z);
+    Word_Vector v = _mm512_xor_si512(_mm512_maskz_srli_epi64(0xFF, y, DSFMT_SR), x);
+    v = _mm512_xor_si512(v, _mm512_and_si512(y, mask));
+    Store(r, v);
+    u = y;
+}
+#elif defined(PRNG_XN_AVX2)
+typedef __m256i Word_Vector;
+const int words_per_vector = 2;
+static inline Word_Vector Load(const w128_t *p)             { return _mm256_load_si256((const __m256i *) p); }
+static inline void        Store(w128_t *p, Word_Vector v)   { _mm256_store_si256((__m256i *) p, v); }
+static inline Word_Vector Mask()
+{
+    const __m128i mask = _mm_set_epi32(DSFMT_MSK32_3, DSFMT_MSK32_4, DSFMT_MSK32_1, DSFMT_MSK32_2);
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(mask), mask, 1);
+}
+static inline void Recursion(w128_t *r, const w128_t *b, Word_Vector &u, const Word_Vector mask)
+{
+    const Word_Vector x = Load(r);
+    const Word_Vector z = _mm256_xor_si256(_mm256_slli_epi64(x, DSFMT_SL1), Load(b));
+    const Word_Vector y = _mm256_xor_si256(_mm256_shuffle_epi32(u, SSE2_SHUFF), z);
+    Word_Vector v = _mm256_xor_si256(_mm256_srli_epi64(y, DSFMT_SR), x);
+    v = _mm256_xor_si256(v, _mm256_and_si256(y, mask));
+    Store(r, v);
+    u = y;
+}
+#elif defined(PRNG_XN_SSE2)
+typedef __m128i Word_Vector;
+const int words_per_vector = 1;
+static inline Word_Vector Load(const w128_t *p)             { return p->si; }
+static inline void        Store(w128_t *p, Word_Vector v)   { p->si = v; }
+static inline Word_Vector Mask()
+{
+    return _mm_set_epi32(DSFMT_MSK32_3, DSFMT_MSK32_4, DSFMT_MSK32_1, DSFMT_MSK32_2);
+}
+static inline void Recursion(w128_t *r, const w128_t *b, Word_Vector &u, const Word_Vector mask)
+{
+    const Word_Vector x = Load(r);
+    const Word_Vector z = _mm_xor_si128(_mm_slli_epi64(x, DSFMT_SL1), Load(b));
+    const Word_Vector y = _mm_xor_si128(_mm_shuffle_epi32(u, SSE2_SHUFF), z);
+    Word_Vector v = _mm_xor_si128(_mm_srli_epi64(y, DSFMT_SR), x);
+    v = _mm_xor_si128(v, _mm_and_si128(y, mask));
+    Store(r, v);
+    u = y;
+}
+#else  // standard C
+typedef w128_t Word_Vector;
+const int words_per_vector = 1;
+static inline Word_Vector Load(const w128_t *p)             { return *p; }
+static inline void        Store(w128_t *p, Word_Vector v)   { *p = v; }
+static inline Word_Vector Mask()                            { Word_Vector mask; mask.u[0] = DSFMT_MSK1; mask.u[1] = DSFMT_MSK2; return mask; }
+static inline void Recursion(w128_t *r, const w128_t *b, Word_Vector &u, const Word_Vector mask)
+{
+    const uint64_t t0 = r->u[0];
+    const uint64_t t1 = r->u[1];
+    const uint64_t L0 = u.u[0];
+    const uint64_t L1 = u.u[1];
+    u.u[0] = (t0 << DSFMT_SL1) ^ (L1 >> 32) ^ (L1 << 32) ^ b->u[0];
+    u.u[1] = (t1 << DSFMT_SL1) ^ (L0 >> 32) ^ (L0 << 32) ^ b->u[1];
+    r->u[0] = (u.u[0] >> DSFMT_SR) ^ (u.u[0] & mask.u[0]) ^ t0;
+    r->u[1] = (u.u[1] >> DSFMT_SR) ^ (u.u[1] & mask.u[1]) ^ t1;
+}
+#endif
+
+// **************************************************************
+template <int nb_lanes>
+static void Generate_Interleaved_Block(w128_t *status)
+/**
+ * dsfmt_gen_rand_all() on "nb_lanes" interleaved states: word i of
+ * lane l is status[i*nb_lanes + l], and the lungs follow word
+ * DSFMT_N-1. The lanes' chains are independent and overlap.
+ */
+{
+    const int nb_vectors = nb_lanes / words_per_vector;
+    const Word_Vector mask = Mask();
+    Word_Vector lung[nb_vectors];
+    for (int v = 0 ; v < nb_vectors ; v++)
+        lung[v] = Load(&status[DSFMT_N * nb_lanes + v * words_per_vector]);
+
+    int i;
+    for (i = 0 ; i < DSFMT_N - DSFMT_POS1 ; i++)
+    {
+        for (int v = 0 ; v < nb_vectors ; v++)
+            Recursion(&status[i * nb_lanes + v * words_per_vector],
+                      &status[(i + DSFMT_POS1) * nb_lanes + v * words_per_vector], lung[v], mask);
+    }
+    for ( ; i < DSFMT_N ; i++)
+    {
+        for (int v = 0 ; v < nb_vectors ; v++)
+            Recursion(&status[i * nb_lanes + v * words_per_vector],
+                      &status[(i + DSFMT_POS1 - DSFMT_N) * nb_lanes + v * words_per_vector], lung[v], mask);
+    }
+
+    for (int v = 0 ; v < nb_vectors ; v++)
+        Store(&status[DSFMT_N * nb_lanes + v * words_per_vector], lung[v]);
+}
+#endif // #ifdef RAND_DSFMT
+
+// **************************************************************
+static void Convert_Array(const double *from, double *to, const uint64_t n, const int interval)
+/**
+ * Convert "n" numbers in [1,2[ to one of PRNG_Intervals, the same way
+ * PRNG does. "to" can be "from".
+ */
+{
+    switch (interval)
+    {
+        case PRNG_Close0_Open1:
+            for (uint64_t i = 0 ; i < n ; i++)
+                to[i] = from[i] - 1.0;
+            break;
+        case PRNG_Open0_Close1:
+            for (uint64_t i = 0 ; i < n ; i++)
+                to[i] = 2.0 - from[i];
+            break;
+        case PRNG_Open0_Open1:
+            for (uint64_t i = 0 ; i < n ; i++)
+            {
+                // Set the lowest mantissa bit so 1 (thus 0) can't be reached
+                uint64_t u;
+                memcpy(&u, &from[i], sizeof(u));
+                u |= 1;
+                memcpy(&to[i], &u, sizeof(u));
+                to[i] -= 1.0;
+            }
+            break;
+        case PRNG_CloseN1_Open1:
+            for (uint64_t i = 0 ; i < n ; i++)
+                to[i] = (2.0 * from[i]) - 3.0;
+            break;
+        default:
+            if (to != from)
+                memcpy(to, from, size_t(n) * sizeof(double));
+            break;
+    }
+}
+
+// **************************************************************
+PRNG_xN::PRNG_xN(const int new_nb_lanes)
+{
+    if (new_nb_lanes != 4 && new_nb_lanes != 8)
+    {
+        std_cout << "PRNG_xN::PRNG_xN(): " << new_nb_lanes << " lanes requested; only 4 or 8 are supported. Aborting.\n" << std::flush;
+        abort();
+    }
+    nb_lanes    = new_nb_lanes;
+    seed        = 0;
+    state       = NULL;
+    block_size  = 0;
+    idx         = 0;
+    by_lane     = false;
+}
+
+// **************************************************************
+PRNG_xN::~PRNG_xN()
+{
+    free(state);
+    state = NULL;
+}
+
+// **************************************************************
+void PRNG_xN::Initialize(const uint32_t new_seed, const uint64_t first_substream)
+/**
+ * Lane l gets substream first_substream + l of "new_seed", obtained
+ * with dSFMT's jump-ahead (a fraction of a second per lane for
+ * DSFMT_MEXP 19937, see dSFMT/dSFMT-jump.hpp).
+ *
+ * @param   new_seed        Seed shared by all lanes
+ * @param   first_substream Substream of lane 0 [default: 0]
+ */
+{
+#ifdef RAND_DSFMT
+    seed = new_seed;
+
+    if (state == NULL)
+    {
+        if (posix_memalign(&state, 64, size_t(DSFMT_N + 1) * size_t(nb_lanes) * sizeof(w128_t)) != 0)
+        {
+            std_cout << "PRNG_xN::Initialize(): Couldn't allocate the states. Aborting.\n" << std::flush;
+            abort();
+        }
+    }
+    w128_t *status = (w128_t *) state;
+
+    dsfmt_t *dsfmt = new dsfmt_t;
+    memset(dsfmt, 0, sizeof(dsfmt_t));
+    dsfmt_init_gen_rand(dsfmt, new_seed);
+    dsfmt_poly_t jump;
+    if (first_substream > 0)
+    {
+        dsfmt_calc_jump(jump, first_substream, 64);
+        dsfmt_jump_by(dsfmt, jump);
+    }
+    dsfmt_calc_jump(jump, 1, 64);
+    for (int l = 0 ; l < nb_lanes ; l++)
+    {
+        if (l > 0)
+            dsfmt_jump_by(dsfmt, jump);
+        // Words and lung
+        for (int i = 0 ; i <= DSFMT_N ; i++)
+            status[i * nb_lanes + l] = dsfmt->status[i];
+    }
+    delete dsfmt;
+
+    block_size  = uint64_t(DSFMT_N64) * uint64_t(nb_lanes);
+    idx         = block_size;   // Nothing generated yet
+    by_lane     = false;
+#else  // #ifdef RAND_DSFMT
+    std_cout << "PRNG_xN::Initialize(): PRNG_xN needs dSFMT. Please recompile with -DRAND_DSFMT (see Makefile). Aborting.\n" << std::flush;
+    abort();
+#endif // #ifdef RAND_DSFMT
+}
+
+// **************************************************************
+void PRNG_xN::Generate_Block()
+{
+#ifdef RAND_DSFMT
+    assert(state != NULL);
+    if (nb_lanes == 4)
+        Generate_Interleaved_Block<4>((w128_t *) state);
+    else
+        Generate_Interleaved_Block<8>((w128_t *) state);
+#endif // #ifdef RAND_DSFMT
+    idx = 0;
+}
+
+// **************************************************************
+double PRNG_xN::Get_Random_Close1_Open2()
+/**
+ * Next number of the interleaved stream, in [1,2[.
+ */
+{
+    if (by_lane)
+    {
+        idx     = block_size;
+        by_lane = false;
+    }
+    if (idx >= block_size)
+        Generate_Block();
+    return ((const double *) state)[idx++];
+}
+
+// **************************************************************
+void PRNG_xN::Fill_Array(double *array, const uint64_t n, const int interval)
+/**
+ * Fill "array" with the next "n" numbers of the interleaved stream, in
+ * the requested interval (one of PRNG_Intervals). Same numbers as "n"
+ * calls to Get_Random_Close1_Open2(), converted.
+ */
+{
+    if (by_lane)
+    {
+        idx     = block_size;
+        by_lane = false;
+    }
+
+    const double *block = (const double *) state;
+    uint64_t i = 0;
+    while (i < n)
+    {
+        if (idx >= block_size)
+            Generate_Block();
+        const uint64_t count = std::min(n - i, block_size - idx);
+        Convert_Array(&block[idx], &array[i], count, interval);
+        idx += count;
+        i   += count;
+    }
+}
+
+// **************************************************************
+void PRNG_xN::Fill_Lanes(double *array, const uint64_t n, const int interval)
+/**
+ * Draw the next "n" numbers of every lane, in the requested interval
+ * (one of PRNG_Intervals): array[l*n + k] is the k-th one of lane l.
+ */
+{
+    if (!by_lane)
+    {
+        idx     = block_size;
+        by_lane = true;
+    }
+
+    const double *block = (const double *) state;
+    const uint64_t lanes = uint64_t(nb_lanes);
+    uint64_t k = 0;
+    while (k < n)
+    {
+        if (idx >= block_size)
+            Generate_Block();
+        // Position in each lane's block
+        const uint64_t position = idx / lanes;
+        const uint64_t count    = std::min(n - k, block_size / lanes - position);
+        for (uint64_t l = 0 ; l < lanes ; l++)
+        {
+            // Lane l's words are 2*lanes numbers apart
+            double *lane_array = &array[l * n + k];
+            const double *word = &block[(position / 2) * 2 * lanes + 2 * l];
+            uint64_t p = 0;
+            if (position % 2 == 1)
+            {
+                lane_array[p++] = word[1];
+                word += 2 * lanes;
+            }
+            for ( ; p + 2 <= count ; p += 2, word += 2 * lanes)
+            {
+                lane_array[p]     = word[0];
+                lane_array[p + 1] = word[1];
+            }
+            if (p < count)
+                lane_array[p] = word[0];
+            Convert_Array(lane_array, lane_array, count, interval);
+        }
+        idx += count * lanes;
+        k   += count;
+    }
+}
+
+// **************************************************************
+const char *PRNG_xN::Get_ISA()
+{
+#if defined(PRNG_XN_AVX512)
+    return "AVX-512";
+#elif defined(PRNG_XN_AVX2)
+    return "AVX2";
+#elif defined(PRNG_XN_SSE2)
+    return "SSE2";
+#else
+    return "standard C";
+#endif
+}
+
+// ********** End of file ***************************************
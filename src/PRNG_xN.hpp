@@ -0,0 +1,54 @@
+#ifndef INC_PRNG_xN_hpp
+#define INC_PRNG_xN_hpp
+
+#include <stdint.h> // (u)int64_t
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Several dSFMT generators advanced together. One dSFMT block can't
+// use wide vectors well: each 128 bits word depends on the previous
+// one through the "lung". Here 4 or 8 independent states (lanes) are
+// interleaved word by word (word i of every lane is contiguous), so
+// one SSE2/AVX2/AVX-512 instruction advances 1, 2 or 4 lanes and the
+// lanes' dependency chains overlap.
+// Lane l is substream first_substream + l of the seed: the sequence
+// of PRNG::Initialize_Rank(seed, first_substream + l, ...), 2^64
+// blocks apart. The numbers are read either as one stream (blocks of
+// all lanes interleaved two numbers at a time: lane 0's numbers 0 and
+// 1, lane 1's numbers 0 and 1, ..., lane 0's numbers 2 and 3, ...)
+// with Fill_Array(), or lane by lane with Fill_Lanes(). Switching
+// from one to the other discards the rest of the current block.
+class PRNG_xN
+{
+    int      nb_lanes;
+    uint32_t seed;
+    void    *state;         // Interleaved dSFMT states
+    uint64_t block_size;    // Numbers per block, all lanes
+    uint64_t idx;           // Numbers of the current block already used
+    bool     by_lane;       // Current block read by Fill_Lanes()
+
+    void    Generate_Block();
+
+    // Owns the states: not copyable (not implemented)
+             PRNG_xN(const PRNG_xN &);
+    PRNG_xN &operator=(const PRNG_xN &);
+
+    public:
+        explicit     PRNG_xN(const int nb_lanes = 8);
+                    ~PRNG_xN();
+        void        Initialize(const uint32_t seed, const uint64_t first_substream = 0);
+        // Interleaved stream
+        double      Get_Random_Close1_Open2();
+        void        Fill_Array(double *array, const uint64_t n, const int interval);
+        // Per lane: array[l*n + k] is the k-th number of lane l
+        void        Fill_Lanes(double *array, const uint64_t n, const int interval);
+        int         Get_Nb_Lanes() const    { return nb_lanes; }
+        uint32_t    Get_Seed() const        { return seed;     }
+        // "AVX-512", "AVX2", "SSE2" or "standard C": the recursion's instructions
+        static const char *Get_ISA();
+};
+
+#endif // INC_PRNG_xN_hpp
+
+// ********** End of file ***************************************
@@ -4,24 +4,164 @@
 #include <cassert>
 #include <cmath>
 #include <sys/time.h> // gettimeofday()
-#include <cstring> // memset()
+#include <cstring> // memset(), memcpy()
 #include <unistd.h> // getpid()
+#include <algorithm> // std::min()
+#include <fstream>
+#include <sstream>
+#include <ctime> // clock_gettime()
 
 #include <StdCout.hpp>
 #include <Memory.hpp>
 
 
 #ifdef RAND_DSFMT
+#include <pthread.h>
 #include "dSFMT/dSFMT.hpp"
+#include "dSFMT/dSFMT-jump.hpp"
 #endif // #ifdef RAND_DSFMT
 
 
 #include "PseudoRandomNumberGenerator.hpp"
+#include "Vector_Math.hpp"
 
 // Special code since "is_initialized" might initially be undefined
 const int PRNG_is_initialized       = 12345;
 const int PRNG_is_NOT_initialized   = 0;
 
+// Instrumentation (see PRNG_Stats). Without PRNG_STATS, nothing is compiled.
+#ifdef PRNG_STATS
+#define PRNG_STATS_ADD(counter, value)      stats.counter += uint64_t(value)
+#define PRNG_STATS_START_TIMER(timer)       const uint64_t timer = Read_Cycle_Counter()
+#define PRNG_STATS_STOP_TIMER(counter, timer) stats.counter += Read_Cycle_Counter() - timer
+#else  // #ifdef PRNG_STATS
+#define PRNG_STATS_ADD(counter, value)
+#define PRNG_STATS_START_TIMER(timer)
+#define PRNG_STATS_STOP_TIMER(counter, timer)
+#endif // #ifdef PRNG_STATS
+
+// Totals of the counters merged by all PRNGs
+static PRNG_Stats global_stats;
+
+#ifdef PRNG_STATS
+// **************************************************************
+static inline uint64_t Read_Cycle_Counter()
+/**
+ * Return the processor's time stamp counter on x86, or a nanoseconds
+ * clock elsewhere.
+ */
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t low, high;
+    __asm__ __volatile__ ("rdtsc" : "=a" (low), "=d" (high));
+    return (uint64_t(high) << 32) | uint64_t(low);
+#else
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * uint64_t(1000000000) + uint64_t(now.tv_nsec);
+#endif
+}
+#endif // #ifdef PRNG_STATS
+
+// **************************************************************
+static inline double Convert_From_Close1_Open2(double r, const int interval)
+/**
+ * Convert a number in [1,2[ to the requested interval, the same way
+ * the Get_Random_*() functions do.
+ */
+{
+    switch (interval)
+    {
+        case PRNG_Close0_Open1:
+            return r - 1.0;
+        case PRNG_Open0_Close1:
+            return 2.0 - r;
+        case PRNG_Open0_Open1:
+        {
+            // Set the lowest mantissa bit so 1 (thus 0) can't be reached
+            union {
+                double   d;
+                uint64_t u;
+            } bits;
+            bits.d  = r;
+            bits.u |= 1;
+            return bits.d - 1.0;
+        }
+        case PRNG_CloseN1_Open1:
+            return (2.0 * r) - 3.0;
+        default:
+            return r;
+    }
+}
+
+// **************************************************************
+static inline double *Align_64(double *storage)
+/**
+ * First 64 bytes aligned address in "storage", a buffer with 7 spare
+ * numbers: temporary buffers live on the stack instead of being
+ * allocated by each bulk call, and Fill_Array() still gets the 16
+ * bytes alignment of its fast path.
+ */
+{
+    return (double *) ((uintptr_t(storage) + 63) & ~uintptr_t(63));
+}
+
+#ifdef RAND_DSFMT
+// One chunk of PRNG::Parallel_Fill(), filled by its own thread
+struct Parallel_Fill_Chunk
+{
+    PRNG     *prng;
+    double   *array;
+    uint64_t  n;
+    int       interval;
+};
+
+// **************************************************************
+static void *Parallel_Fill_Worker(void *parallel_fill_chunk)
+{
+    Parallel_Fill_Chunk *chunk = (Parallel_Fill_Chunk *) parallel_fill_chunk;
+    chunk->prng->Fill_Array(chunk->array, chunk->n, chunk->interval);
+    return NULL;
+}
+
+// Jump polynomials of the last chunk sizes of PRNG::Parallel_Fill(),
+// shared by all PRNGs: computing one costs more than the jumps
+const int nb_cached_jumps = 4;
+static struct {
+    uint64_t     nb_blocks[nb_cached_jumps];    // 0 for an empty entry
+    dsfmt_poly_t jumps[nb_cached_jumps];
+    int          next;                          // Entry replaced next
+} parallel_fill_jumps;
+static pthread_mutex_t parallel_fill_jumps_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// **************************************************************
+static void Parallel_Fill_Jump(dsfmt_poly_t &jump, const uint64_t nb_blocks)
+/**
+ * Jump polynomial of "nb_blocks" blocks, from the cache if possible.
+ */
+{
+    pthread_mutex_lock(&parallel_fill_jumps_mutex);
+    for (int j = 0 ; j < nb_cached_jumps ; j++)
+    {
+        if (parallel_fill_jumps.nb_blocks[j] == nb_blocks)
+        {
+            jump = parallel_fill_jumps.jumps[j];
+            pthread_mutex_unlock(&parallel_fill_jumps_mutex);
+            return;
+        }
+    }
+    pthread_mutex_unlock(&parallel_fill_jumps_mutex);
+
+    dsfmt_calc_jump(jump, nb_blocks);
+
+    pthread_mutex_lock(&parallel_fill_jumps_mutex);
+    const int j = parallel_fill_jumps.next;
+    parallel_fill_jumps.nb_blocks[j] = nb_blocks;
+    parallel_fill_jumps.jumps[j]     = jump;
+    parallel_fill_jumps.next         = (j + 1) % nb_cached_jumps;
+    pthread_mutex_unlock(&parallel_fill_jumps_mutex);
+}
+#endif // #ifdef RAND_DSFMT
 
 // **************************************************************
 PRNG::PRNG()
@@ -31,17 +171,72 @@ PRNG::PRNG()
 #ifdef RAND_DSFMT
     dsfmt_data = NULL;
 #endif // #ifdef RAND_DSFMT
+    memset(&stats, 0, sizeof(stats));
+    block_interval = PRNG_Close1_Open2;
+    block_begin    = 0;
+}
+
+// **************************************************************
+PRNG::PRNG(const PRNG &source)
+/**
+ * Independent copy: its own state, continuing with the same numbers
+ * as "source".
+ */
+{
+    is_initialized = PRNG_is_NOT_initialized;
+    nb_calls = 0;
+#ifdef RAND_DSFMT
+    dsfmt_data = NULL;
+#endif // #ifdef RAND_DSFMT
+    memset(&stats, 0, sizeof(stats));
+    block_interval = PRNG_Close1_Open2;
+    block_begin    = 0;
+    *this = source;
+}
+
+// **************************************************************
+PRNG &PRNG::operator=(const PRNG &source)
+/**
+ * Copy the state of "source" into this generator's own (allocated on
+ * the first copy). The statistics are not copied: each generator
+ * merges its own.
+ */
+{
+    if (this == &source)
+        return *this;
+    if (source.is_initialized == PRNG_is_initialized)
+        Initialize_Copy(source);
+    else
+        is_initialized = PRNG_is_NOT_initialized;
+    nb_calls = source.nb_calls;
+    return *this;
 }
 
 // **************************************************************
 PRNG::~PRNG()
 {
+#ifdef PRNG_STATS
+    Merge_Stats();
+#endif // #ifdef PRNG_STATS
 #ifdef RAND_DSFMT
     delete ((dsfmt_t *) dsfmt_data);
     dsfmt_data = NULL;
 #endif // #ifdef RAND_DSFMT
 }
 
+// **************************************************************
+void PRNG::Allocate_State()
+/**
+ * Allocate the generator's state, unless a previous initialization
+ * did: initializing again reuses it.
+ */
+{
+#ifdef RAND_DSFMT
+    if (dsfmt_data == NULL)
+        dsfmt_data = new dsfmt_t;
+#endif // #ifdef RAND_DSFMT
+}
+
 // **************************************************************
 void PRNG::Initialize_Taking_Time_As_Seed(const bool quiet)
 {
@@ -76,13 +271,15 @@ void PRNG::Initialize_Taking_Time_As_Seed(const bool quiet)
 void PRNG::Initialize(const uint32_t new_seed, const bool quiet)
 {
 #ifdef RAND_DSFMT
-    dsfmt_data = new dsfmt_t;
+    Allocate_State();
     memset(dsfmt_data, 0, sizeof(dsfmt_t));
 #endif // #ifdef RAND_DSFMT
 
     seed           = new_seed;
     is_initialized = PRNG_is_initialized;
     nb_calls       = 0;
+    block_interval = PRNG_Close1_Open2;
+    block_begin    = 0;
 #ifdef RAND_DSFMT
     if (!quiet)
     {
@@ -111,6 +308,156 @@ void PRNG::Initialize(const uint32_t new_seed, const bool quiet)
     }
 }
 
+// **************************************************************
+void PRNG::Initialize(const Seed_Sequence &seed_sequence, const uint64_t stream, const bool quiet)
+/**
+ * Initialize with stream "stream" of a seed sequence: the whole state
+ * is filled from the stream's 64-bit seed (dsfmt_init_by_seed64()),
+ * which is much cheaper than Initialize(uint32_t). Get_Seed() returns
+ * the low 32 bits of the stream's seed.
+ *
+ * @param   seed_sequence   Seed (64, 128 bits or array) of all streams
+ * @param   stream          Stream number [default: 0]
+ * @param   quiet           Don't print anything [default: false]
+ */
+{
+    const uint64_t stream_seed = seed_sequence.Stream_Seed(stream);
+#ifdef RAND_DSFMT
+    Allocate_State();
+    dsfmt_init_by_seed64((dsfmt_t *) dsfmt_data, stream_seed);
+
+    seed           = uint32_t(stream_seed);
+    is_initialized = PRNG_is_initialized;
+    nb_calls       = 0;
+    block_interval = PRNG_Close1_Open2;
+    block_begin    = 0;
+#else  // #ifdef RAND_DSFMT
+    Initialize(uint32_t(stream_seed), true); // quiet = true
+#endif // #ifdef RAND_DSFMT
+
+    if (!quiet)
+    {
+        std_cout << "Library's PRNG's seed: " << stream_seed << " (stream " << stream << " of a seed sequence)" << std::endl;
+    }
+}
+
+// **************************************************************
+void PRNG::Initialize_By_Array(const uint32_t *key, const int length, const bool quiet)
+/**
+ * Initialize with an array of 32-bit words, using all of them
+ * (dSFMT's init_by_array()). Get_Seed() returns the first word.
+ *
+ * @param   key     Seed words
+ * @param   length  Number of words
+ * @param   quiet   Don't print anything [default: false]
+ */
+{
+    assert(length >= 1);
+#ifdef RAND_DSFMT
+    std::vector<uint32_t> init_key(key, key + length);
+    Allocate_State();
+    dsfmt_init_by_array((dsfmt_t *) dsfmt_data, &init_key[0], length);
+
+    seed           = key[0];
+    is_initialized = PRNG_is_initialized;
+    nb_calls       = 0;
+    block_interval = PRNG_Close1_Open2;
+    block_begin    = 0;
+#else  // #ifdef RAND_DSFMT
+    Initialize(key[0], true); // quiet = true
+#endif // #ifdef RAND_DSFMT
+
+    if (!quiet)
+    {
+        std_cout << "Library's PRNG's seed: array of " << length << " words starting with " << key[0] << std::endl;
+    }
+}
+
+// **************************************************************
+void PRNG::Initialize_Array(PRNG *prngs, const uint64_t n, const Seed_Sequence &seed_sequence,
+                            const uint64_t first_stream)
+/**
+ * Initialize "n" generators at once, generator i with stream
+ * "first_stream + i" of "seed_sequence" (see Initialize(const
+ * Seed_Sequence &, ...)), quietly. The generators are independent, so
+ * the loop is shared between OpenMP threads when compiled with
+ * PARALLEL_OMP.
+ */
+{
+#ifdef PARALLEL_OMP
+#pragma omp parallel for schedule(static)
+#endif // #ifdef PARALLEL_OMP
+    for (int64_t i = 0 ; i < int64_t(n) ; i++)
+    {
+        prngs[i].Initialize(seed_sequence, first_stream + uint64_t(i), true); // quiet = true
+    }
+}
+
+// **************************************************************
+void PRNG::Initialize_Copy(const PRNG &source)
+/**
+ * Initialize with a copy of the state of "source", without seeding
+ * first: the same numbers follow. A block converted by Next_Block() is
+ * copied with what restores it.
+ */
+{
+    assert(source.is_initialized == PRNG_is_initialized);
+#ifdef RAND_DSFMT
+    Allocate_State();
+    memcpy(dsfmt_data, source.dsfmt_data, sizeof(dsfmt_t));
+#endif // #ifdef RAND_DSFMT
+
+    seed           = source.seed;
+    is_initialized = PRNG_is_initialized;
+    nb_calls       = 0;
+    block_interval = source.block_interval;
+    block_begin    = source.block_begin;
+    block_low_bits = source.block_low_bits;
+}
+
+// **************************************************************
+void PRNG::Initialize_Rank(const uint32_t master_seed, const int rank, const int nb_ranks, const bool quiet)
+/**
+ * Initialize the generator of process "rank" (out of "nb_ranks") of a
+ * parallel job: all ranks share "master_seed" and get non-overlapping
+ * substreams of the same sequence. Rank r starts r * 2^64 dSFMT blocks
+ * after the start of Initialize(master_seed), so rank 0 is that
+ * sequence, a rank's numbers don't depend on "nb_ranks" and each rank
+ * can draw 2^64 * DSFMT_N64 numbers before reaching the next one.
+ * The jump costs a fraction of a second for DSFMT_MEXP 19937 (see
+ * dSFMT/dSFMT-jump.hpp), once per process.
+ *
+ * @param   master_seed Seed shared by all ranks
+ * @param   rank        Rank of this process, in [0, nb_ranks[
+ * @param   nb_ranks    Number of processes
+ * @param   quiet       Don't print anything [default: false]
+ */
+{
+    if (rank < 0 || rank >= nb_ranks)
+    {
+        std_cout << "PRNG::Initialize_Rank(): Rank " << rank << " not in [0," << nb_ranks << "[. Aborting.\n" << std::flush;
+        abort();
+    }
+
+#ifdef RAND_DSFMT
+    Initialize(master_seed, true); // quiet = true
+    if (rank > 0)
+    {
+        dsfmt_poly_t jump;
+        dsfmt_calc_jump(jump, uint64_t(rank), 64);
+        dsfmt_jump_by((dsfmt_t *) dsfmt_data, jump);
+    }
+#else  // #ifdef RAND_DSFMT
+    // No jump-ahead with rand(): ranks only get different seeds.
+    Initialize(master_seed + uint32_t(rank), true); // quiet = true
+#endif // #ifdef RAND_DSFMT
+
+    if (!quiet)
+    {
+        std_cout << "Library's PRNG's seed: " << master_seed << ", substream of rank " << rank << " of " << nb_ranks << std::endl;
+    }
+}
+
 // **************************************************************
 double PRNG::Get_Random()
 /**
@@ -139,8 +486,11 @@ double PRNG::Get_Random_Close1_Open2()
 #ifdef RAND_DSFMT
     // Use  SIMD-oriented Fast Mersenne Twister (SFMT)
     // See http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/SFMT/
-    // dsfmt_genrand_close1_open2() returns a double between: [1,2[
-    return dsfmt_genrand_close1_open2((dsfmt_t *) dsfmt_data);
+    // Same as dsfmt_genrand_close1_open2(), which returns a double between: [1,2[
+    dsfmt_t *dsfmt = (dsfmt_t *) dsfmt_data;
+    if (dsfmt->idx >= DSFMT_N64)
+        Refill_Block();
+    return dsfmt->status[0].d[dsfmt->idx++];
 #else  // #ifdef RAND_DSFMT
     //return double(rand()) / double(RAND_MAX);         // [0,1]
     //return double(rand()) / (double(RAND_MAX) - 1.0); // [0,1[
@@ -149,6 +499,159 @@ double PRNG::Get_Random_Close1_Open2()
 #endif // #ifdef RAND_DSFMT
 }
 
+// **************************************************************
+void PRNG::Refill_Block()
+/**
+ * Regenerate dSFMT's block once all its numbers are used.
+ */
+{
+#ifdef RAND_DSFMT
+    dsfmt_t *dsfmt = (dsfmt_t *) dsfmt_data;
+    if (block_interval != PRNG_Close1_Open2)
+        Restore_Block();
+
+    PRNG_STATS_START_TIMER(start);
+    dsfmt_gen_rand_all(dsfmt);
+    dsfmt->idx = 0;
+    PRNG_STATS_STOP_TIMER(refill_cycles, start);
+    PRNG_STATS_ADD(nb_refills, 1);
+#endif // #ifdef RAND_DSFMT
+}
+
+// **************************************************************
+void PRNG::Restore_Block()
+/**
+ * Undo the in place conversion of Next_Block(): dSFMT computes the
+ * next block from this one. The conversions are exact, so adding back
+ * what was removed gives the original [1,2[ numbers, except for the
+ * lowest bit set by Open0_Open1 which was saved.
+ */
+{
+#ifdef RAND_DSFMT
+    dsfmt_t *dsfmt = (dsfmt_t *) dsfmt_data;
+    double *psfmt64 = &dsfmt->status[0].d[0];
+    union {
+        double   d;
+        uint64_t u;
+    } bits;
+
+    for (int i = block_begin ; i < DSFMT_N64 ; i++)
+    {
+        switch (block_interval)
+        {
+            case PRNG_Close0_Open1:
+                psfmt64[i] = psfmt64[i] + 1.0;
+                break;
+            case PRNG_Open0_Close1:
+                psfmt64[i] = 2.0 - psfmt64[i];
+                break;
+            case PRNG_CloseN1_Open1:
+                psfmt64[i] = (psfmt64[i] + 3.0) * 0.5;
+                break;
+            case PRNG_Open0_Open1:
+            {
+                const int j = i - block_begin;
+                bits.d  = psfmt64[i] + 1.0;
+                bits.u  = (bits.u & ~uint64_t(1)) | ((block_low_bits[j / 64] >> (j % 64)) & 1);
+                psfmt64[i] = bits.d;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+#endif // #ifdef RAND_DSFMT
+    block_interval = PRNG_Close1_Open2;
+    block_begin    = 0;
+}
+
+// **************************************************************
+const double *PRNG::Next_Block(uint64_t &size, const int interval)
+/**
+ * Return the numbers left in dSFMT's current block, or a newly generated
+ * block if it's used up, converted in place to "interval" (one of
+ * PRNG_Intervals) and counted as used. No copy is made: the numbers are
+ * read straight from the generator's state, and are valid until the
+ * next call to this PRNG.
+ * The numbers are the ones the corresponding Get_Random_*() calls (or
+ * Fill_Array()) would give, so one at a time calls, bulk fills and
+ * blocks can be mixed. Blocks are at most DSFMT_N64 numbers; the first
+ * one is shorter after one at a time calls.
+ *
+ * @param   size        Set to the number of numbers in the block
+ * @param   interval    Interval of the numbers [default: [1,2[]
+ */
+{
+    assert(is_initialized == PRNG_is_initialized);
+#ifdef RAND_DSFMT
+    assert(dsfmt_data != NULL);
+    dsfmt_t *dsfmt = (dsfmt_t *) dsfmt_data;
+    if (dsfmt->idx >= DSFMT_N64)
+        Refill_Block();
+
+    double *block = &dsfmt->status[0].d[dsfmt->idx];
+    size = uint64_t(DSFMT_N64 - dsfmt->idx);
+
+    if (interval == PRNG_Open0_Open1)
+        block_low_bits.assign((size + 63) / 64, 0);
+    union {
+        double   d;
+        uint64_t u;
+    } bits;
+    for (uint64_t i = 0 ; interval != PRNG_Close1_Open2 && i < size ; i++)
+    {
+        if (interval == PRNG_Open0_Open1)
+        {
+            bits.d = block[i];
+            block_low_bits[i / 64] |= (bits.u & 1) << (i % 64);
+        }
+        block[i] = Convert_From_Close1_Open2(block[i], interval);
+    }
+
+    block_interval = interval;
+    block_begin    = dsfmt->idx;
+    dsfmt->idx     = DSFMT_N64;
+    nb_calls      += size;
+
+    return block;
+#else  // #ifdef RAND_DSFMT
+    std_cout << "PRNG::Next_Block() requires dSFMT (-DRAND_DSFMT). Aborting.\n" << std::flush;
+    abort();
+    size = 0;
+    return NULL;
+#endif // #ifdef RAND_DSFMT
+}
+
+// **************************************************************
+void PRNG::Jump(const uint64_t n)
+/**
+ * Skip the next "n" numbers: the generator ends up where "n" calls to
+ * Get_Random_Close1_Open2() would leave it. Whole dSFMT blocks are
+ * skipped with jump-ahead (see dSFMT/dSFMT-jump.hpp), which costs about
+ * as much as generating a few blocks, whatever "n" is. The jump
+ * polynomial is computed on the first jump of the process.
+ */
+{
+    assert(is_initialized == PRNG_is_initialized);
+#ifdef RAND_DSFMT
+    assert(dsfmt_data != NULL);
+    if (n == 0)
+        return;
+    dsfmt_t *dsfmt = (dsfmt_t *) dsfmt_data;
+    // The jump computes the next blocks from the state
+    if (block_interval != PRNG_Close1_Open2)
+        Restore_Block();
+
+    const uint64_t position = uint64_t(dsfmt->idx) + n;
+    dsfmt_jump(dsfmt, position / uint64_t(DSFMT_N64));
+    dsfmt->idx = int(position % uint64_t(DSFMT_N64));
+    nb_calls  += n;
+#else  // #ifdef RAND_DSFMT
+    for (uint64_t i = 0 ; i < n ; i++)
+        Get_Random_Close1_Open2();
+#endif // #ifdef RAND_DSFMT
+}
+
 // **************************************************************
 double PRNG::Get_Random_Close0_Open1()
 /**
@@ -182,6 +685,288 @@ double PRNG::Get_Random_CloseN1_Open1()
     return ((2.0 * Get_Random_Close1_Open2()) - 3.0);
 }
 
+// **************************************************************
+void PRNG::Fill_Array(double *array, const uint64_t n, const int interval)
+/**
+ * Fill "array" with "n" pseudo-random numbers in the requested interval
+ * (one of PRNG_Intervals).
+ * The numbers are exactly the ones "n" consecutive calls to the
+ * corresponding Get_Random_*() function would return; the sequence
+ * can be continued one number at a time afterwards.
+ *
+ * dSFMT's bulk generation (SIMD when HAVE_SSE2 is defined) writes
+ * directly into "array"; it needs at least DSFMT_N64 numbers starting
+ * on a block boundary and, with SSE2, a 16 bytes aligned pointer.
+ * What is left in the current block is first copied, and numbers that
+ * can't be generated in bulk are generated one at a time.
+ */
+{
+    assert(is_initialized == PRNG_is_initialized);
+
+    PRNG_STATS_START_TIMER(start);
+    const uint64_t nb_calls_before = nb_calls;
+    uint64_t i = 0;
+#ifdef RAND_DSFMT
+    assert(dsfmt_data != NULL);
+    dsfmt_t *dsfmt = (dsfmt_t *) dsfmt_data;
+    // Bulk generation computes the next blocks from the state
+    if (block_interval != PRNG_Close1_Open2)
+        Restore_Block();
+
+    // Numbers already generated in the current block
+    const double *psfmt64 = &dsfmt->status[0].d[0];
+    while (i < n && dsfmt->idx < DSFMT_N64)
+    {
+        array[i++] = Convert_From_Close1_Open2(psfmt64[dsfmt->idx++], interval);
+    }
+
+    // Bulk generation. dSFMT takes an "int" size, so split huge arrays.
+    const uint64_t max_chunk = uint64_t(1) << 30;
+    while (n - i >= uint64_t(DSFMT_N64)
+#ifdef HAVE_SSE2
+           && (uintptr_t(&array[i]) % 16) == 0
+#endif // #ifdef HAVE_SSE2
+          )
+    {
+        // Even number of doubles, but keep at least DSFMT_N64 for the next chunk
+        uint64_t chunk = n - i;
+        if (chunk > max_chunk)
+            chunk = (chunk - max_chunk < uint64_t(DSFMT_N64) ? chunk - uint64_t(DSFMT_N64) : max_chunk);
+        chunk -= chunk % 2;
+
+        double *chunk_array = &array[i];
+        switch (interval)
+        {
+            case PRNG_Close0_Open1:
+                dsfmt_fill_array_close_open(dsfmt, chunk_array, int(chunk));
+                break;
+            case PRNG_Open0_Close1:
+                dsfmt_fill_array_open_close(dsfmt, chunk_array, int(chunk));
+                break;
+            case PRNG_Open0_Open1:
+                dsfmt_fill_array_open_open(dsfmt, chunk_array, int(chunk));
+                break;
+            case PRNG_CloseN1_Open1:
+                dsfmt_fill_array_close1_open2(dsfmt, chunk_array, int(chunk));
+                for (uint64_t j = 0 ; j < chunk ; j++)
+                    chunk_array[j] = (2.0 * chunk_array[j]) - 3.0;
+                break;
+            default:
+                dsfmt_fill_array_close1_open2(dsfmt, chunk_array, int(chunk));
+                break;
+        }
+        i += chunk;
+        PRNG_STATS_ADD(fill_blocks, chunk / uint64_t(DSFMT_N64));
+    }
+#endif // #ifdef RAND_DSFMT
+
+    // Remaining numbers, one at a time
+    for ( ; i < n ; i++)
+    {
+        array[i] = Convert_From_Close1_Open2(Get_Random_Close1_Open2(), interval);
+    }
+    nb_calls = nb_calls_before + n;
+
+    PRNG_STATS_ADD(nb_fills, 1);
+    PRNG_STATS_ADD(fill_values, n);
+    PRNG_STATS_STOP_TIMER(fill_cycles, start);
+}
+
+// **************************************************************
+void PRNG::Parallel_Fill(double *array, const uint64_t n, const int nb_threads, const int interval)
+/**
+ * Fill "array" with "n" pseudo-random numbers in the requested interval
+ * (one of PRNG_Intervals), using "nb_threads" threads. The numbers, and
+ * the generator's state afterwards, are exactly the ones Fill_Array()
+ * gives, whatever the number of threads.
+ *
+ * The rest of the current block is filled first. The remaining whole
+ * blocks are split in one chunk per thread; each chunk gets its own
+ * generator, positioned at the chunk's start by jumping the previous
+ * chunk's generator ahead (see Jump()), and is filled concurrently.
+ *
+ * @param   array       Array to fill
+ * @param   n           Number of numbers
+ * @param   nb_threads  Number of threads (including the calling one)
+ * @param   interval    Interval of the numbers [default: ]0,1] as Get_Random()]
+ */
+{
+    assert(is_initialized == PRNG_is_initialized);
+    assert(nb_threads >= 1);
+#ifdef RAND_DSFMT
+    assert(dsfmt_data != NULL);
+    dsfmt_t *dsfmt = (dsfmt_t *) dsfmt_data;
+    const uint64_t nb_calls_before = nb_calls;
+
+    // Rest of the current block: the chunks start on block boundaries
+    const uint64_t head = std::min(n, uint64_t(DSFMT_N64 - dsfmt->idx));
+    Fill_Array(array, head, interval);
+
+    const uint64_t rest         = n - head;
+    const uint64_t rest_blocks  = (rest + uint64_t(DSFMT_N64) - 1) / uint64_t(DSFMT_N64);
+    if (nb_threads == 1 || rest_blocks < 2)
+    {
+        Fill_Array(&array[head], rest, interval);
+        return;
+    }
+    const uint64_t chunk_blocks = (rest_blocks + uint64_t(nb_threads) - 1) / uint64_t(nb_threads);
+    const uint64_t chunk_size   = chunk_blocks * uint64_t(DSFMT_N64);
+    const int      nb_chunks    = int((rest_blocks + chunk_blocks - 1) / chunk_blocks);
+
+    // Generators at the start of each chunk, one jump after the other
+    dsfmt_poly_t jump;
+    Parallel_Fill_Jump(jump, chunk_blocks);
+    PRNG *chunk_prngs = new PRNG[nb_chunks];
+    std::vector<Parallel_Fill_Chunk> chunks(nb_chunks);
+    for (int c = 0 ; c < nb_chunks ; c++)
+    {
+        chunk_prngs[c].Initialize_Copy(c == 0 ? *this : chunk_prngs[c-1]);
+        if (c > 0)
+            dsfmt_jump_by((dsfmt_t *) chunk_prngs[c].dsfmt_data, jump);
+
+        chunks[c].prng      = &chunk_prngs[c];
+        chunks[c].array     = &array[head + uint64_t(c) * chunk_size];
+        chunks[c].n         = std::min(chunk_size, rest - uint64_t(c) * chunk_size);
+        chunks[c].interval  = interval;
+    }
+
+    // The calling thread fills the first chunk
+    std::vector<pthread_t> threads(nb_chunks);
+    for (int c = 1 ; c < nb_chunks ; c++)
+    {
+        if (pthread_create(&threads[c], NULL, Parallel_Fill_Worker, &chunks[c]) != 0)
+        {
+            std_cout << "PRNG::Parallel_Fill(): Couldn't start a thread. Aborting.\n" << std::flush;
+            abort();
+        }
+    }
+    Parallel_Fill_Worker(&chunks[0]);
+    for (int c = 1 ; c < nb_chunks ; c++)
+        pthread_join(threads[c], NULL);
+
+    // Continue where the last chunk ended
+    memcpy(dsfmt, chunk_prngs[nb_chunks-1].dsfmt_data, sizeof(dsfmt_t));
+    nb_calls = nb_calls_before + n;
+    delete[] chunk_prngs;
+#else  // #ifdef RAND_DSFMT
+    Fill_Array(array, n, interval);
+#endif // #ifdef RAND_DSFMT
+}
+
+// **************************************************************
+void PRNG::Fill_Array_Random(double *array, const uint64_t n)
+/**
+ * Fill "array" with "n" pseudo-random numbers in the interval ]0,1]
+ * (excluding 0, including 1), the same as "n" calls to Get_Random().
+ */
+{
+    Fill_Array(array, n, PRNG_Open0_Close1);
+}
+
+// **************************************************************
+void PRNG::Fill_Array_Close1_Open2(double *array, const uint64_t n)
+/**
+ * Fill "array" with "n" pseudo-random numbers in the interval [1,2[
+ * (including 1, excluding 2).
+ */
+{
+    Fill_Array(array, n, PRNG_Close1_Open2);
+}
+
+// **************************************************************
+void PRNG::Fill_Array_Close0_Open1(double *array, const uint64_t n)
+/**
+ * Fill "array" with "n" pseudo-random numbers in the interval [0,1[
+ * (including 0, excluding 1).
+ */
+{
+    Fill_Array(array, n, PRNG_Close0_Open1);
+}
+
+// **************************************************************
+void PRNG::Fill_Array_Open0_Close1(double *array, const uint64_t n)
+/**
+ * Fill "array" with "n" pseudo-random numbers in the interval ]0,1]
+ * (excluding 0, including 1).
+ */
+{
+    Fill_Array(array, n, PRNG_Open0_Close1);
+}
+
+// **************************************************************
+void PRNG::Fill_Array_Open0_Open1(double *array, const uint64_t n)
+/**
+ * Fill "array" with "n" pseudo-random numbers in the interval ]0,1[
+ * (excluding 0, excluding 1). There is no one at a time equivalent;
+ * the numbers are the ones of Get_Random_Close1_Open2() with their
+ * lowest bit set.
+ */
+{
+    Fill_Array(array, n, PRNG_Open0_Open1);
+}
+
+// **************************************************************
+void PRNG::Fill_Array_CloseN1_Open1(double *array, const uint64_t n)
+/**
+ * Fill "array" with "n" pseudo-random numbers in the interval [-1,1[
+ * (including -1, excluding 1).
+ */
+{
+    Fill_Array(array, n, PRNG_CloseN1_Open1);
+}
+
+// **************************************************************
+void PRNG::Fill_Array_Uint64(uint64_t *array, const uint64_t n)
+/**
+ * Fill "array" with "n" uniformly distributed 64 bits integers.
+ * The 52 random mantissa bits of numbers in [1,2[ are concatenated:
+ * each group of 16 numbers gives 13 integers. A partially used group
+ * is discarded, so 16*ceil(n/13) numbers are consumed. Integer k of a
+ * group starts at bit 64k mod 52 of mantissa 64k/52: with the loop
+ * unrolled these are constants, and the packing has no branches.
+ */
+{
+    const uint64_t nb_per_group   = 13;
+    const uint64_t draws_per_group = 16;
+    const uint64_t groups_per_pass = 256;
+    const uint64_t mantissa_mask  = (uint64_t(1) << 52) - 1;
+
+    double storage[groups_per_pass * draws_per_group + 7];
+    double *draws = Align_64(storage);
+
+    uint64_t i = 0;
+    while (i < n)
+    {
+        const uint64_t nb_groups = std::min((n - i + nb_per_group - 1) / nb_per_group, groups_per_pass);
+        Fill_Array_Close1_Open2(draws, nb_groups * draws_per_group);
+
+        for (uint64_t g = 0 ; g < nb_groups ; g++)
+        {
+            uint64_t mantissas[draws_per_group];
+            memcpy(mantissas, &draws[g * draws_per_group], sizeof(mantissas));
+            for (uint64_t d = 0 ; d < draws_per_group ; d++)
+                mantissas[d] &= mantissa_mask;
+
+            // The last group of the call can be partially used
+            uint64_t packed[nb_per_group];
+            uint64_t *words = (n - i >= nb_per_group ? &array[i] : packed);
+            for (uint64_t k = 0 ; k < nb_per_group ; k++)
+            {
+                const uint64_t first = (64 * k) / 52;
+                const uint64_t shift = (64 * k) % 52;
+                uint64_t word = (mantissas[first] >> shift) | (mantissas[first + 1] << (52 - shift));
+                // A third mantissa when the first two give less than 64 bits
+                if (shift > 40)
+                    word |= mantissas[first + 2] << (104 - shift);
+                words[k] = word;
+            }
+            if (words == packed)
+                memcpy(&array[i], packed, size_t(n - i) * sizeof(uint64_t));
+            i += std::min(nb_per_group, n - i);
+        }
+    }
+}
+
 // **************************************************************
 double PRNG::Get_Random_Close0_Close1()
 /**
@@ -192,8 +977,10 @@ double PRNG::Get_Random_Close0_Close1()
     // Get a random number in [1,2[ but only keep it if it's
     // less or equal then 1, giving [0,1]
     double r;
+    PRNG_STATS_ADD(close0_close1_calls, 1);
     do {
         r = 2.0*Get_Random_Close0_Open1();
+        PRNG_STATS_ADD(close0_close1_rejections, r > 1.0);
     } while (r > 1.0);
     return r;
 }
@@ -224,6 +1011,9 @@ void PRNG::Get_Random_Direction(double xyz[3])
  */
 {
     double y1, y2, r2;
+    PRNG_STATS_START_TIMER(start);
+    PRNG_STATS_ADD(direction_calls, 1);
+    PRNG_STATS_ADD(direction_uniforms, -nb_calls);
 
     do
     {
@@ -231,12 +1021,16 @@ void PRNG::Get_Random_Direction(double xyz[3])
         y1 = Get_Random_CloseN1_Close1();
         y2 = Get_Random_CloseN1_Close1();
         r2 = y1*y1 + y2*y2;
+        PRNG_STATS_ADD(direction_rejections, r2 >= 1.0);
     } while (r2 >= 1.0);
 
     xyz[0] = 2.0 * y1 * std::sqrt(1.0 - r2);
     xyz[1] = 2.0 * y2 * std::sqrt(1.0 - r2);
     xyz[2] = 1.0 - 2.0*r2;
 
+    PRNG_STATS_ADD(direction_uniforms, nb_calls);
+    PRNG_STATS_STOP_TIMER(direction_cycles, start);
+
 #ifdef YDEBUG
     const double r = std::sqrt(xyz[0]*xyz[0] + xyz[1]*xyz[1] + xyz[2]*xyz[2]);
     assert(0.9999 < r && r < 1.0001);
@@ -278,9 +1072,13 @@ double PRNG::Get_Random_Box_Muller_Polar(const double mean, const double std_dev
     static bool available = false;
     static double gset;
     double fac, r2, v1, v2;
+    PRNG_STATS_ADD(box_muller_calls, 1);
 
     if (!available)
     {
+        PRNG_STATS_START_TIMER(start);
+        PRNG_STATS_ADD(box_muller_uniforms, -nb_calls);
+
         // If we don’t have an extra deviate handy
         // and while v1 and v2 are not in the unit circle.
         do
@@ -290,9 +1088,15 @@ double PRNG::Get_Random_Box_Muller_Polar(const double mean, const double std_dev
             v1 = Get_Random_CloseN1_Close1();
             v2 = Get_Random_CloseN1_Close1();
             r2 = v1*v1 + v2*v2;
+            PRNG_STATS_ADD(box_muller_rejections, r2 >= 1.0 || r2 <= DBL_EPSILON);
         } while (r2 >= 1.0 || r2 <= DBL_EPSILON);
 
+#ifdef PRNG_STRICT_FP
+        // libm's log() can differ between instruction sets
+        fac = sqrt(-2.0 * prng::Log(r2) / r2);
+#else
         fac = sqrt(-2.0 * log(r2) / r2);
+#endif // #ifdef PRNG_STRICT_FP
         // Now make the Box-Muller transformation to get two normal
         // deviates. Return one and save the other for next time.
         gset = mean + v1*fac * std_dev;
@@ -300,6 +1104,9 @@ double PRNG::Get_Random_Box_Muller_Polar(const double mean, const double std_dev
         // Set flag.
         available = true;
 
+        PRNG_STATS_ADD(box_muller_uniforms, nb_calls);
+        PRNG_STATS_STOP_TIMER(box_muller_cycles, start);
+
         return (mean + v2*fac * std_dev);
     }
     else
@@ -310,6 +1117,47 @@ double PRNG::Get_Random_Box_Muller_Polar(const double mean, const double std_dev
     }
 }
 
+// **************************************************************
+void PRNG::Fill_Array_Normal(double *array, const uint64_t n, const double mean, const double std_dev)
+/**
+ * Fill "array" with "n" normally distributed numbers, in bulk: basic
+ * Box-Muller (no rejection) computed with Vector_Math.hpp's kernels,
+ * so the numbers are the same on every ISA and with any libm. For each
+ * chunk of pairs, the u1 in ]0,1] of all the pairs are drawn, then
+ * their u2 in [0,1[. With an odd "n", the last pair's second number
+ * is dropped. This is not Get_Random_Box_Muller_Polar()'s sequence.
+ *
+ * @param   array       Array to fill
+ * @param   n           Number of numbers
+ * @param   mean        Expectation value of the distribution [default: 0.0]
+ * @param   std_dev     Standard deviation of the distribution [default: 1.0]
+ */
+{
+    const uint64_t pairs_per_chunk = 512;
+
+    double storage[2 * pairs_per_chunk + 7];
+    double *u1 = Align_64(storage);
+    double *u2 = &u1[pairs_per_chunk];
+
+    uint64_t i = 0;
+    while (i < n)
+    {
+        const uint64_t nb_pairs = std::min(pairs_per_chunk, (n - i + 1) / 2);
+        Fill_Array(u1, nb_pairs, PRNG_Open0_Close1);
+        Fill_Array(u2, nb_pairs, PRNG_Close0_Open1);
+        if (i + 2 * nb_pairs <= n)
+            prng::Box_Muller_Array(u1, u2, mean, std_dev, &array[i], nb_pairs);
+        else
+        {
+            double last_pair[2];
+            prng::Box_Muller_Array(u1, u2, mean, std_dev, &array[i], nb_pairs - 1);
+            prng::Box_Muller(u1[nb_pairs - 1], u2[nb_pairs - 1], mean, std_dev, last_pair[0], last_pair[1]);
+            array[n - 1] = last_pair[0];
+        }
+        i += 2 * nb_pairs;
+    }
+}
+
 // **************************************************************
 double PRNG::Call_N_Time_Get_Random(const int n)
 {
@@ -322,4 +1170,146 @@ double PRNG::Call_N_Time_Get_Random(const int n)
     return last_rand;
 }
 
+// **************************************************************
+int PRNG::Get_Mersenne_Exponent()
+/**
+ * Return the Mersenne exponent the library was compiled with
+ * (DSFMT_MEXP), or 0 when using rand().
+ */
+{
+#ifdef RAND_DSFMT
+    return DSFMT_MEXP;
+#else  // #ifdef RAND_DSFMT
+    return 0;
+#endif // #ifdef RAND_DSFMT
+}
+
+// **************************************************************
+const char *PRNG::Get_Id_String()
+/**
+ * Return a string identifying the generator and its parameters.
+ */
+{
+#ifdef RAND_DSFMT
+    return dsfmt_get_idstring();
+#else  // #ifdef RAND_DSFMT
+    return "rand()";
+#endif // #ifdef RAND_DSFMT
+}
+
+// **************************************************************
+void PRNG::Merge_Stats()
+/**
+ * Add this PRNG's counters to the totals (see prng::Get_Stats()) and
+ * reset them. Thread safe; called by the destructor, so only long lived
+ * generators need to call it before logging.
+ */
+{
+#ifdef PRNG_STATS
+    uint64_t *local  = (uint64_t *) &stats;
+    uint64_t *totals = (uint64_t *) &global_stats;
+    for (uint64_t i = 0 ; i < sizeof(PRNG_Stats) / sizeof(uint64_t) ; i++)
+    {
+        __sync_fetch_and_add(&totals[i], local[i]);
+    }
+#endif // #ifdef PRNG_STATS
+    memset(&stats, 0, sizeof(stats));
+}
+
+// **************************************************************
+PRNG_Stats prng::Get_Stats()
+{
+    __sync_synchronize();
+    return global_stats;
+}
+
+// **************************************************************
+void prng::Reset_Stats()
+{
+    memset(&global_stats, 0, sizeof(global_stats));
+    __sync_synchronize();
+}
+
+#ifdef PRNG_STATS
+// **************************************************************
+static double Ratio(const uint64_t numerator, const uint64_t denominator)
+{
+    return (denominator == 0 ? 0.0 : double(numerator) / double(denominator));
+}
+#endif // #ifdef PRNG_STATS
+
+// **************************************************************
+void prng::Log_Stats(std::string basename)
+/**
+ * Print the totals of the instrumentation counters, as the number of
+ * events and the averages per call.
+ *
+ * @param   basename    Folder where to save "prng_stats.log" [default: "", not saved]
+ */
+{
+    std::ostringstream log;
+    log << "##############################################################\n"
+        << "# PRNG statistics:\n";
+#ifdef PRNG_STATS
+    const PRNG_Stats totals = Get_Stats();
+    log << "#    Refills:            " << totals.nb_refills
+            << " (" << Ratio(totals.refill_cycles, totals.nb_refills) << " cycles/refill)\n"
+        << "#    Fill_Array():       " << totals.nb_fills << " calls, " << totals.fill_values << " numbers, "
+            << totals.fill_blocks << " bulk blocks (" << Ratio(totals.fill_cycles, totals.fill_values) << " cycles/number)\n"
+        << "#    Close0_Close1():    " << totals.close0_close1_calls << " calls, "
+            << Ratio(totals.close0_close1_rejections, totals.close0_close1_calls) << " rejections/call\n"
+        << "#    Direction():        " << totals.direction_calls << " calls, "
+            << Ratio(totals.direction_rejections, totals.direction_calls) << " rejections/call, "
+            << Ratio(totals.direction_uniforms, totals.direction_calls) << " uniforms/call ("
+            << Ratio(totals.direction_cycles, totals.direction_calls) << " cycles/call)\n"
+        << "#    Box_Muller_Polar(): " << totals.box_muller_calls << " calls, "
+            << Ratio(totals.box_muller_rejections, totals.box_muller_calls) << " rejections/call, "
+            << Ratio(totals.box_muller_uniforms, totals.box_muller_calls) << " uniforms/call ("
+            << Ratio(totals.box_muller_cycles, totals.box_muller_calls) << " cycles/call)\n";
+#else  // #ifdef PRNG_STATS
+    log << "#    Not available, recompile with -DPRNG_STATS (\"make stats\")\n";
+#endif // #ifdef PRNG_STATS
+    log << "##############################################################\n";
+
+    std_cout << log.str() << "\n";
+
+    if (basename != "")
+    {
+        std::string filename = basename + "/prng_stats.log";
+        std::ofstream stats_file;
+        stats_file.open(filename.c_str());
+        stats_file << log.str() << "\n";
+        stats_file.close();
+    }
+}
+
+// **************************************************************
+uint64_t prng::Digest(const double *values, const uint64_t n, uint64_t digest)
+/**
+ * FNV-1a like digest, but consuming a whole 64 bits word at each step
+ * followed by a xorshift. Each step is a bijection on the digest, so
+ * a difference is never lost by later values.
+ *
+ * @param   values      Array of doubles to digest
+ * @param   n           Number of doubles in "values"
+ * @param   digest      Digest of the previous values [default: 0]
+ */
+{
+    // FNV 64 bits prime: 2^40 + 2^8 + 0xb3
+    const uint64_t fnv_prime = (uint64_t(1) << 40) + uint64_t(0x1b3);
+    union {
+        double   d;
+        uint64_t u;
+    } bits;
+
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        bits.d  = values[i];
+        digest ^= bits.u;
+        digest *= fnv_prime;
+        digest ^= digest >> 29;
+    }
+    return digest;
+}
+
 // ********** End of file ***************************************
@@ -4,28 +4,105 @@
 #include <stdint.h> // (u)int64_t
 #include <cstdlib> // free()
 #include <vector>
+#include <string>
+
+#include "Seed_Sequence.hpp"
 
 namespace prng
 {
     // See Git_Info.cpp (generated dynamically from Git_Info.cpp_template & Makefile.rules)
     void Log_Git_Info(std::string basename = "");
+
+    // Rolling 64-bit digest over the exact bit patterns of "n" doubles.
+    // Chain calls by passing the previous digest; any single bit
+    // (single ulp) difference changes the result.
+    uint64_t Digest(const double *values, const uint64_t n, uint64_t digest = 0);
+}
+
+// **************************************************************
+// Hot path instrumentation counters. They are only updated when the
+// library is compiled with -DPRNG_STATS ("make stats"); otherwise the
+// counting code is not compiled at all. The structure is always part
+// of PRNG so the class layout does not depend on the flag.
+// Cycles are read with rdtsc on x86, nanoseconds elsewhere.
+struct PRNG_Stats
+{
+    uint64_t nb_refills;                // dSFMT block regenerations (one at a time path)
+    uint64_t refill_cycles;
+    uint64_t nb_fills;                  // Fill_Array() calls
+    uint64_t fill_values;               // Numbers returned by Fill_Array()
+    uint64_t fill_blocks;               // dSFMT blocks generated in bulk by Fill_Array()
+    uint64_t fill_cycles;
+    uint64_t close0_close1_calls;       // Get_Random_Close0_Close1()
+    uint64_t close0_close1_rejections;
+    uint64_t direction_calls;           // Get_Random_Direction()
+    uint64_t direction_rejections;
+    uint64_t direction_uniforms;
+    uint64_t direction_cycles;
+    uint64_t box_muller_calls;          // Get_Random_Box_Muller_Polar()
+    uint64_t box_muller_rejections;
+    uint64_t box_muller_uniforms;
+    uint64_t box_muller_cycles;
+};
+
+namespace prng
+{
+    // Totals of all PRNGs' counters (see PRNG::Merge_Stats()). Empty
+    // when compiled without -DPRNG_STATS.
+    PRNG_Stats Get_Stats();
+    void Reset_Stats();
+    // Print the totals and, if "basename" is given, save them to
+    // "basename/prng_stats.log" (next to Log_Git_Info()'s files).
+    void Log_Stats(std::string basename = "");
 }
 
+// Intervals for bulk filling
+enum PRNG_Intervals
+{
+    PRNG_Close1_Open2,  // [1,2[
+    PRNG_Close0_Open1,  // [0,1[
+    PRNG_Open0_Close1,  // ]0,1]
+    PRNG_Open0_Open1,   // ]0,1[
+    PRNG_CloseN1_Open1  // [-1,1[
+};
+
 // **************************************************************
 // Pseudo-Random Number Generator's (PRNG)
 class PRNG
 {
     int is_initialized;
-    int nb_calls;
+    uint64_t nb_calls;
 
     void *dsfmt_data;
     uint32_t seed;
 
+    PRNG_Stats stats;
+
+    // Part of the dSFMT block converted in place by Next_Block(), restored
+    // before the block is regenerated. Open0_Open1 loses the lowest bits.
+    int block_interval;
+    int block_begin;
+    std::vector<uint64_t> block_low_bits;
+
+    void        Refill_Block();
+    void        Restore_Block();
+    void        Initialize_Copy(const PRNG &source);
+    void        Allocate_State();
+
     public:
                      PRNG();
+                     PRNG(const PRNG &source);
                     ~PRNG();
+        PRNG       &operator=(const PRNG &source);
         void        Initialize_Taking_Time_As_Seed(const bool quiet = false);
         void        Initialize(const uint32_t seed, const bool quiet = false);
+        void        Initialize_Rank(const uint32_t master_seed, const int rank, const int nb_ranks,
+                                    const bool quiet = false);
+        void        Initialize(const Seed_Sequence &seed_sequence, const uint64_t stream = 0,
+                               const bool quiet = false);
+        void        Initialize_By_Array(const uint32_t *key, const int length, const bool quiet = false);
+        static void Initialize_Array(PRNG *prngs, const uint64_t n, const Seed_Sequence &seed_sequence,
+                                     const uint64_t first_stream = 0);
         double      Get_Random();                   // Returns ]0,1]
         double      Get_Random_Close1_Open2();      // [1,2[ Most fundamental, others are based on it
         double      Get_Random_Close0_Open1();      // [0,1[
@@ -33,15 +110,56 @@ class PRNG
         double      Get_Random_CloseN1_Open1();     // [-1,1[
         double      Get_Random_Close0_Close1();     // [0,1]
         double      Get_Random_CloseN1_Close1();    // [-1,1]
+        // Bulk versions: same sequence as calling the above n times
+        void        Fill_Array(double *array, const uint64_t n, const int interval);
+        void        Fill_Array_Random(double *array, const uint64_t n);         // ]0,1]
+        void        Fill_Array_Close1_Open2(double *array, const uint64_t n);   // [1,2[
+        void        Fill_Array_Close0_Open1(double *array, const uint64_t n);   // [0,1[
+        void        Fill_Array_Open0_Close1(double *array, const uint64_t n);   // ]0,1]
+        void        Fill_Array_Open0_Open1(double *array, const uint64_t n);    // ]0,1[
+        void        Fill_Array_CloseN1_Open1(double *array, const uint64_t n);  // [-1,1[
+        void        Fill_Array_Uint64(uint64_t *array, const uint64_t n);       // [0,2^64[
+        // Same as Fill_Array(), split across threads: identical numbers
+        void        Parallel_Fill(double *array, const uint64_t n, const int nb_threads,
+                                  const int interval = PRNG_Open0_Close1);
+        // Skip "n" numbers without generating them (jump-ahead)
+        void        Jump(const uint64_t n);
+        // Zero-copy: numbers still in the generator's block (or a new block),
+        // valid until the next call to this PRNG
+        const double *Next_Block(uint64_t &size, const int interval = PRNG_Close1_Open2);
+        template <class Function>
+        uint64_t    Consume_Block(Function &function, const int interval = PRNG_Close1_Open2);
         void        Get_Random_Direction(double xyz[3]);
         std::vector<double> Get_Random_Direction();
         double      gasdev();
         double      Get_Random_Box_Muller_Polar(const double mean = 0.0, const double std_dev = 1.0);
+        // Bulk normal numbers (Box-Muller with Vector_Math.hpp's kernels)
+        void        Fill_Array_Normal(double *array, const uint64_t n, const double mean = 0.0,
+                                      const double std_dev = 1.0);
         double      Call_N_Time_Get_Random(const int n);
         uint32_t    Get_Seed()      { return seed;     }
-        int         Get_Nb_Calls()  { return nb_calls; }
+        uint64_t    Get_Nb_Calls()  { return nb_calls; }
+        int         Get_Mersenne_Exponent();
+        const char *Get_Id_String();
+        const PRNG_Stats &Get_Stats()   { return stats; }
+        void        Merge_Stats();
 };
 
+// **************************************************************
+template <class Function>
+uint64_t PRNG::Consume_Block(Function &function, const int interval)
+/**
+ * Call "function(const double *block, uint64_t size)" on the next block
+ * of numbers (see Next_Block()), read in place from the generator's
+ * state. Return the block's size.
+ */
+{
+    uint64_t size;
+    const double *block = Next_Block(size, interval);
+    function(block, size);
+    return size;
+}
+
 #endif // INC_PRNG_hpp
 
 // ********** End of file ***************************************
@@ -0,0 +1,423 @@
+
+#include <iostream>
+#include <cstdlib>
+#include <cassert>
+
+#include <StdCout.hpp>
+
+#include "QRNG.hpp"
+#include "Sobol_Direction_Numbers.hpp"
+
+const int Sobol::max_dimension = sobol_max_dimension;
+
+// Coordinates are fixed point numbers of 52 bits: k / 2^52
+const uint64_t fixed_point_one  = uint64_t(1) << 52;
+const double   fixed_point_unit = 1.0 / 4503599627370496.0; // 2^-52
+
+// **************************************************************
+static inline double Convert_Fixed_Point(const uint64_t k, const int interval)
+/**
+ * Convert k / 2^52 in [0,1[ to the requested interval (one of
+ * PRNG_Intervals), the way PRNG converts from [1,2[. All steps are
+ * exact.
+ */
+{
+    const double r = 1.0 + double(k) * fixed_point_unit; // [1,2[
+    switch (interval)
+    {
+        case PRNG_Close0_Open1:
+            return r - 1.0;
+        case PRNG_Open0_Close1:
+            return 2.0 - r;
+        case PRNG_Open0_Open1:
+            // As PRNG: set the lowest mantissa bit so 0 can't be reached
+            return double(k | 1) * fixed_point_unit;
+        case PRNG_CloseN1_Open1:
+            return (2.0 * r) - 3.0;
+        default:
+            return r;
+    }
+}
+
+// **************************************************************
+static inline int Trailing_Zeros(const uint64_t x)
+{
+    return __builtin_ctzll(x);
+}
+
+// **************************************************************
+static inline uint32_t Reverse_Bits(uint32_t x)
+{
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+    x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+// **************************************************************
+static inline uint32_t Owen_Scramble(const uint32_t x, const uint32_t seed)
+/**
+ * Nested uniform scrambling of a 32 bits fraction: each bit is flipped
+ * or not depending only on the bits above it, through Laine and
+ * Karras' permutation applied to the reversed bits (constants from
+ * Burley 2020).
+ */
+{
+    uint32_t v = Reverse_Bits(x);
+    v += seed;
+    v ^= v * 0x6c50b47cu;
+    v ^= v * 0xb82f1e52u;
+    v ^= v * 0xc7afe638u;
+    v ^= v * 0x8d22f6e6u;
+    return Reverse_Bits(v);
+}
+
+// **************************************************************
+static inline uint32_t Random_Uint32(PRNG &prng)
+{
+    return uint32_t(prng.Get_Random_Close0_Open1() * 4294967296.0);
+}
+
+// **************************************************************
+QRNG::QRNG(const int new_dimension)
+{
+    assert(new_dimension >= 1);
+    dimension   = new_dimension;
+    index       = 0;
+}
+
+
+// **************************************************************
+Sobol::Sobol(const int new_dimension)
+    : QRNG(new_dimension)
+/**
+ * @param   new_dimension   Number of coordinates, up to Sobol::max_dimension
+ */
+{
+    if (dimension > max_dimension)
+    {
+        std_cout << "Sobol: Dimension " << dimension << " larger than " << max_dimension << ". Aborting.\n" << std::flush;
+        abort();
+    }
+
+    // Direction numbers v_j = m_j / 2^j, with m_j given up to the
+    // polynomial's degree s and the recurrence of Bratley and Fox after
+    // (see Joe and Kuo's notes).
+    directions.assign(dimension * 32, 0);
+    for (int j = 0 ; j < 32 ; j++)
+        directions[j] = uint32_t(1) << (31 - j); // van der Corput
+    for (int d = 1 ; d < dimension ; d++)
+    {
+        uint32_t *v = &directions[d * 32];
+        const uint32_t polynomial = sobol_polynomials[d];
+        int s = 0;
+        while ((polynomial >> (s + 1)) != 0)
+            s++;
+        const uint32_t a = (polynomial >> 1) & ((uint32_t(1) << (s - 1)) - 1);
+
+        for (int j = 0 ; j < s && j < 32 ; j++)
+            v[j] = uint32_t(sobol_initial_numbers[d][j]) << (31 - j);
+        for (int j = s ; j < 32 ; j++)
+        {
+            v[j] = v[j-s] ^ (v[j-s] >> s);
+            for (int k = 1 ; k < s ; k++)
+            {
+                if ((a >> (s - 1 - k)) & 1)
+                    v[j] ^= v[j-k];
+            }
+        }
+    }
+
+    current.assign(dimension, 0);
+}
+
+// **************************************************************
+void Sobol::Set_Index(const uint64_t new_index)
+/**
+ * Move to point "new_index": the XOR of the direction numbers of the
+ * bits of its Gray code, 32 operations per coordinate at most.
+ */
+{
+    if (new_index > (uint64_t(1) << 32))
+    {
+        std_cout << "Sobol: Index " << new_index << " past the 2^32 points of the sequence. Aborting.\n" << std::flush;
+        abort();
+    }
+
+    const uint32_t gray = uint32_t(new_index ^ (new_index >> 1));
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        uint32_t x = 0;
+        for (int j = 0 ; j < 32 ; j++)
+        {
+            if ((gray >> j) & 1)
+                x ^= directions[d*32 + j];
+        }
+        current[d] = x;
+    }
+    index = new_index;
+}
+
+// **************************************************************
+void Sobol::Check_Remaining(const uint64_t n) const
+{
+    if (n > (uint64_t(1) << 32) - index)
+    {
+        std_cout << "Sobol: Point " << index + n - 1 << " past the 2^32 points of the sequence. Aborting.\n" << std::flush;
+        abort();
+    }
+}
+
+// **************************************************************
+void Sobol::Next_Point(double *point, const int interval)
+/**
+ * Set "point" to the next point, in the requested interval (one of
+ * PRNG_Intervals).
+ */
+{
+    Check_Remaining(1);
+
+    // After the last point, the index is 2^32 and the state unused
+    const int j = Trailing_Zeros(index + 1) & 31;
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        const uint32_t x = (scramble_seeds.empty() ? current[d] : Owen_Scramble(current[d], scramble_seeds[d]));
+        point[d] = Convert_Fixed_Point(uint64_t(x) << 20, interval);
+        current[d] ^= directions[d*32 + j];
+    }
+    index++;
+}
+
+// **************************************************************
+void Sobol::Fill_Array(double *array, const uint64_t n, const int interval)
+/**
+ * Fill "array" with the next "n" points, one coordinate after the
+ * other: coordinate d of point i is array[d*n + i] (structure of
+ * arrays). Same points as "n" calls to Next_Point().
+ */
+{
+    Check_Remaining(n);
+
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        const uint32_t *v = &directions[d*32];
+        double *coordinates = &array[uint64_t(d) * n];
+        uint32_t x = current[d];
+        if (scramble_seeds.empty())
+        {
+            for (uint64_t i = 0 ; i < n ; i++)
+            {
+                coordinates[i] = Convert_Fixed_Point(uint64_t(x) << 20, interval);
+                x ^= v[Trailing_Zeros(index + i + 1) & 31];
+            }
+        }
+        else
+        {
+            const uint32_t seed = scramble_seeds[d];
+            for (uint64_t i = 0 ; i < n ; i++)
+            {
+                coordinates[i] = Convert_Fixed_Point(uint64_t(Owen_Scramble(x, seed)) << 20, interval);
+                x ^= v[Trailing_Zeros(index + i + 1) & 31];
+            }
+        }
+        current[d] = x;
+    }
+    index += n;
+}
+
+// **************************************************************
+void Sobol::Scramble(PRNG &prng)
+/**
+ * Owen scramble the sequence, with one random seed per dimension drawn
+ * from "prng". Scrambling again draws new seeds.
+ */
+{
+    scramble_seeds.resize(dimension);
+    for (int d = 0 ; d < dimension ; d++)
+        scramble_seeds[d] = Random_Uint32(prng);
+}
+
+
+// **************************************************************
+Halton::Halton(const int new_dimension)
+    : QRNG(new_dimension)
+/**
+ * @param   new_dimension   Number of coordinates; coordinate d uses the
+ *                          (d+1)-th prime as its base
+ */
+{
+    // First primes, by trial division
+    for (uint32_t candidate = 2 ; int(bases.size()) < dimension ; candidate++)
+    {
+        bool is_prime = true;
+        for (size_t i = 0 ; i < bases.size() && bases[i] * bases[i] <= candidate ; i++)
+        {
+            if (candidate % bases[i] == 0)
+            {
+                is_prime = false;
+                break;
+            }
+        }
+        if (is_prime)
+            bases.push_back(candidate);
+    }
+
+    // Number of digits K per base: b^K <= 2^53, so numerators and
+    // denominators are exact doubles.
+    const uint64_t limit = uint64_t(1) << 53;
+    max_digits = 0;
+    nb_digits.resize(dimension);
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        uint64_t power = 1;
+        nb_digits[d] = 0;
+        while (power <= limit / bases[d])
+        {
+            power *= bases[d];
+            nb_digits[d]++;
+        }
+        if (nb_digits[d] > max_digits)
+            max_digits = nb_digits[d];
+    }
+
+    weights.assign(dimension * max_digits, 0);
+    scales.resize(dimension);
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        uint64_t power = 1;
+        for (int k = nb_digits[d] - 1 ; k >= 0 ; k--)
+        {
+            weights[d*max_digits + k] = power;
+            power *= bases[d];
+        }
+        scales[d] = double(fixed_point_one) / double(power);
+    }
+
+    digits.assign(dimension * max_digits, 0);
+    numerators.assign(dimension, 0);
+    multipliers.assign(dimension * max_digits, 1);
+    shifts.assign(dimension * max_digits, 0);
+}
+
+// **************************************************************
+uint64_t Halton::Fixed_Point(const int d, const uint64_t numerator) const
+/**
+ * Return numerator / b^K as a 52 bits fixed point number.
+ */
+{
+    const uint64_t k = uint64_t(double(numerator) * scales[d]);
+    return (k < fixed_point_one ? k : fixed_point_one - 1);
+}
+
+// **************************************************************
+void Halton::Increment(const int d, uint64_t &numerator, uint32_t *index_digits) const
+/**
+ * Add one to the index's digits in base b, updating the numerator for
+ * the digits that change (unsigned arithmetic wraps back in range).
+ */
+{
+    const uint32_t base = bases[d];
+    for (int k = 0 ; k < nb_digits[d] ; k++)
+    {
+        const uint32_t old_digit = index_digits[k];
+        const uint32_t new_digit = (old_digit + 1 < base ? old_digit + 1 : 0);
+        index_digits[k] = new_digit;
+        numerator += (uint64_t(Scrambled_Digit(d, k, new_digit)) - uint64_t(Scrambled_Digit(d, k, old_digit)))
+                     * weights[d*max_digits + k];
+        if (new_digit != 0)
+            return;
+    }
+
+    std_cout << "Halton: Past the " << bases[d] << "^" << nb_digits[d] << " points of dimension " << d << ". Aborting.\n" << std::flush;
+    abort();
+}
+
+// **************************************************************
+void Halton::Set_Index(const uint64_t new_index)
+/**
+ * Move to point "new_index": decompose it in each base, O(K) per
+ * coordinate.
+ */
+{
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        uint64_t remainder = new_index;
+        uint64_t numerator = 0;
+        for (int k = 0 ; k < nb_digits[d] ; k++)
+        {
+            const uint32_t digit = uint32_t(remainder % bases[d]);
+            remainder /= bases[d];
+            digits[d*max_digits + k] = digit;
+            numerator += uint64_t(Scrambled_Digit(d, k, digit)) * weights[d*max_digits + k];
+        }
+        if (remainder != 0)
+        {
+            std_cout << "Halton: Index " << new_index << " past the " << bases[d] << "^" << nb_digits[d]
+                     << " points of dimension " << d << ". Aborting.\n" << std::flush;
+            abort();
+        }
+        numerators[d] = numerator;
+    }
+    index = new_index;
+}
+
+// **************************************************************
+void Halton::Next_Point(double *point, const int interval)
+/**
+ * Set "point" to the next point, in the requested interval (one of
+ * PRNG_Intervals).
+ */
+{
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        point[d] = Convert_Fixed_Point(Fixed_Point(d, numerators[d]), interval);
+        Increment(d, numerators[d], &digits[d*max_digits]);
+    }
+    index++;
+}
+
+// **************************************************************
+void Halton::Fill_Array(double *array, const uint64_t n, const int interval)
+/**
+ * Fill "array" with the next "n" points, one coordinate after the
+ * other: coordinate d of point i is array[d*n + i] (structure of
+ * arrays). Same points as "n" calls to Next_Point().
+ */
+{
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        double *coordinates = &array[uint64_t(d) * n];
+        uint64_t numerator = numerators[d];
+        uint32_t *index_digits = &digits[d*max_digits];
+        for (uint64_t i = 0 ; i < n ; i++)
+        {
+            coordinates[i] = Convert_Fixed_Point(Fixed_Point(d, numerator), interval);
+            Increment(d, numerator, index_digits);
+        }
+        numerators[d] = numerator;
+    }
+    index += n;
+}
+
+// **************************************************************
+void Halton::Scramble(PRNG &prng)
+/**
+ * Random linear digit scrambling, with multipliers and shifts drawn
+ * from "prng". Scrambling again draws new ones.
+ */
+{
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        const uint32_t base = bases[d];
+        for (int k = 0 ; k < nb_digits[d] ; k++)
+        {
+            const int i = d*max_digits + k;
+            multipliers[i]  = 1 + uint32_t(prng.Get_Random_Close0_Open1() * double(base - 1));
+            shifts[i]       = uint32_t(prng.Get_Random_Close0_Open1() * double(base));
+        }
+    }
+    Set_Index(index);
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,100 @@
+#ifndef INC_QRNG_hpp
+#define INC_QRNG_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <vector>
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Quasi-random number generators (QRNG): low-discrepancy sequences
+// whose successive points fill [0,1[^dimension evenly, for
+// quasi-Monte Carlo integration. Coordinates are returned in one of
+// PRNG_Intervals, as PRNG's Fill_Array(). Bulk fills are structures of
+// arrays: coordinate d of point i is array[d*n + i]. Any point can be
+// reached directly with Set_Index() or Skip(). Scramble() randomizes
+// the sequence (randomized QMC) with numbers from a PRNG, keeping its
+// uniformity properties.
+class QRNG
+{
+    protected:
+        int      dimension;
+        uint64_t index; // Of the next point
+
+    public:
+                     QRNG(const int new_dimension);
+        virtual     ~QRNG() {}
+        int         Get_Dimension() const   { return dimension; }
+        uint64_t    Get_Index() const       { return index;     }
+        void        Skip(const uint64_t n)  { Set_Index(index + n); }
+        virtual void Set_Index(const uint64_t new_index) = 0;
+        virtual void Next_Point(double *point, const int interval) = 0;
+        virtual void Fill_Array(double *array, const uint64_t n, const int interval) = 0;
+        virtual void Scramble(PRNG &prng) = 0;
+};
+
+// **************************************************************
+// Sobol sequence with Joe & Kuo's direction numbers ("new-joe-kuo-6",
+// up to Sobol::max_dimension dimensions), 32 bits per coordinate, so
+// at most 2^32 points. Points are generated in Gray code order: the
+// next point is the current one XOR a single direction number.
+// Scramble() applies a nested uniform (Owen) scrambling, implemented
+// with a hash based random permutation per dimension (Burley, "Practical
+// Hash-based Owen Scrambling", JCGT 2020).
+class Sobol : public QRNG
+{
+    std::vector<uint32_t> directions;       // [dimension][32]
+    std::vector<uint32_t> current;          // [dimension], point "index", unscrambled
+    std::vector<uint32_t> scramble_seeds;   // [dimension], empty if not scrambled
+
+    void        Check_Remaining(const uint64_t n) const;
+
+    public:
+        static const int max_dimension;
+
+                     Sobol(const int new_dimension);
+        void        Set_Index(const uint64_t new_index);
+        void        Next_Point(double *point, const int interval);
+        void        Fill_Array(double *array, const uint64_t n, const int interval);
+        void        Scramble(PRNG &prng);
+};
+
+// **************************************************************
+// Halton sequence: coordinate d is the radical inverse of the index in
+// base the d-th prime, with the index's digits kept up to date so the
+// next point costs O(1) per coordinate on average. 52 bits per
+// coordinate; base b gives at least b^K > 2^53 / b distinct points.
+// Scramble() applies a random linear digit scrambling (Matousek): digit
+// k in base b becomes (f_k digit + g_k) mod b, with random f_k != 0 and
+// g_k for each dimension and digit.
+class Halton : public QRNG
+{
+    std::vector<uint32_t> bases;            // [dimension]
+    std::vector<int>      nb_digits;        // [dimension], K
+    std::vector<uint64_t> weights;          // [dimension][max_digits], b^(K-1-k)
+    std::vector<uint32_t> digits;           // [dimension][max_digits], of the index, lowest first
+    std::vector<uint64_t> numerators;       // [dimension], point "index" is numerator / b^K
+    std::vector<double>   scales;           // [dimension], 2^52 / b^K
+    std::vector<uint32_t> multipliers;      // [dimension][max_digits], f_k, all 1 if not scrambled
+    std::vector<uint32_t> shifts;           // [dimension][max_digits], g_k, all 0 if not scrambled
+    int max_digits;
+
+    inline uint32_t Scrambled_Digit(const int d, const int k, const uint32_t digit) const
+    {
+        const int i = d*max_digits + k;
+        return uint32_t((uint64_t(multipliers[i]) * digit + shifts[i]) % bases[d]);
+    }
+    void        Increment(const int d, uint64_t &numerator, uint32_t *index_digits) const;
+    uint64_t    Fixed_Point(const int d, const uint64_t numerator) const;
+
+    public:
+                     Halton(const int new_dimension);
+        void        Set_Index(const uint64_t new_index);
+        void        Next_Point(double *point, const int interval);
+        void        Fill_Array(double *array, const uint64_t n, const int interval);
+        void        Scramble(PRNG &prng);
+};
+
+#endif // INC_QRNG_hpp
+
+// ********** End of file ***************************************
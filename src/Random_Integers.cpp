@@ -0,0 +1,88 @@
+
+#include <cassert>
+
+#include "Random_Integers.hpp"
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+// **************************************************************
+Random_Integers::Random_Integers(PRNG &new_prng)
+    : prng(new_prng)
+/**
+ * @param   new_prng    Generator to draw from; it must outlive this object
+ */
+{
+    size        = 0;
+    next        = 0;
+    refill_size = 16;
+    bits        = 0;
+    nb_bits     = 0;
+}
+
+// **************************************************************
+void Random_Integers::Refill()
+{
+    prng.Fill_Array_Close1_Open2(buffer, uint64_t(refill_size));
+    size = refill_size;
+    next = 0;
+    if (refill_size < capacity)
+        refill_size *= 2;
+    if (refill_size > capacity)
+        refill_size = capacity;
+}
+
+// **************************************************************
+uint64_t Random_Integers::Next_Bounded(const uint64_t bound)
+/**
+ * Return a uniformly distributed integer in [0, bound[, without bias.
+ * Lemire's multiply and reject method: one multiplication and, except
+ * with probability bound/2^64 (bound/2^32), no division. Bounds up to
+ * 2^32 only use 32 random bits.
+ *
+ * @param   bound   Number of possible values (at least 1)
+ */
+{
+    assert(bound >= 1);
+    const uint64_t two_32 = uint64_t(1) << 32;
+    if (bound <= two_32)
+    {
+        uint64_t product = uint64_t(Next_Uint32()) * bound;
+        uint64_t low = product & (two_32 - 1);
+        if (low < bound)
+        {
+            const uint64_t threshold = two_32 % bound;
+            while (low < threshold)
+            {
+                product = uint64_t(Next_Uint32()) * bound;
+                low     = product & (two_32 - 1);
+            }
+        }
+        return product >> 32;
+    }
+
+#ifdef __SIZEOF_INT128__
+    uint128_t product = uint128_t(Next_Uint64()) * uint128_t(bound);
+    uint64_t low = uint64_t(product);
+    if (low < bound)
+    {
+        const uint64_t threshold = (uint64_t(0) - bound) % bound;
+        while (low < threshold)
+        {
+            product = uint128_t(Next_Uint64()) * uint128_t(bound);
+            low     = uint64_t(product);
+        }
+    }
+    return uint64_t(product >> 64);
+#else  // #ifdef __SIZEOF_INT128__
+    // Reject the numbers above the last multiple of "bound"
+    const uint64_t threshold = (uint64_t(0) - bound) % bound;
+    uint64_t x = Next_Uint64();
+    while (x < threshold)
+        x = Next_Uint64();
+    return x % bound;
+#endif // #ifdef __SIZEOF_INT128__
+}
+
+// ********** End of file ***************************************
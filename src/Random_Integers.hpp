@@ -0,0 +1,73 @@
+#ifndef INC_Random_Integers_hpp
+#define INC_Random_Integers_hpp
+
+#include <stdint.h> // (u)int64_t
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Uniform 32 and 64-bit integers, bounded integers and single bits
+// drawn from a PRNG. Numbers in [1,2[ are generated in bulk
+// (Fill_Array_Close1_Open2()) and each gives the low 32 bits of its
+// mantissa, which is cheaper than packing all 52 bits. The buffer
+// starts small and doubles on each refill (up to "capacity"), so a
+// few draws don't consume a whole block of the PRNG.
+class Random_Integers
+{
+    public:
+        static const int capacity = 4096;
+
+    private:
+        PRNG       &prng;
+        double      buffer[capacity];
+        int         size;
+        int         next;
+        int         refill_size;
+        uint64_t    bits;
+        int         nb_bits;
+
+        void        Refill();
+
+    public:
+        explicit    Random_Integers(PRNG &new_prng);
+
+        // **************************************************************
+        inline uint32_t Next_Uint32()
+        {
+            if (next == size)
+                Refill();
+            union {
+                double   d;
+                uint64_t u;
+            } number;
+            number.d = buffer[next++];
+            return uint32_t(number.u);
+        }
+
+        // **************************************************************
+        inline uint64_t Next_Uint64()
+        {
+            const uint64_t low = Next_Uint32();
+            return (uint64_t(Next_Uint32()) << 32) | low;
+        }
+
+        // **************************************************************
+        inline bool Next_Bit()
+        {
+            if (nb_bits == 0)
+            {
+                bits    = Next_Uint64();
+                nb_bits = 64;
+            }
+            const bool bit = ((bits & 1) != 0);
+            bits >>= 1;
+            nb_bits--;
+            return bit;
+        }
+
+        uint64_t    Next_Bounded(const uint64_t bound);
+};
+
+#endif // INC_Random_Integers_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,337 @@
+#ifndef INC_SIMD_Ops_hpp
+#define INC_SIMD_Ops_hpp
+
+// **************************************************************
+// Operations on one SIMD vector (or a scalar), for the kernels written
+// once for all instruction sets (Vector_Math.cpp, Generator_Array.cpp,
+// Bernoulli.cpp).
+// The widest instruction set the compiler targets is used: AVX-512
+// (PRNG_SIMD_AVX512), AVX2 or SSE2 with HAVE_SSE2; PRNG_SIMD is defined
+// with any of them, with Double_Vector and Word_Vector the vectors of
+// doubles and of 32-bit words. Internal to the library.
+
+// The SIMD types are used as template arguments of Ops<>; their
+// alignment attributes being dropped there is harmless.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+
+#include <stdint.h> // (u)int64_t
+#include <cstring>  // memcpy()
+#include <cmath>    // std::sqrt()
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define PRNG_SIMD_AVX512
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define PRNG_SIMD_AVX2
+#elif defined(HAVE_SSE2)
+#include <emmintrin.h>
+#define PRNG_SIMD_SSE2
+#endif
+#if defined(PRNG_SIMD_AVX512) || defined(PRNG_SIMD_AVX2) || defined(PRNG_SIMD_SSE2)
+#define PRNG_SIMD
+#endif
+
+template <class V>
+struct Ops;
+
+// **************************************************************
+// Vectors of doubles, with the matching 64-bit integer vector and
+// comparison mask (Vector_Math's kernels; the 64-bit words alone for
+// Bernoulli.cpp's bit-sliced comparisons). And_Not64(i, j) is ~i & j.
+// **************************************************************
+template <>
+struct Ops<double>
+{
+    typedef double   Vector;
+    typedef uint64_t Integer;
+    typedef bool     Mask;
+    static const int lanes = 1;
+
+    static inline double   Load(const double *p)                       { return *p; }
+    static inline void     Store(double *p, const double a)            { *p = a; }
+    static inline double   Set(const double a)                         { return a; }
+    static inline double   Add(const double a, const double b)         { return a + b; }
+    static inline double   Sub(const double a, const double b)         { return a - b; }
+    static inline double   Mul(const double a, const double b)         { return a * b; }
+    static inline double   Div(const double a, const double b)         { return a / b; }
+    static inline double   Sqrt(const double a)                        { return std::sqrt(a); }
+    static inline bool     Less(const double a, const double b)        { return a < b; }
+    static inline bool     Equal(const double a, const double b)       { return (a >= b && a <= b); }
+    static inline bool     Not_Greater_Equal(const double a, const double b) { return !(a >= b); }
+    static inline double   Select(const bool m, const double a, const double b) { return (m ? a : b); }
+    static inline uint64_t Bits(const double a)                        { uint64_t i; memcpy(&i, &a, sizeof(i)); return i; }
+    static inline double   From_Bits(const uint64_t i)                 { double a; memcpy(&a, &i, sizeof(a)); return a; }
+    static inline uint64_t Load64(const uint64_t *p)                   { return *p; }
+    static inline void     Store64(uint64_t *p, const uint64_t i)      { *p = i; }
+    static inline uint64_t Set64(const uint64_t i)                     { return i; }
+    static inline uint64_t Add64(const uint64_t i, const uint64_t j)   { return i + j; }
+    static inline uint64_t Sub64(const uint64_t i, const uint64_t j)   { return i - j; }
+    static inline uint64_t And64(const uint64_t i, const uint64_t j)   { return i & j; }
+    static inline uint64_t And_Not64(const uint64_t i, const uint64_t j) { return ~i & j; }
+    static inline uint64_t Or64(const uint64_t i, const uint64_t j)    { return i | j; }
+    static inline bool     Is_Zero64(const uint64_t i)                 { return (i == 0); }
+    static inline uint64_t Xor64(const uint64_t i, const uint64_t j)   { return i ^ j; }
+    static inline uint64_t Shift_Left64(const uint64_t i, const int n) { return i << n; }
+    static inline uint64_t Shift_Right64(const uint64_t i, const int n){ return i >> n; }
+    static inline bool     Mask_From_Bit(const uint64_t i)             { return (i != 0); }
+};
+
+#ifdef PRNG_SIMD_SSE2
+// **************************************************************
+template <>
+struct Ops<__m128d>
+{
+    typedef __m128d Vector;
+    typedef __m128i Integer;
+    typedef __m128d Mask;
+    static const int lanes = 2;
+
+    static inline __m128d Load(const double *p)                        { return _mm_loadu_pd(p); }
+    static inline void    Store(double *p, const __m128d a)            { _mm_storeu_pd(p, a); }
+    static inline __m128d Set(const double a)                          { return _mm_set1_pd(a); }
+    static inline __m128d Add(const __m128d a, const __m128d b)        { return _mm_add_pd(a, b); }
+    static inline __m128d Sub(const __m128d a, const __m128d b)        { return _mm_sub_pd(a, b); }
+    static inline __m128d Mul(const __m128d a, const __m128d b)        { return _mm_mul_pd(a, b); }
+    static inline __m128d Div(const __m128d a, const __m128d b)        { return _mm_div_pd(a, b); }
+    static inline __m128d Sqrt(const __m128d a)                        { return _mm_sqrt_pd(a); }
+    static inline __m128d Less(const __m128d a, const __m128d b)       { return _mm_cmplt_pd(a, b); }
+    static inline __m128d Equal(const __m128d a, const __m128d b)      { return _mm_cmpeq_pd(a, b); }
+    static inline __m128d Not_Greater_Equal(const __m128d a, const __m128d b) { return _mm_cmpnge_pd(a, b); }
+    static inline __m128d Select(const __m128d m, const __m128d a, const __m128d b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static inline __m128i Bits(const __m128d a)                        { return _mm_castpd_si128(a); }
+    static inline __m128d From_Bits(const __m128i i)                   { return _mm_castsi128_pd(i); }
+    static inline __m128i Load64(const uint64_t *p)                    { return _mm_loadu_si128((const __m128i *) p); }
+    static inline void    Store64(uint64_t *p, const __m128i i)        { _mm_storeu_si128((__m128i *) p, i); }
+    static inline __m128i Set64(const uint64_t i)                      { return _mm_set1_epi64x(int64_t(i)); }
+    static inline __m128i Add64(const __m128i i, const __m128i j)      { return _mm_add_epi64(i, j); }
+    static inline __m128i Sub64(const __m128i i, const __m128i j)      { return _mm_sub_epi64(i, j); }
+    static inline __m128i And64(const __m128i i, const __m128i j)      { return _mm_and_si128(i, j); }
+    static inline __m128i And_Not64(const __m128i i, const __m128i j)  { return _mm_andnot_si128(i, j); }
+    static inline __m128i Or64(const __m128i i, const __m128i j)       { return _mm_or_si128(i, j); }
+    static inline bool    Is_Zero64(const __m128i i)                   { return (_mm_movemask_epi8(_mm_cmpeq_epi32(i, _mm_setzero_si128())) == 0xFFFF); }
+    static inline __m128i Xor64(const __m128i i, const __m128i j)      { return _mm_xor_si128(i, j); }
+    static inline __m128i Shift_Left64(const __m128i i, const int n)   { return _mm_sll_epi64(i, _mm_cvtsi32_si128(n)); }
+    static inline __m128i Shift_Right64(const __m128i i, const int n)  { return _mm_srl_epi64(i, _mm_cvtsi32_si128(n)); }
+    // Lanes of "i" are 0 or 1
+    static inline __m128d Mask_From_Bit(const __m128i i)               { return _mm_castsi128_pd(_mm_sub_epi64(_mm_setzero_si128(), i)); }
+};
+typedef __m128d Double_Vector;
+#endif // #ifdef PRNG_SIMD_SSE2
+
+#ifdef PRNG_SIMD_AVX2
+// **************************************************************
+template <>
+struct Ops<__m256d>
+{
+    typedef __m256d Vector;
+    typedef __m256i Integer;
+    typedef __m256d Mask;
+    static const int lanes = 4;
+
+    static inline __m256d Load(const double *p)                        { return _mm256_loadu_pd(p); }
+    static inline void    Store(double *p, const __m256d a)            { _mm256_storeu_pd(p, a); }
+    static inline __m256d Set(const double a)                          { return _mm256_set1_pd(a); }
+    static inline __m256d Add(const __m256d a, const __m256d b)        { return _mm256_add_pd(a, b); }
+    static inline __m256d Sub(const __m256d a, const __m256d b)        { return _mm256_sub_pd(a, b); }
+    static inline __m256d Mul(const __m256d a, const __m256d b)        { return _mm256_mul_pd(a, b); }
+    static inline __m256d Div(const __m256d a, const __m256d b)        { return _mm256_div_pd(a, b); }
+    static inline __m256d Sqrt(const __m256d a)                        { return _mm256_sqrt_pd(a); }
+    static inline __m256d Less(const __m256d a, const __m256d b)       { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static inline __m256d Equal(const __m256d a, const __m256d b)      { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static inline __m256d Not_Greater_Equal(const __m256d a, const __m256d b) { return _mm256_cmp_pd(a, b, _CMP_NGE_UQ); }
+    static inline __m256d Select(const __m256d m, const __m256d a, const __m256d b) { return _mm256_blendv_pd(b, a, m); }
+    static inline __m256i Bits(const __m256d a)                        { return _mm256_castpd_si256(a); }
+    static inline __m256d From_Bits(const __m256i i)                   { return _mm256_castsi256_pd(i); }
+    static inline __m256i Load64(const uint64_t *p)                    { return _mm256_loadu_si256((const __m256i *) p); }
+    static inline void    Store64(uint64_t *p, const __m256i i)        { _mm256_storeu_si256((__m256i *) p, i); }
+    static inline __m256i Set64(const uint64_t i)                      { return _mm256_set1_epi64x(int64_t(i)); }
+    static inline __m256i Add64(const __m256i i, const __m256i j)      { return _mm256_add_epi64(i, j); }
+    static inline __m256i Sub64(const __m256i i, const __m256i j)      { return _mm256_sub_epi64(i, j); }
+    static inline __m256i And64(const __m256i i, const __m256i j)      { return _mm256_and_si256(i, j); }
+    static inline __m256i And_Not64(const __m256i i, const __m256i j)  { return _mm256_andnot_si256(i, j); }
+    static inline __m256i Or64(const __m256i i, const __m256i j)       { return _mm256_or_si256(i, j); }
+    static inline bool    Is_Zero64(const __m256i i)                   { return (_mm256_testz_si256(i, i) != 0); }
+    static inline __m256i Xor64(const __m256i i, const __m256i j)      { return _mm256_xor_si256(i, j); }
+    static inline __m256i Shift_Left64(const __m256i i, const int n)   { return _mm256_sll_epi64(i, _mm_cvtsi32_si128(n)); }
+    static inline __m256i Shift_Right64(const __m256i i, const int n)  { return _mm256_srl_epi64(i, _mm_cvtsi32_si128(n)); }
+    // Lanes of "i" are 0 or 1
+    static inline __m256d Mask_From_Bit(const __m256i i)               { return _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_setzero_si256(), i)); }
+};
+typedef __m256d Double_Vector;
+#endif // #ifdef PRNG_SIMD_AVX2
+
+#ifdef PRNG_SIMD_AVX512
+// **************************************************************
+template <>
+struct Ops<__m512d>
+{
+    typedef __m512d Vector;
+    typedef __m512i Integer;
+    typedef __mmask8 Mask;
+    static const int lanes = 8;
+    // All lanes, for the zero-masked intrinsics: GCC 12's unmasked ones
+    // start from an undefined vector, which -Wmaybe-uninitialized
+    // reports once inlined
+    static const __mmask8 all = 0xFF;
+
+    static inline __m512d  Load(const double *p)                       { return _mm512_loadu_pd(p); }
+    static inline void     Store(double *p, const __m512d a)           { _mm512_storeu_pd(p, a); }
+    static inline __m512d  Set(const double a)                         { return _mm512_set1_pd(a); }
+    static inline __m512d  Add(const __m512d a, const __m512d b)       { return _mm512_add_pd(a, b); }
+    static inline __m512d  Sub(const __m512d a, const __m512d b)       { return _mm512_sub_pd(a, b); }
+    static inline __m512d  Mul(const __m512d a, const __m512d b)       { return _mm512_mul_pd(a, b); }
+    static inline __m512d  Div(const __m512d a, const __m512d b)       { return _mm512_div_pd(a, b); }
+    static inline __m512d  Sqrt(const __m512d a)                       { return _mm512_maskz_sqrt_pd(all, a); }
+    static inline __mmask8 Less(const __m512d a, const __m512d b)      { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static inline __mmask8 Equal(const __m512d a, const __m512d b)     { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static inline __mmask8 Not_Greater_Equal(const __m512d a, const __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_NGE_UQ); }
+    static inline __m512d  Select(const __mmask8 m, const __m512d a, const __m512d b) { return _mm512_mask_blend_pd(m, b, a); }
+    static inline __m512i  Bits(const __m512d a)                       { return _mm512_castpd_si512(a); }
+    static inline __m512d  From_Bits(const __m512i i)                  { return _mm512_castsi512_pd(i); }
+    static inline __m512i  Load64(const uint64_t *p)                   { return _mm512_loadu_si512((const void *) p); }
+    static inline void     Store64(uint64_t *p, const __m512i i)       { _mm512_storeu_si512((void *) p, i); }
+    static inline __m512i  Set64(const uint64_t i)                     { return _mm512_set1_epi64(int64_t(i)); }
+    static inline __m512i  Add64(const __m512i i, const __m512i j)     { return _mm512_add_epi64(i, j); }
+    static inline __m512i  Sub64(const __m512i i, const __m512i j)     { return _mm512_sub_epi64(i, j); }
+    static inline __m512i  And64(const __m512i i, const __m512i j)     { return _mm512_and_si512(i, j); }
+    static inline __m512i  And_Not64(const __m512i i, const __m512i j) { return _mm512_maskz_andnot_epi64(all, i, j); }
+    static inline __m512i  Or64(const __m512i i, const __m512i j)      { return _mm512_or_si512(i, j); }
+    static inline bool     Is_Zero64(const __m512i i)                  { return (_mm512_test_epi64_mask(i, i) == 0); }
+    static inline __m512i  Xor64(const __m512i i, const __m512i j)     { return _mm512_xor_si512(i, j); }
+    static inline __m512i  Shift_Left64(const __m512i i, const int n)  { return _mm512_maskz_sll_epi64(all, i, _mm_cvtsi32_si128(n)); }
+    static inline __m512i  Shift_Right64(const __m512i i, const int n) { return _mm512_maskz_srl_epi64(all, i, _mm_cvtsi32_si128(n)); }
+    static inline __mmask8 Mask_From_Bit(const __m512i i)              { return _mm512_test_epi64_mask(i, i); }
+};
+typedef __m512d Double_Vector;
+#endif // #ifdef PRNG_SIMD_AVX512
+
+// Exponent of [1,2[ (a number of [0,1[ is one of [1,2[ minus 1, as dSFMT's)
+const uint64_t one_exponent = uint64_t(0x3FF00000) << 32;
+
+// **************************************************************
+// Vectors of 32-bit words (Generator_Array's xoshiro128++ steps)
+// **************************************************************
+template <>
+struct Ops<uint32_t>
+{
+    static const int lanes = 1;
+
+    static inline uint32_t Load(const uint32_t *p)                      { return *p; }
+    static inline void     Store(uint32_t *p, const uint32_t a)         { *p = a; }
+    static inline uint32_t Add(const uint32_t a, const uint32_t b)      { return a + b; }
+    static inline uint32_t Xor(const uint32_t a, const uint32_t b)      { return a ^ b; }
+    static inline uint32_t Shift_Left(const uint32_t a, const int n)    { return a << n; }
+    static inline uint32_t Rotate_Left(const uint32_t a, const int n)   { return (a << n) | (a >> (32 - n)); }
+    // p[k] = number of [0,1[ with "high" then "low" as top bits
+    static inline void     Store_Close0_Open1(double *p, const uint32_t high, const uint32_t low)
+    {
+        const uint64_t bits = one_exponent | (((uint64_t(high) << 32) | uint64_t(low)) >> 12);
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        *p = d - 1.0;
+    }
+};
+
+#ifdef PRNG_SIMD_SSE2
+// **************************************************************
+template <>
+struct Ops<__m128i>
+{
+    static const int lanes = 4;
+
+    static inline __m128i Load(const uint32_t *p)                       { return _mm_loadu_si128((const __m128i *) p); }
+    static inline void    Store(uint32_t *p, const __m128i a)           { _mm_storeu_si128((__m128i *) p, a); }
+    static inline __m128i Add(const __m128i a, const __m128i b)         { return _mm_add_epi32(a, b); }
+    static inline __m128i Xor(const __m128i a, const __m128i b)         { return _mm_xor_si128(a, b); }
+    static inline __m128i Shift_Left(const __m128i a, const int n)      { return _mm_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+    static inline __m128i Rotate_Left(const __m128i a, const int n)
+    {
+        return _mm_or_si128(_mm_sll_epi32(a, _mm_cvtsi32_si128(n)), _mm_srl_epi32(a, _mm_cvtsi32_si128(32 - n)));
+    }
+    static inline void    Store_Close0_Open1(double *p, const __m128i high, const __m128i low)
+    {
+        const __m128i exponent = _mm_set1_epi64x(int64_t(one_exponent));
+        const __m128d one      = _mm_set1_pd(1.0);
+        // Entities' 64-bit words: (low, high) pairs of 32-bit words
+        const __m128i first  = _mm_or_si128(_mm_srli_epi64(_mm_unpacklo_epi32(low, high), 12), exponent);
+        const __m128i second = _mm_or_si128(_mm_srli_epi64(_mm_unpackhi_epi32(low, high), 12), exponent);
+        _mm_storeu_pd(p,     _mm_sub_pd(_mm_castsi128_pd(first),  one));
+        _mm_storeu_pd(p + 2, _mm_sub_pd(_mm_castsi128_pd(second), one));
+    }
+};
+typedef __m128i Word_Vector;
+#endif // #ifdef PRNG_SIMD_SSE2
+
+#ifdef PRNG_SIMD_AVX2
+// **************************************************************
+template <>
+struct Ops<__m256i>
+{
+    static const int lanes = 8;
+
+    static inline __m256i Load(const uint32_t *p)                       { return _mm256_loadu_si256((const __m256i *) p); }
+    static inline void    Store(uint32_t *p, const __m256i a)           { _mm256_storeu_si256((__m256i *) p, a); }
+    static inline __m256i Add(const __m256i a, const __m256i b)         { return _mm256_add_epi32(a, b); }
+    static inline __m256i Xor(const __m256i a, const __m256i b)         { return _mm256_xor_si256(a, b); }
+    static inline __m256i Shift_Left(const __m256i a, const int n)      { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+    static inline __m256i Rotate_Left(const __m256i a, const int n)
+    {
+        return _mm256_or_si256(_mm256_sll_epi32(a, _mm_cvtsi32_si128(n)), _mm256_srl_epi32(a, _mm_cvtsi32_si128(32 - n)));
+    }
+    static inline void    Store_Close0_Open1(double *p, const __m256i high, const __m256i low)
+    {
+        const __m256i exponent = _mm256_set1_epi64x(int64_t(one_exponent));
+        const __m256d one      = _mm256_set1_pd(1.0);
+        // Unpacking works within 128 bits halves: entities (0,1,4,5) and (2,3,6,7)
+        const __m256i a = _mm256_unpacklo_epi32(low, high);
+        const __m256i b = _mm256_unpackhi_epi32(low, high);
+        const __m256i first  = _mm256_or_si256(_mm256_srli_epi64(_mm256_permute2x128_si256(a, b, 0x20), 12), exponent);
+        const __m256i second = _mm256_or_si256(_mm256_srli_epi64(_mm256_permute2x128_si256(a, b, 0x31), 12), exponent);
+        _mm256_storeu_pd(p,     _mm256_sub_pd(_mm256_castsi256_pd(first),  one));
+        _mm256_storeu_pd(p + 4, _mm256_sub_pd(_mm256_castsi256_pd(second), one));
+    }
+};
+typedef __m256i Word_Vector;
+#endif // #ifdef PRNG_SIMD_AVX2
+
+#ifdef PRNG_SIMD_AVX512
+// **************************************************************
+template <>
+struct Ops<__m512i>
+{
+    static const int lanes = 16;
+    static const __mmask16 all = 0xFFFF;   // See Ops<__m512d>::all
+
+    static inline __m512i Load(const uint32_t *p)                       { return _mm512_loadu_si512((const void *) p); }
+    static inline void    Store(uint32_t *p, const __m512i a)           { _mm512_storeu_si512((void *) p, a); }
+    static inline __m512i Add(const __m512i a, const __m512i b)         { return _mm512_add_epi32(a, b); }
+    static inline __m512i Xor(const __m512i a, const __m512i b)         { return _mm512_xor_si512(a, b); }
+    static inline __m512i Shift_Left(const __m512i a, const int n)      { return _mm512_maskz_sll_epi32(all, a, _mm_cvtsi32_si128(n)); }
+    static inline __m512i Rotate_Left(const __m512i a, const int n)
+    {
+        return _mm512_or_si512(_mm512_maskz_sll_epi32(all, a, _mm_cvtsi32_si128(n)), _mm512_maskz_srl_epi32(all, a, _mm_cvtsi32_si128(32 - n)));
+    }
+    static inline void    Store_Close0_Open1(double *p, const __m512i high, const __m512i low)
+    {
+        const __m512i exponent = _mm512_set1_epi64(int64_t(one_exponent));
+        const __m512d one      = _mm512_set1_pd(1.0);
+        // Unpacking works within 128 bits quarters: entities (0,1,4,5,8,9,12,13) and (2,3,6,7,10,11,14,15)
+        const __m512i a = _mm512_maskz_unpacklo_epi32(all, low, high);
+        const __m512i b = _mm512_maskz_unpackhi_epi32(all, low, high);
+        const __m512i first_entities  = _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0);
+        const __m512i second_entities = _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4);
+        const __m512i first  = _mm512_or_si512(_mm512_maskz_srli_epi64(__mmask8(all), _mm512_permutex2var_epi64(a, first_entities,  b), 12), exponent);
+        const __m512i second = _mm512_or_si512(_mm512_maskz_srli_epi64(__mmask8(all), _mm512_permutex2var_epi64(a, second_entities, b), 12), exponent);
+        _mm512_storeu_pd(p,     _mm512_sub_pd(_mm512_castsi512_pd(first),  one));
+        _mm512_storeu_pd(p + 8, _mm512_sub_pd(_mm512_castsi512_pd(second), one));
+    }
+};
+typedef __m512i Word_Vector;
+#endif // #ifdef PRNG_SIMD_AVX512
+
+#endif // INC_SIMD_Ops_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,222 @@
+
+#include <cassert>
+#include <cfloat>    // DBL_EPSILON
+#include <cmath>     // nextafter()
+#include <algorithm> // std::swap(), std::sort(), std::min()
+#include <vector>
+
+#include "Sampling.hpp"
+#include "Random_Integers.hpp"
+
+// Antithetic numbers drawn at a time
+const uint64_t sampling_chunk = 1024;
+
+// **************************************************************
+static void Interval_Bounds(const int interval, double &low, double &width, int &unit_interval)
+/**
+ * Return an interval (one of PRNG_Intervals) as low + width * u, with
+ * "unit_interval" the interval of u in [0,1] having the same open and
+ * closed ends.
+ */
+{
+    switch (interval)
+    {
+        case PRNG_Close0_Open1:
+            low = 0.0;  width = 1.0;  unit_interval = PRNG_Close0_Open1;
+            break;
+        case PRNG_Open0_Close1:
+            low = 0.0;  width = 1.0;  unit_interval = PRNG_Open0_Close1;
+            break;
+        case PRNG_Open0_Open1:
+            low = 0.0;  width = 1.0;  unit_interval = PRNG_Open0_Open1;
+            break;
+        case PRNG_CloseN1_Open1:
+            low = -1.0; width = 2.0;  unit_interval = PRNG_Close0_Open1;
+            break;
+        default:
+            low = 1.0;  width = 1.0;  unit_interval = PRNG_Close0_Open1;
+            break;
+    }
+}
+
+namespace prng
+{
+// **************************************************************
+void Fill_Antithetic(PRNG &prng, double *array, const uint64_t n, const int interval)
+/**
+ * Fill "array" with "n" numbers in antithetic pairs: array[2i] is the
+ * next pseudo-random number of "prng" in "interval", and array[2i+1]
+ * its reflection in the interval. The numbers are low + width * k/2^52
+ * (k odd for ]0,1[), so the reflection maps them to the same set:
+ * low + (width - (x - low)) for ]a,b[, shifted by one step down for
+ * [a,b[ (1-2^-52-x for [0,1[) and up for ]a,b], which keeps the closed
+ * end closed and is exact. Only (n+1)/2 numbers are drawn, by chunks
+ * in an aligned buffer (PRNG::Fill_Array()'s bulk path); with an odd
+ * "n" the last one has no pair.
+ */
+{
+    double low, width;
+    int unit_interval;
+    Interval_Bounds(interval, low, width, unit_interval);
+    const double step = width * DBL_EPSILON;    // width / 2^52
+    const double shift = (unit_interval == PRNG_Close0_Open1 ? -step : (unit_interval == PRNG_Open0_Close1 ? step : 0.0));
+
+    // 16 bytes aligned for SSE2 (doubles are at least 8 bytes aligned)
+    double storage[sampling_chunk + 1];
+    double *draws = &storage[(uintptr_t(storage) % 16 == 0) ? 0 : 1];
+
+    const uint64_t nb_draws = (n + 1) / 2;
+    for (uint64_t i = 0 ; i < nb_draws ; i += sampling_chunk)
+    {
+        const uint64_t size = std::min(sampling_chunk, nb_draws - i);
+        prng.Fill_Array(draws, size, interval);
+        for (uint64_t j = 0 ; j < size ; j++)
+        {
+            const double x = draws[j];
+            array[2*(i + j)] = x;
+            if (2*(i + j) + 1 < n)
+                array[2*(i + j) + 1] = low + ((width - (x - low)) + shift);
+        }
+    }
+}
+
+// **************************************************************
+void Fill_Stratified(PRNG &prng, double *array, const uint64_t n, const uint64_t nb_strata, const int interval)
+/**
+ * Fill "array" with "n" numbers, array[i] uniformly distributed in
+ * stratum s = i % nb_strata: low + width * (s + u) / nb_strata, u in
+ * the unit interval with the same ends as "interval". A number that
+ * rounding puts on (or past) an open end of its stratum is moved to
+ * the nearest double inside. Every "nb_strata" consecutive numbers
+ * cover all the strata.
+ */
+{
+    assert(nb_strata >= 1);
+
+    double low, width;
+    int unit_interval;
+    Interval_Bounds(interval, low, width, unit_interval);
+    prng.Fill_Array(array, n, unit_interval);
+
+    const bool open_low  = (unit_interval == PRNG_Open0_Close1 || unit_interval == PRNG_Open0_Open1);
+    const bool open_high = (unit_interval != PRNG_Open0_Close1);
+    const double stratum_width = width / double(nb_strata);
+    uint64_t stratum = 0;
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        const double lower = (stratum == 0 ? low : low + stratum_width * double(stratum));
+        const double upper = (stratum + 1 == nb_strata ? low + width : low + stratum_width * double(stratum + 1));
+        double x = low + stratum_width * (double(stratum) + array[i]);
+        if (x < lower || (open_low && x <= lower))
+            x = (open_low ? nextafter(lower, upper) : lower);
+        if (x > upper || (open_high && x >= upper))
+            x = (open_high ? nextafter(upper, lower) : upper);
+        array[i] = x;
+        if (++stratum == nb_strata)
+            stratum = 0;
+    }
+}
+
+// **************************************************************
+void Fill_Latin_Hypercube(PRNG &prng, double *array, const uint64_t n, const int dimension, const int interval)
+/**
+ * Fill "array" with a Latin hypercube design of "n" points in
+ * "dimension" dimensions, as a structure of arrays: coordinate d of
+ * point i is array[d*n + i]. Each coordinate is stratified over the
+ * "n" points (Fill_Stratified()), then the points are shuffled
+ * (Fisher-Yates), independently for each coordinate.
+ */
+{
+    assert(dimension >= 1);
+
+    Random_Integers integers(prng);
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        double *coordinates = &array[uint64_t(d) * n];
+        Fill_Stratified(prng, coordinates, n, n, interval);
+        for (uint64_t i = n ; i > 1 ; i--)
+            std::swap(coordinates[i - 1], coordinates[integers.Next_Bounded(i)]);
+    }
+}
+
+// **************************************************************
+void Sample_Without_Replacement(PRNG &prng, const uint64_t n, const uint64_t k, uint64_t *sample)
+/**
+ * Fill "sample" with "k" distinct integers of [0, n[, every subset
+ * being equally likely, in increasing order. The algorithm depends on
+ * k/n:
+ *   - k >= n/16: selection sampling (Knuth's Algorithm S), one draw
+ *     per candidate, already in order;
+ *   - small k (up to 32): Floyd's algorithm, k draws, looking up the
+ *     ones already taken in the sample itself;
+ *   - otherwise: Floyd's algorithm with a hash set.
+ *
+ * @param   prng    Generator
+ * @param   n       Size of the population
+ * @param   k       Size of the sample (at most n)
+ * @param   sample  Array of "k" integers
+ */
+{
+    assert(k <= n);
+    if (k == 0)
+        return;
+    Random_Integers integers(prng);
+
+    if (k >= n / 16)
+    {
+        // Take candidate i with probability (still needed)/(still left)
+        uint64_t nb_taken = 0;
+        for (uint64_t i = 0 ; nb_taken < k ; i++)
+        {
+            const double u = double(integers.Next_Uint64() >> 11) * (1.0 / 9007199254740992.0); // [0,1[
+            if (double(n - i) * u < double(k - nb_taken))
+                sample[nb_taken++] = i;
+        }
+        return;
+    }
+
+    // Floyd: for j = n-k to n-1, take a random t in [0, j], or j itself
+    // if t was already taken
+    if (k <= 32)
+    {
+        for (uint64_t m = 0 ; m < k ; m++)
+        {
+            const uint64_t j = n - k + m;
+            const uint64_t t = integers.Next_Bounded(j + 1);
+            sample[m] = (std::find(sample, sample + m, t) != sample + m ? j : t);
+        }
+    }
+    else
+    {
+        // Open addressing, at most half full; entries are value+1 (0 is empty)
+        int table_bits = 1;
+        while ((uint64_t(1) << table_bits) < 2 * k)
+            table_bits++;
+        const uint64_t table_mask = (uint64_t(1) << table_bits) - 1;
+        std::vector<uint64_t> table(table_mask + 1, 0);
+
+        for (uint64_t m = 0 ; m < k ; m++)
+        {
+            const uint64_t j = n - k + m;
+            uint64_t value = integers.Next_Bounded(j + 1);
+            for (int attempt = 0 ; attempt < 2 ; attempt++)
+            {
+                // Fibonacci hashing
+                uint64_t slot = ((value * ((uint64_t(0x9e3779b9) << 32) | uint64_t(0x7f4a7c15))) >> (64 - table_bits));
+                while (table[slot] != 0 && table[slot] != value + 1)
+                    slot = (slot + 1) & table_mask;
+                if (table[slot] == 0)
+                {
+                    table[slot] = value + 1;
+                    break;
+                }
+                value = j; // Already taken: j can't be (it is new)
+            }
+            sample[m] = value;
+        }
+    }
+    std::sort(sample, sample + k);
+}
+} // namespace prng
+
+// ********** End of file ***************************************
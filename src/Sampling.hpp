@@ -0,0 +1,168 @@
+#ifndef INC_Sampling_hpp
+#define INC_Sampling_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "PseudoRandomNumberGenerator.hpp"
+#include "Random_Integers.hpp"
+#ifdef PRNG_STRICT_FP
+#include "Vector_Math.hpp"
+#endif // #ifdef PRNG_STRICT_FP
+
+// **************************************************************
+// Variance reduction sampling, built on PRNG's bulk generation. All
+// functions fill caller provided arrays with numbers in one of
+// PRNG_Intervals.
+namespace prng
+{
+    // Antithetic pairs: array[2i] is a pseudo-random number x and
+    // array[2i+1] its reflection in the interval, with the same ends
+    // (1-2^-52-x for [0,1[).
+    void Fill_Antithetic(PRNG &prng, double *array, const uint64_t n, const int interval);
+
+    // Stratified: array[i] is uniform in stratum (i % nb_strata) of the
+    // interval split in "nb_strata" equal parts.
+    void Fill_Stratified(PRNG &prng, double *array, const uint64_t n, const uint64_t nb_strata, const int interval);
+
+    // Latin hypercube design of "n" points in "dimension" dimensions,
+    // as a structure of arrays (coordinate d of point i is
+    // array[d*n + i]): each coordinate has exactly one point in each of
+    // the "n" strata of the interval.
+    void Fill_Latin_Hypercube(PRNG &prng, double *array, const uint64_t n, const int dimension, const int interval);
+
+    // "k" distinct integers of [0, n[, uniformly, in increasing order.
+    void Sample_Without_Replacement(PRNG &prng, const uint64_t n, const uint64_t k, uint64_t *sample);
+}
+
+// **************************************************************
+// Uniform sample of "k" items of a stream of unknown length
+// (reservoir sampling, Li's Algorithm L): after n items, each of them
+// is in the sample with probability k/n. The number of items skipped
+// before the next one kept is drawn directly, so only O(k log(n/k))
+// random numbers are used. Add() takes every item; a producer can
+// instead ask how many items will be discarded (Nb_To_Skip()) and
+// Skip() them without building them. The replaced slot is an unbiased
+// bounded integer (Random_Integers).
+template <class T>
+class Reservoir
+{
+    PRNG           &prng;
+    Random_Integers integers;
+    std::vector<T>  sample;
+    uint64_t        capacity;
+    uint64_t        nb_seen;
+    uint64_t        next;       // Index of the next item kept
+    double          w;
+
+    // **************************************************************
+    // libm's log() and exp() can differ between instruction sets
+    static double Log(const double x)
+    {
+#ifdef PRNG_STRICT_FP
+        return prng::Log(x);
+#else
+        return std::log(x);
+#endif // #ifdef PRNG_STRICT_FP
+    }
+    static double Exp(const double x)
+    {
+#ifdef PRNG_STRICT_FP
+        return prng::Exp(x);
+#else
+        return std::exp(x);
+#endif // #ifdef PRNG_STRICT_FP
+    }
+
+    // **************************************************************
+    // log(1 - x), with a few terms of its series for a small x, where
+    // 1 - x would lose x's last digits (and be 1 below ~1e-16)
+    static double Log_One_Minus(const double x)
+    {
+        if (x < 1.0e-4)
+            return 0.0 - (x + x * x * (0.5 + x * (1.0 / 3.0 + x * 0.25)));
+        return Log(1.0 - x);
+    }
+
+    // **************************************************************
+    void Draw_Next()
+    {
+        // The skip is +inf (or NaN) once w underflows: clamp it so the
+        // next index stays below 2^64 instead of converting it
+        assert(next < ~uint64_t(0));
+        const double   skip     = std::floor(Log(prng.Get_Random()) / Log_One_Minus(w));
+        const uint64_t max_skip = ~uint64_t(0) - next - 1;
+        uint64_t nb_skipped = max_skip;
+        if (skip < 9.0e18 && uint64_t(skip) < max_skip)
+            nb_skipped = uint64_t(skip);
+        next += nb_skipped + 1;
+        w    *= Exp(Log(prng.Get_Random()) / double(capacity));
+    }
+
+    public:
+        // **************************************************************
+        Reservoir(PRNG &new_prng, const uint64_t k)
+            : prng(new_prng), integers(new_prng), capacity(k), nb_seen(0), next(0), w(0.0)
+        {
+            sample.reserve(k);
+        }
+
+        // **************************************************************
+        bool Add(const T &item)
+        /**
+         * Offer the next item of the stream; return true if it is kept.
+         */
+        {
+            const uint64_t index = nb_seen++;
+            if (index < capacity)
+            {
+                sample.push_back(item);
+                if (nb_seen == capacity)
+                {
+                    w    = Exp(Log(prng.Get_Random()) / double(capacity));
+                    next = index;
+                    Draw_Next();
+                }
+                return true;
+            }
+            if (index != next || capacity == 0)
+                return false;
+
+            sample[integers.Next_Bounded(capacity)] = item;
+            Draw_Next();
+            return true;
+        }
+
+        // **************************************************************
+        uint64_t Nb_To_Skip() const
+        /**
+         * Number of coming items that will not be kept.
+         */
+        {
+            if (nb_seen < capacity)
+                return 0;
+            if (capacity == 0)
+                return ~uint64_t(0);
+            return next - nb_seen;
+        }
+
+        // **************************************************************
+        void Skip(const uint64_t nb_items)
+        /**
+         * Count "nb_items" items as seen without offering them (at most
+         * Nb_To_Skip()).
+         */
+        {
+            assert(nb_items <= Nb_To_Skip());
+            nb_seen += nb_items;
+        }
+
+        const std::vector<T>   &Get_Sample() const     { return sample;  }
+        uint64_t                Get_Nb_Seen() const    { return nb_seen; }
+};
+
+#endif // INC_Sampling_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,90 @@
+
+#include <cassert>
+
+#include "Seed_Sequence.hpp"
+
+// SplitMix64's increment: 2^64 / golden ratio, odd
+const uint64_t golden_gamma = (uint64_t(0x9e3779b9) << 32) | uint64_t(0x7f4a7c15);
+
+// **************************************************************
+static inline uint64_t Mix64(uint64_t z)
+/**
+ * SplitMix64's finalizer: a bijection of 64-bit integers where every
+ * input bit affects every output bit.
+ */
+{
+    z = (z ^ (z >> 30)) * ((uint64_t(0xbf58476d) << 32) | uint64_t(0x1ce4e5b9));
+    z = (z ^ (z >> 27)) * ((uint64_t(0x94d049bb) << 32) | uint64_t(0x133111eb));
+    return z ^ (z >> 31);
+}
+
+// **************************************************************
+Seed_Sequence::Seed_Sequence(const uint64_t seed)
+{
+    const uint32_t words[2] = {uint32_t(seed), uint32_t(seed >> 32)};
+    Absorb(words, 2);
+}
+
+// **************************************************************
+Seed_Sequence::Seed_Sequence(const uint64_t seed_high, const uint64_t seed_low)
+{
+    const uint32_t words[4] = {uint32_t(seed_low),  uint32_t(seed_low >> 32),
+                               uint32_t(seed_high), uint32_t(seed_high >> 32)};
+    Absorb(words, 4);
+}
+
+// **************************************************************
+Seed_Sequence::Seed_Sequence(const uint32_t *seed_array, const int length)
+{
+    assert(length >= 0);
+    Absorb(seed_array, length);
+}
+
+// **************************************************************
+void Seed_Sequence::Absorb(const uint32_t *words, const int length)
+/**
+ * Hash the seed's words into the 128 bits key, in two lanes with
+ * different constants. The length is hashed too, so trailing zero
+ * words still give a different key.
+ */
+{
+    key[0] = Mix64(uint64_t(length) * golden_gamma);
+    key[1] = Mix64(key[0] + golden_gamma);
+    for (int i = 0 ; i < length ; i++)
+    {
+        key[0] = Mix64(key[0] ^ (uint64_t(words[i]) + golden_gamma));
+        key[1] = Mix64(key[1] + (uint64_t(words[i]) << 32) + golden_gamma);
+    }
+}
+
+// **************************************************************
+uint64_t Seed_Sequence::Stream_Seed(const uint64_t stream) const
+/**
+ * Return the 64-bit seed of stream number "stream". Different streams
+ * of a sequence always get different seeds (for a given key, this is
+ * a bijection of "stream").
+ */
+{
+    return Mix64(key[0] + Mix64(key[1] ^ ((stream + 1) * golden_gamma)));
+}
+
+// **************************************************************
+void Seed_Sequence::Generate(uint32_t *words, const int n, const uint64_t stream) const
+/**
+ * Fill "words" with "n" 32-bit words derived from stream "stream"'s
+ * seed (a SplitMix64 sequence), e.g. as a key for
+ * PRNG::Initialize_By_Array().
+ */
+{
+    uint64_t state = Stream_Seed(stream);
+    for (int i = 0 ; i < n ; i += 2)
+    {
+        state += golden_gamma;
+        const uint64_t z = Mix64(state);
+        words[i] = uint32_t(z);
+        if (i + 1 < n)
+            words[i+1] = uint32_t(z >> 32);
+    }
+}
+
+// ********** End of file ***************************************
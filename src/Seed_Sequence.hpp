@@ -0,0 +1,30 @@
+#ifndef INC_Seed_Sequence_hpp
+#define INC_Seed_Sequence_hpp
+
+#include <stdint.h> // (u)int64_t
+
+// **************************************************************
+// Seed sequence: turns a seed of any size (64 bits, 128 bits or an
+// array of 32-bit words) into well-mixed 64-bit seeds, one per
+// stream, so millions of generators can be initialized from a single
+// seed without correlated states (see PRNG::Initialize(const
+// Seed_Sequence &, ...) and PRNG::Initialize_Array()).
+// The seed is absorbed as 32-bit words (a 64-bit seed is its low
+// then high word), so the same words always give the same streams.
+class Seed_Sequence
+{
+    uint64_t key[2];
+
+    void        Absorb(const uint32_t *words, const int length);
+
+    public:
+        explicit     Seed_Sequence(const uint64_t seed = 0);
+                     Seed_Sequence(const uint64_t seed_high, const uint64_t seed_low);
+                     Seed_Sequence(const uint32_t *seed_array, const int length);
+        uint64_t    Stream_Seed(const uint64_t stream) const;
+        void        Generate(uint32_t *words, const int n, const uint64_t stream = 0) const;
+};
+
+#endif // INC_Seed_Sequence_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,240 @@
+
+#include <cassert>
+#include <algorithm> // std::swap()
+#include <vector>
+#include <pthread.h>
+
+#include <StdCout.hpp>
+
+#include "Shuffle.hpp"
+#include "Random_Integers.hpp"
+
+// **************************************************************
+template <class T>
+static void Fisher_Yates(Random_Integers &integers, T *array, const uint64_t n)
+/**
+ * Fisher-Yates shuffle. The swap targets only depend on the step, so
+ * they are drawn "lookahead" steps in advance (in the same order) and
+ * their cache lines prefetched: beyond the caches each step is
+ * otherwise a full memory latency.
+ */
+{
+    const uint64_t lookahead = 16;
+    uint64_t targets[lookahead];
+    for (uint64_t k = 0 ; k < lookahead && k + 1 < n ; k++)
+    {
+        targets[k] = integers.Next_Bounded(n - k);
+        __builtin_prefetch(&array[targets[k]], 1);
+    }
+    for (uint64_t i = n ; i > 1 ; i--)
+    {
+        const uint64_t slot = (n - i) % lookahead;
+        const uint64_t j    = targets[slot];
+        if (i > lookahead + 1)
+        {
+            targets[slot] = integers.Next_Bounded(i - lookahead);
+            __builtin_prefetch(&array[targets[slot]], 1);
+        }
+        std::swap(array[i - 1], array[j]);
+    }
+}
+
+// **************************************************************
+template <class T>
+static void Merge(Random_Integers &integers, T *array, const uint64_t middle, const uint64_t n)
+/**
+ * Merge the shuffled [0, middle[ and [middle, n[ into a shuffled
+ * [0, n[ (Bacher, Bodini, Hollender & Lumbroso, "MergeShuffle", 2015):
+ * one random bit per position chooses the next entry's half until one
+ * half is exhausted and the next bit would still take from it, then
+ * the rest is inserted with Fisher-Yates.
+ */
+{
+    uint64_t i = 0;
+    uint64_t j = middle;
+    // Both halves non-empty: branchless (with masks, as the bits are
+    // unpredictable) for as many steps as neither half can run out. The
+    // second half's entry is kept in a register, reading ahead.
+    while (i < j && j + 1 < n)
+    {
+        uint64_t bits = integers.Next_Uint64();
+        const uint64_t nb_steps = std::min(std::min(j - i, n - j - 1), uint64_t(64));
+        T second = array[j];
+        for (uint64_t s = 0 ; s < nb_steps ; s++, bits >>= 1)
+        {
+            const uint64_t bit  = bits & 1;
+            const T mask        = T(0) - T(bit);
+            const T first       = array[i];
+            const T next        = array[j + 1];
+            const T difference  = (first ^ second) & mask;
+            array[i]  = first  ^ difference;
+            array[j]  = second ^ difference;
+            second   ^= (second ^ next) & mask;
+            j += bit;
+            i++;
+        }
+    }
+    // A half is exhausted: flip until a bit chooses it
+    while (true)
+    {
+        if (integers.Next_Bit())
+        {
+            if (j == n)
+                break;
+            std::swap(array[i], array[j]);
+            j++;
+        }
+        else if (i == j)
+            break;
+        i++;
+    }
+    for ( ; i < n ; i++)
+        std::swap(array[i], array[integers.Next_Bounded(i + 1)]);
+}
+
+// **************************************************************
+// One level of a MergeShuffle, split between threads. Task t (a
+// chunk's shuffle on level 0, a merge of two runs of "width" entries
+// above) draws from stream level*nb_tasks + t of "seeds", whichever
+// thread runs it.
+template <class T>
+struct Shuffle_Level
+{
+    T                   *array;
+    uint64_t             n;
+    uint64_t             width;
+    int                  level;
+    uint64_t             nb_chunks;
+    const Seed_Sequence *seeds;
+    int                  thread;
+    int                  nb_threads;
+};
+
+// **************************************************************
+template <class T>
+static void *Shuffle_Level_Worker(void *shuffle_level)
+{
+    const Shuffle_Level<T> &task = *(Shuffle_Level<T> *) shuffle_level;
+    const uint64_t run = (task.level == 0 ? task.width : 2 * task.width);
+    const uint64_t nb_tasks = (task.n + run - 1) / run;
+    for (uint64_t t = uint64_t(task.thread) ; t < nb_tasks ; t += uint64_t(task.nb_threads))
+    {
+        const uint64_t begin = t * run;
+        const uint64_t size  = std::min(run, task.n - begin);
+        if (task.level > 0 && size <= task.width)
+            continue; // No second half to merge with
+
+        PRNG prng;
+        prng.Initialize(*task.seeds, uint64_t(task.level) * task.nb_chunks + t, true); // quiet = true
+        Random_Integers integers(prng);
+        if (task.level == 0)
+            Fisher_Yates(integers, &task.array[begin], size);
+        else
+            Merge(integers, &task.array[begin], task.width, size);
+    }
+    return NULL;
+}
+
+// **************************************************************
+template <class T>
+static void Shuffle_Array(PRNG &prng, T *array, const uint64_t n, const int nb_threads, const uint64_t chunk_size)
+{
+    assert(nb_threads >= 1);
+    assert(chunk_size >= 1);
+
+    Random_Integers integers(prng);
+    if (nb_threads == 1 || n <= chunk_size)
+    {
+        Fisher_Yates(integers, array, n);
+        return;
+    }
+
+    // The chunks and merges draw from their own streams, seeded from
+    // "prng": the same state gives the same shuffle
+    const uint64_t seed_high = integers.Next_Uint64();
+    const uint64_t seed_low  = integers.Next_Uint64();
+    const Seed_Sequence seeds(seed_high, seed_low);
+    const uint64_t nb_chunks = (n + chunk_size - 1) / chunk_size;
+
+    std::vector<Shuffle_Level<T> > tasks(nb_threads);
+    std::vector<pthread_t> threads(nb_threads);
+    int level = 0;
+    for (uint64_t width = chunk_size ; level == 0 || width < n ; level++)
+    {
+        for (int t = 0 ; t < nb_threads ; t++)
+        {
+            tasks[t].array      = array;
+            tasks[t].n          = n;
+            tasks[t].width      = width;
+            tasks[t].level      = level;
+            tasks[t].nb_chunks  = nb_chunks;
+            tasks[t].seeds      = &seeds;
+            tasks[t].thread     = t;
+            tasks[t].nb_threads = nb_threads;
+        }
+
+        // The calling thread takes the first tasks
+        for (int t = 1 ; t < nb_threads ; t++)
+        {
+            if (pthread_create(&threads[t], NULL, Shuffle_Level_Worker<T>, &tasks[t]) != 0)
+            {
+                std_cout << "prng::Shuffle(): Couldn't start a thread. Aborting.\n" << std::flush;
+                abort();
+            }
+        }
+        Shuffle_Level_Worker<T>(&tasks[0]);
+        for (int t = 1 ; t < nb_threads ; t++)
+            pthread_join(threads[t], NULL);
+
+        if (level > 0)
+            width *= 2;
+    }
+}
+
+// **************************************************************
+template <class T>
+static void Permutation(PRNG &prng, T *array, const uint64_t n, const int nb_threads, const uint64_t chunk_size)
+{
+    for (uint64_t i = 0 ; i < n ; i++)
+        array[i] = T(i);
+    Shuffle_Array(prng, array, n, nb_threads, chunk_size);
+}
+
+namespace prng
+{
+// **************************************************************
+void Shuffle(PRNG &prng, uint32_t *array, const uint64_t n, const int nb_threads, const uint64_t chunk_size)
+/**
+ * Shuffle "array" uniformly at random.
+ *
+ * @param   prng        Generator
+ * @param   array       Array to shuffle
+ * @param   n           Number of entries
+ * @param   nb_threads  Number of threads (including the calling one) [default: 1]
+ * @param   chunk_size  Entries shuffled in cache before the merges [default: shuffle_chunk_size]
+ */
+{
+    Shuffle_Array(prng, array, n, nb_threads, chunk_size);
+}
+
+// **************************************************************
+void Shuffle(PRNG &prng, uint64_t *array, const uint64_t n, const int nb_threads, const uint64_t chunk_size)
+{
+    Shuffle_Array(prng, array, n, nb_threads, chunk_size);
+}
+
+// **************************************************************
+void Random_Permutation(PRNG &prng, uint32_t *array, const uint64_t n, const int nb_threads, const uint64_t chunk_size)
+{
+    assert(n <= uint64_t(~uint32_t(0)) + 1);
+    Permutation(prng, array, n, nb_threads, chunk_size);
+}
+
+// **************************************************************
+void Random_Permutation(PRNG &prng, uint64_t *array, const uint64_t n, const int nb_threads, const uint64_t chunk_size)
+{
+    Permutation(prng, array, n, nb_threads, chunk_size);
+}
+} // namespace prng
+
+// ********** End of file ***************************************
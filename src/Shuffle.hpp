@@ -0,0 +1,36 @@
+#ifndef INC_Shuffle_hpp
+#define INC_Shuffle_hpp
+
+#include <stdint.h> // (u)int64_t
+
+#include "PseudoRandomNumberGenerator.hpp"
+
+// **************************************************************
+// Uniform random shuffles driven by a PRNG. With one thread, or up to
+// "chunk_size" entries (prng::shuffle_chunk_size by default; a small
+// one runs the merges on small arrays, as the tests do), Fisher-Yates
+// with unbiased bounded integers (Random_Integers). Otherwise MergeShuffle: chunks shuffled
+// in cache, then merged pairwise, the chunks and the merges of a level
+// being done concurrently; the result only depends on the PRNG's state,
+// not on the number of threads (as long as there are two or more).
+// Each merge level is a pass over the array: single-threaded,
+// Fisher-Yates is faster.
+namespace prng
+{
+    const uint64_t shuffle_chunk_size = uint64_t(1) << 16;
+
+    void Shuffle(PRNG &prng, uint32_t *array, const uint64_t n, const int nb_threads = 1,
+                 const uint64_t chunk_size = shuffle_chunk_size);
+    void Shuffle(PRNG &prng, uint64_t *array, const uint64_t n, const int nb_threads = 1,
+                 const uint64_t chunk_size = shuffle_chunk_size);
+
+    // Fill "array" with a random permutation of 0 to n-1
+    void Random_Permutation(PRNG &prng, uint32_t *array, const uint64_t n, const int nb_threads = 1,
+                            const uint64_t chunk_size = shuffle_chunk_size);
+    void Random_Permutation(PRNG &prng, uint64_t *array, const uint64_t n, const int nb_threads = 1,
+                            const uint64_t chunk_size = shuffle_chunk_size);
+}
+
+#endif // INC_Shuffle_hpp
+
+// ********** End of file ***************************************
@@ -0,0 +1,14 @@
+#ifndef INC_Sobol_Direction_Numbers_hpp
+#define INC_Sobol_Direction_Numbers_hpp
+
+#include <stdint.h> // (u)int32_t
+
+// Joe & Kuo's direction numbers, see Sobol_Direction_Numbers.cpp
+const int sobol_max_dimension   = 1024;
+const int sobol_max_degree      = 13;
+extern const uint16_t sobol_polynomials[sobol_max_dimension];
+extern const uint16_t sobol_initial_numbers[sobol_max_dimension][sobol_max_degree];
+
+#endif // INC_Sobol_Direction_Numbers_hpp
+
+// ********** End of file ***************************************
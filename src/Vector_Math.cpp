@@ -0,0 +1,362 @@
+
+// The kernels must give the same results on every ISA: a*b+c must not
+// be contracted into a fused multiply-add (GCC does by default when
+// the target has FMA, e.g. with -march=native).
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#include <cstring> // memcpy()
+#include <cmath>   // std::sqrt()
+#include <limits>
+
+#include "SIMD_Ops.hpp"
+#include "Vector_Math.hpp"
+
+// Round to nearest integer: adding and subtracting 1.5*2^52 (valid for
+// |x| < 2^51); the integer is then in the sum's low mantissa bits.
+static const double round_magic = 6755399441055744.0;
+
+// **************************************************************
+template <class V>
+static inline typename Ops<V>::Integer Double_To_Int(const V integral)
+/**
+ * Two's complement 64-bit integer of an integral double, |x| < 2^51.
+ */
+{
+    typedef Ops<V> O;
+    return O::Sub64(O::Bits(O::Add(integral, O::Set(round_magic))), O::Bits(O::Set(round_magic)));
+}
+
+// **************************************************************
+template <class V>
+static inline V Int_To_Double(const typename Ops<V>::Integer k)
+{
+    typedef Ops<V> O;
+    return O::Sub(O::From_Bits(O::Add64(k, O::Bits(O::Set(round_magic)))), O::Set(round_magic));
+}
+
+// **************************************************************
+template <class V>
+static inline V Pow2(const V k)
+/**
+ * 2^k for an integral k in [-1022, 1023].
+ */
+{
+    typedef Ops<V> O;
+    return O::From_Bits(O::Shift_Left64(O::Add64(Double_To_Int(k), O::Set64(1023)), 52));
+}
+
+// **************************************************************
+template <class V>
+static inline V Log_Kernel(const V x_in)
+/**
+ * Natural logarithm (fdlibm/musl's e_log.c without branches): with
+ * x = 2^k (1+f), 1+f in [sqrt(2)/2, sqrt(2)[ and s = f/(2+f),
+ * log(1+f) = f - f^2/2 + s (f^2/2 + R(s^2)).
+ */
+{
+    typedef Ops<V> O;
+    typedef typename O::Integer I;
+    typedef typename O::Mask    M;
+    const double ln2_hi = 6.93147180369123816490e-01;
+    const double ln2_lo = 1.90821492927058770002e-10;
+    const double Lg1    = 6.666666666666735130e-01;
+    const double Lg2    = 3.999999999940941908e-01;
+    const double Lg3    = 2.857142874366239149e-01;
+    const double Lg4    = 2.222219843214978396e-01;
+    const double Lg5    = 1.818357216161805012e-01;
+    const double Lg6    = 1.531383769920937332e-01;
+    const double Lg7    = 1.479819860511658591e-01;
+
+    // Subnormals are scaled by 2^54 first
+    const M subnormal = O::Less(x_in, O::Set(std::numeric_limits<double>::min()));
+    const V x = O::Select(subnormal, O::Mul(x_in, O::Set(18014398509481984.0)), x_in);
+
+    // Exponent and mantissa, moved so the mantissa is in [sqrt(2)/2, sqrt(2)[
+    const uint64_t sqrt2_high = 0x3fe6a09e; // High word of sqrt(2)/2
+    I bits = O::Add64(O::Bits(x), O::Set64(uint64_t(0x3ff00000 - sqrt2_high) << 32));
+    const I k = O::Sub64(O::Shift_Right64(bits, 52), O::Set64(0x3ff));
+    bits = O::Add64(O::And64(bits, O::Set64((uint64_t(1) << 52) - 1)), O::Set64(sqrt2_high << 32));
+    const V f  = O::Sub(O::From_Bits(bits), O::Set(1.0));
+    const V dk = O::Sub(Int_To_Double<V>(k), O::Select(subnormal, O::Set(54.0), O::Set(0.0)));
+
+    const V s    = O::Div(f, O::Add(O::Set(2.0), f));
+    const V z    = O::Mul(s, s);
+    const V w    = O::Mul(z, z);
+    const V t1   = O::Mul(w, O::Add(O::Set(Lg2), O::Mul(w, O::Add(O::Set(Lg4), O::Mul(w, O::Set(Lg6))))));
+    const V t2   = O::Mul(z, O::Add(O::Set(Lg1), O::Mul(w, O::Add(O::Set(Lg3), O::Mul(w, O::Add(O::Set(Lg5), O::Mul(w, O::Set(Lg7))))))));
+    const V R    = O::Add(t2, t1);
+    const V hfsq = O::Mul(O::Mul(O::Set(0.5), f), f);
+    V y = O::Add(O::Mul(s, O::Add(hfsq, R)), O::Mul(dk, O::Set(ln2_lo)));
+    y = O::Sub(y, hfsq);
+    y = O::Add(y, f);
+    y = O::Add(y, O::Mul(dk, O::Set(ln2_hi)));
+
+    // log(+inf) = +inf, log(0) = -inf, log(x < 0) = log(NaN) = NaN
+    const double infinity = std::numeric_limits<double>::infinity();
+    y = O::Select(O::Equal(x_in, O::Set(infinity)), x_in, y);
+    y = O::Select(O::Equal(x_in, O::Set(0.0)), O::Set(-infinity), y);
+    y = O::Select(O::Not_Greater_Equal(x_in, O::Set(0.0)), O::Set(std::numeric_limits<double>::quiet_NaN()), y);
+    return y;
+}
+
+// **************************************************************
+template <class V>
+static inline V Exp_Kernel(const V x_in)
+/**
+ * Exponential (fdlibm/musl's e_exp.c without branches): with
+ * x = k ln(2) + r, |r| <= ln(2)/2, e^r = 1 + r + r c/(2-c) where c is
+ * a minimax polynomial, then scaled by 2^k in two factors so that
+ * subnormal results are rounded once.
+ */
+{
+    typedef Ops<V> O;
+    const double ln2_hi = 6.93147180369123816490e-01;
+    const double ln2_lo = 1.90821492927058770002e-10;
+    const double invln2 = 1.44269504088896338700e+00;
+    const double P1     =  1.66666666666666019037e-01;
+    const double P2     = -2.77777777770155933842e-03;
+    const double P3     =  6.61375632143793436117e-05;
+    const double P4     = -1.65339022054652515390e-06;
+    const double P5     =  4.13813679705723846039e-08;
+
+    // e^x overflows above 709.79 and is 0 below -745.14
+    V x = O::Select(O::Less(x_in, O::Set(-746.0)), O::Set(-746.0), x_in);
+    x   = O::Select(O::Less(O::Set(710.0), x), O::Set(710.0), x);
+
+    const V k  = O::Sub(O::Add(O::Mul(x, O::Set(invln2)), O::Set(round_magic)), O::Set(round_magic));
+    const V hi = O::Sub(x, O::Mul(k, O::Set(ln2_hi))); // Exact: ln2_hi has 21 trailing zeros
+    const V lo = O::Mul(k, O::Set(ln2_lo));
+    const V r  = O::Sub(hi, lo);
+    const V rr = O::Mul(r, r);
+    const V c  = O::Sub(r, O::Mul(rr, O::Add(O::Set(P1), O::Mul(rr, O::Add(O::Set(P2), O::Mul(rr,
+                        O::Add(O::Set(P3), O::Mul(rr, O::Add(O::Set(P4), O::Mul(rr, O::Set(P5)))))))))));
+    V y = O::Add(O::Set(1.0), O::Add(O::Sub(O::Div(O::Mul(r, c), O::Sub(O::Set(2.0), c)), lo), hi));
+
+    const V k1 = O::Sub(O::Add(O::Mul(k, O::Set(0.5)), O::Set(round_magic)), O::Set(round_magic));
+    const V k2 = O::Sub(k, k1);
+    y = O::Mul(O::Mul(y, Pow2(k1)), Pow2(k2));
+
+    // NaN stays NaN
+    return O::Select(O::Equal(x_in, x_in), y, x_in);
+}
+
+// **************************************************************
+template <class V>
+static inline void Sincos_Kernel(const V x, V &sine, V &cosine)
+/**
+ * Sine and cosine: x = n pi/2 + y (musl's __rem_pio2 with all three
+ * rounds of its medium case, y as y0 + y1), then fdlibm's kernels on
+ * y, swapped and negated by quadrant.
+ */
+{
+    typedef Ops<V> O;
+    typedef typename O::Integer I;
+    const double invpio2 = 6.36619772367581382433e-01;
+    const double pio2_2  = 6.07710050630396597660e-11;
+    const double pio2_2t = 2.02226624879595063154e-21;
+    const double pio2_3  = 2.02226624871116645580e-21;
+    const double pio2_3t = 8.47842766036889956997e-32;
+    const double pio2_1  = 1.57079632673412561417e+00;
+    const double S1 = -1.66666666666666324348e-01;
+    const double S2 =  8.33333333332248946124e-03;
+    const double S3 = -1.98412698298579493134e-04;
+    const double S4 =  2.75573137070700676789e-06;
+    const double S5 = -2.50507602534068634195e-08;
+    const double S6 =  1.58969099521155010221e-10;
+    const double C1 =  4.16666666666666019037e-02;
+    const double C2 = -1.38888888888741095749e-03;
+    const double C3 =  2.48015872894767294178e-05;
+    const double C4 = -2.75573143513906633035e-07;
+    const double C5 =  2.08757232129817482790e-09;
+    const double C6 = -1.13596475577881948265e-11;
+
+    const V t  = O::Add(O::Mul(x, O::Set(invpio2)), O::Set(round_magic));
+    const V fn = O::Sub(t, O::Set(round_magic));
+    const I n  = O::Sub64(O::Bits(t), O::Bits(O::Set(round_magic)));
+
+    V r = O::Sub(x, O::Mul(fn, O::Set(pio2_1)));
+    V previous = r;
+    V w = O::Mul(fn, O::Set(pio2_2));
+    r = O::Sub(previous, w);
+    w = O::Sub(O::Mul(fn, O::Set(pio2_2t)), O::Sub(O::Sub(previous, r), w));
+    previous = r;
+    w = O::Mul(fn, O::Set(pio2_3));
+    r = O::Sub(previous, w);
+    w = O::Sub(O::Mul(fn, O::Set(pio2_3t)), O::Sub(O::Sub(previous, r), w));
+    const V y0 = O::Sub(r, w);
+    const V y1 = O::Sub(O::Sub(r, y0), w);
+
+    // Kernels on [-pi/4, pi/4]
+    const V z  = O::Mul(y0, y0);
+    const V zz = O::Mul(z, z);
+    const V v  = O::Mul(z, y0);
+    const V rs = O::Add(O::Set(S2), O::Mul(z, O::Add(O::Set(S3), O::Mul(z, O::Add(O::Set(S4), O::Mul(z, O::Add(O::Set(S5), O::Mul(z, O::Set(S6)))))))));
+    const V ks = O::Sub(y0, O::Sub(O::Sub(O::Mul(z, O::Sub(O::Mul(O::Set(0.5), y1), O::Mul(v, rs))), y1), O::Mul(v, O::Set(S1))));
+    const V rc = O::Add(O::Mul(z, O::Add(O::Set(C1), O::Mul(z, O::Add(O::Set(C2), O::Mul(z, O::Set(C3)))))),
+                        O::Mul(O::Mul(zz, zz), O::Add(O::Set(C4), O::Mul(z, O::Add(O::Set(C5), O::Mul(z, O::Set(C6)))))));
+    const V hz = O::Mul(O::Set(0.5), z);
+    const V wc = O::Sub(O::Set(1.0), hz);
+    const V kc = O::Add(wc, O::Add(O::Sub(O::Sub(O::Set(1.0), wc), hz), O::Sub(O::Mul(z, rc), O::Mul(y0, y1))));
+
+    // Quadrant n: (sin, cos)(x) = (s, c), (c, -s), (-s, -c) or (-c, s)
+    const typename O::Mask odd = O::Mask_From_Bit(O::And64(n, O::Set64(1)));
+    sine   = O::Select(odd, kc, ks);
+    cosine = O::Select(odd, ks, kc);
+    sine   = O::From_Bits(O::Xor64(O::Bits(sine),   O::Shift_Left64(O::And64(n, O::Set64(2)), 62)));
+    cosine = O::From_Bits(O::Xor64(O::Bits(cosine), O::Shift_Left64(O::And64(O::Add64(n, O::Set64(1)), O::Set64(2)), 62)));
+
+    // Infinities and NaN give NaN
+    const V magnitude = O::From_Bits(O::And64(O::Bits(x), O::Set64(~uint64_t(0) >> 1)));
+    const typename O::Mask finite = O::Less(magnitude, O::Set(std::numeric_limits<double>::infinity()));
+    sine   = O::Select(finite, sine,   O::Set(std::numeric_limits<double>::quiet_NaN()));
+    cosine = O::Select(finite, cosine, O::Set(std::numeric_limits<double>::quiet_NaN()));
+}
+
+// **************************************************************
+template <class V>
+static inline void Box_Muller_Kernel(const V u1, const V u2, const double mean, const double std_dev, V &z0, V &z1)
+{
+    typedef Ops<V> O;
+    const double two_pi = 6.28318530717958647692;
+    const V radius = O::Sqrt(O::Mul(O::Set(-2.0), Log_Kernel(u1)));
+    V sine, cosine;
+    Sincos_Kernel(O::Mul(O::Set(two_pi), u2), sine, cosine);
+    z0 = O::Add(O::Set(mean), O::Mul(O::Set(std_dev), O::Mul(radius, cosine)));
+    z1 = O::Add(O::Set(mean), O::Mul(O::Set(std_dev), O::Mul(radius, sine)));
+}
+
+namespace prng
+{
+// **************************************************************
+double Log(const double x)
+{
+    return Log_Kernel(x);
+}
+
+// **************************************************************
+double Exp(const double x)
+{
+    return Exp_Kernel(x);
+}
+
+// **************************************************************
+void Sincos(const double x, double &sine, double &cosine)
+{
+    Sincos_Kernel(x, sine, cosine);
+}
+
+// **************************************************************
+double Sqrt(const double x)
+{
+    return std::sqrt(x);
+}
+
+// **************************************************************
+void Box_Muller(const double u1, const double u2, const double mean, const double std_dev,
+                double &z0, double &z1)
+{
+    Box_Muller_Kernel(u1, u2, mean, std_dev, z0, z1);
+}
+
+// **************************************************************
+void Log_Array(const double *x, double *y, const uint64_t n)
+{
+    uint64_t i = 0;
+#ifdef PRNG_SIMD
+    typedef Ops<Double_Vector> O;
+    for ( ; i + O::lanes <= n ; i += O::lanes)
+        O::Store(&y[i], Log_Kernel(O::Load(&x[i])));
+#endif // #ifdef PRNG_SIMD
+    for ( ; i < n ; i++)
+        y[i] = Log_Kernel(x[i]);
+}
+
+// **************************************************************
+void Exp_Array(const double *x, double *y, const uint64_t n)
+{
+    uint64_t i = 0;
+#ifdef PRNG_SIMD
+    typedef Ops<Double_Vector> O;
+    for ( ; i + O::lanes <= n ; i += O::lanes)
+        O::Store(&y[i], Exp_Kernel(O::Load(&x[i])));
+#endif // #ifdef PRNG_SIMD
+    for ( ; i < n ; i++)
+        y[i] = Exp_Kernel(x[i]);
+}
+
+// **************************************************************
+void Sincos_Array(const double *x, double *sines, double *cosines, const uint64_t n)
+{
+    uint64_t i = 0;
+#ifdef PRNG_SIMD
+    typedef Ops<Double_Vector> O;
+    for ( ; i + O::lanes <= n ; i += O::lanes)
+    {
+        Double_Vector sine, cosine;
+        Sincos_Kernel(O::Load(&x[i]), sine, cosine);
+        O::Store(&sines[i], sine);
+        O::Store(&cosines[i], cosine);
+    }
+#endif // #ifdef PRNG_SIMD
+    for ( ; i < n ; i++)
+        Sincos_Kernel(x[i], sines[i], cosines[i]);
+}
+
+// **************************************************************
+void Sqrt_Array(const double *x, double *y, const uint64_t n)
+{
+    uint64_t i = 0;
+#ifdef PRNG_SIMD
+    typedef Ops<Double_Vector> O;
+    for ( ; i + O::lanes <= n ; i += O::lanes)
+        O::Store(&y[i], O::Sqrt(O::Load(&x[i])));
+#endif // #ifdef PRNG_SIMD
+    for ( ; i < n ; i++)
+        y[i] = std::sqrt(x[i]);
+}
+
+// **************************************************************
+void Box_Muller_Array(const double *u1, const double *u2, const double mean, const double std_dev,
+                      double *normals, const uint64_t nb_pairs)
+{
+    uint64_t i = 0;
+#ifdef PRNG_SIMD
+    typedef Ops<Double_Vector> O;
+    for ( ; i + O::lanes <= nb_pairs ; i += O::lanes)
+    {
+        Double_Vector z0, z1;
+        Box_Muller_Kernel(O::Load(&u1[i]), O::Load(&u2[i]), mean, std_dev, z0, z1);
+        double z0s[O::lanes], z1s[O::lanes];
+        O::Store(z0s, z0);
+        O::Store(z1s, z1);
+        for (int l = 0 ; l < O::lanes ; l++)
+        {
+            normals[2*(i + l)]     = z0s[l];
+            normals[2*(i + l) + 1] = z1s[l];
+        }
+    }
+#endif // #ifdef PRNG_SIMD
+    for ( ; i < nb_pairs ; i++)
+        Box_Muller_Kernel(u1[i], u2[i], mean, std_dev, normals[2*i], normals[2*i + 1]);
+}
+
+// **************************************************************
+const char *Vector_Math_ISA()
+{
+#if defined(PRNG_SIMD_AVX512)
+    return "AVX-512";
+#elif defined(PRNG_SIMD_AVX2)
+    return "AVX2";
+#elif defined(PRNG_SIMD_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+} // namespace prng
+
+// ********** End of file ***************************************
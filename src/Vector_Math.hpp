@@ -0,0 +1,44 @@
+#ifndef INC_Vector_Math_hpp
+#define INC_Vector_Math_hpp
+
+#include <stdint.h> // (u)int64_t
+
+// **************************************************************
+// Transcendental kernels for the distribution transforms, written once
+// for a scalar reference and SIMD vectors (SSE2 with HAVE_SSE2, AVX2
+// and AVX-512 when the compiler targets them, e.g. -march=native).
+// All of them perform the same IEEE operations in the same order
+// (no FMA contraction), so the array functions give exactly the
+// scalar reference's results on every ISA, independently of libm.
+// log and exp are fdlibm's algorithms (< 1 ulp); sincos reduces the
+// argument with a three-part pi/2 (accurate for |x| < 2^20 pi/2) and
+// uses fdlibm's kernels; sqrt is the correctly rounded instruction.
+namespace prng
+{
+    // Scalar reference
+    double      Log(const double x);
+    double      Exp(const double x);
+    void        Sincos(const double x, double &sine, double &cosine);
+    double      Sqrt(const double x);
+
+    // Arrays of "n" values; the output can be the input
+    void        Log_Array(const double *x, double *y, const uint64_t n);
+    void        Exp_Array(const double *x, double *y, const uint64_t n);
+    void        Sincos_Array(const double *x, double *sines, double *cosines, const uint64_t n);
+    void        Sqrt_Array(const double *x, double *y, const uint64_t n);
+
+    // Box-Muller: a pair of independent normal numbers from u1 in ]0,1]
+    // and u2 in [0,1[, mean + std_dev * sqrt(-2 log(u1)) * (cos, sin)(2 pi u2)
+    void        Box_Muller(const double u1, const double u2, const double mean, const double std_dev,
+                           double &z0, double &z1);
+    // normals[2i], normals[2i+1] from u1[i], u2[i], for i < nb_pairs
+    void        Box_Muller_Array(const double *u1, const double *u2, const double mean, const double std_dev,
+                                 double *normals, const uint64_t nb_pairs);
+
+    // "AVX-512", "AVX2", "SSE2" or "scalar": the array functions' instructions
+    const char *Vector_Math_ISA();
+}
+
+#endif // INC_Vector_Math_hpp
+
+// ********** End of file ***************************************
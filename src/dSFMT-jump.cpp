@@ -0,0 +1,429 @@
+/**
+ * @file dSFMT-jump.cpp
+ * @brief Jump-ahead for dSFMT, see dSFMT/dSFMT-jump.hpp.
+ *
+ * Jumping by J words (matrix A^J) only needs a polynomial p(x) such
+ * that p(A) is zero: then A^J = g(A) with g(x) = x^J mod p(x). g(x) is
+ * computed by square and multiply, and g(A) applied by summing g_i A^i s
+ * over the steps of a copy of the state, as in dSFMT-jump.c.
+ *
+ * p(x) is found once per process, for any DSFMT_MEXP. Berlekamp-Massey
+ * gives the minimal polynomial of a bit sequence made from the words
+ * and lung of the states following a state. That polynomial can miss
+ * components of the state space (ones the bits don't see, or that the
+ * state has none of), so starting from random states, p(x) is
+ * multiplied by the minimal polynomial of the residual p(A) s until
+ * p(A) s is zero.
+ */
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "dSFMT/dSFMT-jump.hpp"
+
+/** annihilating polynomial and its 64 shifted copies, computed once */
+static struct {
+    dsfmt_poly_t poly;
+    int degree;
+    std::vector<uint64_t> shifted;
+    size_t shifted_words;
+    int ready;
+} minimal;
+static pthread_mutex_t minimal_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** random states whose residuals are used to complete the polynomial */
+static const int nb_random_states = 4;
+
+/**
+ * This function returns the next number of a SplitMix64 sequence.
+ */
+inline static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z;
+
+    *x += UINT64_C(0x9e3779b97f4a7c15);
+    z = *x;
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+/**
+ * This function returns 64 bits of \b a starting at bit \b pos.
+ */
+inline static uint64_t get_word(const uint64_t *a, uint64_t pos) {
+    const uint64_t w = pos >> 6;
+    const int b = int(pos & 63);
+    if (b == 0) {
+	return a[w];
+    }
+    return (a[w] >> b) | (a[w + 1] << (64 - b));
+}
+
+/**
+ * This function computes a ^= b << shift. \b a must hold the result.
+ */
+inline static void xor_shifted(uint64_t *a, const uint64_t *b,
+			       size_t b_words, uint64_t shift) {
+    const size_t w = size_t(shift >> 6);
+    const int s = int(shift & 63);
+    size_t i;
+
+    if (s == 0) {
+	for (i = 0; i < b_words; i++) {
+	    a[w + i] ^= b[i];
+	}
+    } else {
+	for (i = 0; i < b_words; i++) {
+	    a[w + i] ^= b[i] << s;
+	    a[w + i + 1] ^= b[i] >> (64 - s);
+	}
+    }
+}
+
+/**
+ * This function spreads the 32 lowest bits of \b x to the even bits:
+ * the square of a polynomial over GF(2).
+ */
+inline static uint64_t spread_bits(uint64_t x) {
+    x &= UINT64_C(0x00000000ffffffff);
+    x = (x | (x << 16)) & UINT64_C(0x0000ffff0000ffff);
+    x = (x | (x << 8)) & UINT64_C(0x00ff00ff00ff00ff);
+    x = (x | (x << 4)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+    x = (x | (x << 2)) & UINT64_C(0x3333333333333333);
+    x = (x | (x << 1)) & UINT64_C(0x5555555555555555);
+    return x;
+}
+
+/**
+ * This function adds the state \b src, whose oldest word is at \b pos,
+ * to \b dest, whose oldest word is at 0.
+ */
+inline static void add_state(dsfmt_t *dest, const dsfmt_t *src, int pos) {
+    int k;
+
+    for (k = 0; k < DSFMT_N - pos; k++) {
+	dest->status[k].u[0] ^= src->status[k + pos].u[0];
+	dest->status[k].u[1] ^= src->status[k + pos].u[1];
+    }
+    for (; k < DSFMT_N; k++) {
+	dest->status[k].u[0] ^= src->status[k + pos - DSFMT_N].u[0];
+	dest->status[k].u[1] ^= src->status[k + pos - DSFMT_N].u[1];
+    }
+    dest->status[DSFMT_N].u[0] ^= src->status[DSFMT_N].u[0];
+    dest->status[DSFMT_N].u[1] ^= src->status[DSFMT_N].u[1];
+}
+
+/**
+ * This function computes sum of poly_i A^i \b dsfmt, for i up to
+ * \b degree, into \b dsfmt.
+ */
+static void apply_poly(dsfmt_t *dsfmt, const dsfmt_poly_t &poly, int degree) {
+    dsfmt_t state;
+    dsfmt_t work;
+    int pos = 0;
+    int i;
+
+    memcpy(&state, dsfmt, sizeof(dsfmt_t));
+    memset(&work, 0, sizeof(dsfmt_t));
+
+    /* state is a circular buffer whose oldest word is at pos */
+    for (i = 0; i <= degree; i++) {
+	if ((poly[i >> 6] >> (i & 63)) & 1) {
+	    add_state(&work, &state, pos);
+	}
+	if (i < degree) {
+	    dsfmt_next_word(&state, pos);
+	    pos = (pos + 1) % DSFMT_N;
+	}
+    }
+
+    memcpy(dsfmt->status, work.status, sizeof(work.status));
+}
+
+/**
+ * This function returns 1 if all the words of the state are zero.
+ */
+static int is_zero(const dsfmt_t *dsfmt) {
+    int i;
+
+    for (i = 0; i <= DSFMT_N; i++) {
+	if (dsfmt->status[i].u[0] != 0 || dsfmt->status[i].u[1] != 0) {
+	    return 0;
+	}
+    }
+    return 1;
+}
+
+/**
+ * This function computes, with Berlekamp-Massey, the minimal
+ * polynomial of the parities of (word & mask[0..1]) ^ (lung & mask[2..3])
+ * over the steps from \b start. The lung is part of the functional
+ * since some of its components never reach the words. Twice the
+ * state's dimension in bits is always enough.
+ * @return the polynomial's degree.
+ */
+static int sequence_poly(const dsfmt_t *start, const uint64_t mask[4],
+			 dsfmt_poly_t &poly) {
+    const uint64_t size = 2 * 128 * uint64_t(DSFMT_N + 1);
+    const size_t nb_words = size_t(size / 64) + 4;
+    /* sequence in reverse order: bit k is s[size - 1 - k] */
+    std::vector<uint64_t> reversed(nb_words, 0);
+    std::vector<uint64_t> c(nb_words, 0);
+    std::vector<uint64_t> b(nb_words, 0);
+    std::vector<uint64_t> t(nb_words, 0);
+    dsfmt_t dsfmt;
+    uint64_t n, k;
+    uint64_t length = 0;
+    uint64_t m = 1;
+    uint64_t c_degree = 0;
+    uint64_t b_degree = 0;
+    size_t w;
+    int pos = 0;
+
+    /* one step per word, the oldest word being at pos */
+    memcpy(&dsfmt, start, sizeof(dsfmt_t));
+    for (n = 0; n < size; n++) {
+	const uint64_t u = (dsfmt.status[pos].u[0] & mask[0])
+	    ^ (dsfmt.status[pos].u[1] & mask[1])
+	    ^ (dsfmt.status[DSFMT_N].u[0] & mask[2])
+	    ^ (dsfmt.status[DSFMT_N].u[1] & mask[3]);
+	k = size - 1 - n;
+	reversed[k >> 6] |= uint64_t(__builtin_parityll(u)) << (k & 63);
+	dsfmt_next_word(&dsfmt, pos);
+	pos = (pos + 1) % DSFMT_N;
+    }
+
+    c[0] = 1;
+    b[0] = 1;
+    for (n = 0; n < size; n++) {
+	/* discrepancy: sum of c_i s[n - i] */
+	const uint64_t offset = size - 1 - n;
+	uint64_t d = 0;
+	for (w = 0; w <= c_degree / 64; w++) {
+	    d ^= c[w] & get_word(&reversed[0], offset + 64 * w);
+	}
+	if (__builtin_parityll(d) == 0) {
+	    m++;
+	    continue;
+	}
+
+	const size_t b_words = size_t(b_degree / 64) + 1;
+	const uint64_t new_degree = (b_degree + m > c_degree
+				     ? b_degree + m : c_degree);
+	if (2 * length <= n) {
+	    const size_t words = size_t(new_degree / 64) + 1;
+	    for (w = 0; w < words; w++) {
+		t[w] = c[w];
+	    }
+	    xor_shifted(&c[0], &b[0], b_words, m);
+	    for (w = 0; w < words; w++) {
+		b[w] = t[w];
+	    }
+	    b_degree = c_degree;
+	    length = n + 1 - length;
+	    m = 1;
+	} else {
+	    xor_shifted(&c[0], &b[0], b_words, m);
+	    m++;
+	}
+	c_degree = new_degree;
+    }
+
+    /* minimal polynomial: x^length c(1/x) */
+    poly.assign(size_t(length / 64) + 1, 0);
+    for (k = 0; k <= length; k++) {
+	if ((c[k >> 6] >> (k & 63)) & 1) {
+	    const uint64_t j = length - k;
+	    poly[j >> 6] |= uint64_t(1) << (j & 63);
+	}
+    }
+    return int(length);
+}
+
+/**
+ * This function computes the polynomial p(x) and its shifted copies.
+ */
+static void compute_minimal_poly(void) {
+    uint64_t seed = UINT64_C(0x5a17d5f7e6a1b2c3);
+    dsfmt_t state, residual;
+    dsfmt_poly_t factor;
+    uint64_t mask[4];
+    int i, j, f;
+
+    minimal.poly.assign(1, 1);
+    minimal.degree = 0;
+    for (i = 0; i < nb_random_states; i++) {
+	/* random state, exponent bits included */
+	for (j = 0; j <= DSFMT_N; j++) {
+	    state.status[j].u[0] = splitmix64(&seed);
+	    state.status[j].u[1] = splitmix64(&seed);
+	}
+	for (j = 0; ; j++) {
+	    assert(j < 64);
+	    memcpy(&residual, &state, sizeof(dsfmt_t));
+	    apply_poly(&residual, minimal.poly, minimal.degree);
+	    if (is_zero(&residual)) {
+		break;
+	    }
+	    for (f = 0; f < 4; f++) {
+		mask[f] = splitmix64(&seed);
+	    }
+	    const int factor_degree = sequence_poly(&residual, mask, factor);
+	    if (factor_degree == 0) {
+		continue;
+	    }
+
+	    /* p(x) = p(x) factor(x) */
+	    std::vector<uint64_t> product(size_t((minimal.degree + factor_degree) / 64) + 2, 0);
+	    for (f = 0; f <= factor_degree; f++) {
+		if ((factor[f >> 6] >> (f & 63)) & 1) {
+		    xor_shifted(&product[0], &minimal.poly[0],
+				minimal.poly.size(), uint64_t(f));
+		}
+	    }
+	    minimal.degree += factor_degree;
+	    product.resize(size_t(minimal.degree / 64) + 1);
+	    minimal.poly.swap(product);
+	}
+    }
+
+    /* p(x) x^s for s in [0, 64) to reduce modulo p(x) word by word */
+    minimal.shifted_words = minimal.poly.size() + 1;
+    minimal.shifted.assign(64 * minimal.shifted_words, 0);
+    for (i = 0; i < 64; i++) {
+	xor_shifted(&minimal.shifted[i * minimal.shifted_words],
+		    &minimal.poly[0], minimal.poly.size(), uint64_t(i));
+    }
+}
+
+/**
+ * This function returns the polynomial used for jumps: the minimal
+ * polynomial of dSFMT's recurrence (one step per 128-bit word), maybe
+ * times a few small factors. It is computed on the first call.
+ * Thread safe.
+ * @param degree if not NULL, set to the polynomial's degree.
+ * @return the polynomial, lowest degree first.
+ */
+const dsfmt_poly_t &dsfmt_minimal_poly(int *degree) {
+    pthread_mutex_lock(&minimal_mutex);
+    if (!minimal.ready) {
+	compute_minimal_poly();
+	minimal.ready = 1;
+    }
+    pthread_mutex_unlock(&minimal_mutex);
+    if (degree != NULL) {
+	*degree = minimal.degree;
+    }
+    return minimal.poly;
+}
+
+/**
+ * This function reduces \b a modulo p(x).
+ */
+static void reduce(std::vector<uint64_t> &a) {
+    const uint64_t degree = uint64_t(minimal.degree);
+    uint64_t i;
+
+    for (i = uint64_t(a.size()) * 64 - 1; i >= degree; i--) {
+	if ((a[i >> 6] >> (i & 63)) & 1) {
+	    const uint64_t s = i - degree;
+	    const uint64_t *p = &minimal.shifted[(s & 63) * minimal.shifted_words];
+	    uint64_t *r = &a[s >> 6];
+	    size_t w;
+	    for (w = 0; w < minimal.shifted_words && (s >> 6) + w < a.size(); w++) {
+		r[w] ^= p[w];
+	    }
+	}
+    }
+}
+
+/**
+ * This function computes r = r^2 mod p(x).
+ */
+static void square_mod(std::vector<uint64_t> &r, std::vector<uint64_t> &square,
+		       size_t poly_words) {
+    size_t w;
+
+    for (w = 0; w < poly_words; w++) {
+	square[2 * w] = spread_bits(r[w]);
+	square[2 * w + 1] = spread_bits(r[w] >> 32);
+    }
+    for (w = 2 * poly_words; w < square.size(); w++) {
+	square[w] = 0;
+    }
+    reduce(square);
+    r.swap(square);
+}
+
+/**
+ * This function computes the jump polynomial x^J mod p(x) to move a
+ * state forward by J = nb_blocks * 2^log2_factor * DSFMT_N words.
+ * \b log2_factor reaches jumps past 2^64 words, e.g. to separate
+ * substreams by 2^64 blocks.
+ * @param jump set to the jump polynomial.
+ * @param nb_blocks number of blocks to jump over.
+ * @param log2_factor nb_blocks is multiplied by 2^log2_factor.
+ */
+void dsfmt_calc_jump(dsfmt_poly_t &jump, uint64_t nb_blocks,
+		     int log2_factor) {
+    int degree;
+    dsfmt_minimal_poly(&degree);
+
+    assert(nb_blocks <= ~uint64_t(0) / uint64_t(DSFMT_N));
+    assert(log2_factor >= 0);
+    const uint64_t nb_words = nb_blocks * uint64_t(DSFMT_N);
+    const size_t poly_words = size_t(degree / 64) + 1;
+    std::vector<uint64_t> r(2 * poly_words + 2, 0);
+    std::vector<uint64_t> square(2 * poly_words + 2, 0);
+    size_t w;
+    int bit;
+
+    /* x^nb_words by square and multiply */
+    r[0] = 1;
+    for (bit = 63; bit >= 0; bit--) {
+	square_mod(r, square, poly_words);
+
+	/* r = r x mod p */
+	if ((nb_words >> bit) & 1) {
+	    for (w = r.size() - 1; w > 0; w--) {
+		r[w] = (r[w] << 1) | (r[w - 1] >> 63);
+	    }
+	    r[0] <<= 1;
+	    reduce(r);
+	}
+    }
+    /* x^(nb_words 2^log2_factor) = (x^nb_words)^(2^log2_factor) */
+    for (bit = 0; bit < log2_factor; bit++) {
+	square_mod(r, square, poly_words);
+    }
+
+    jump.assign(r.begin(), r.begin() + poly_words);
+}
+
+/**
+ * This function moves \b dsfmt forward by the number of words
+ * \b jump was computed for. The index in the block is kept.
+ * @param dsfmt dsfmt state vector.
+ * @param jump jump polynomial from dsfmt_calc_jump().
+ */
+void dsfmt_jump_by(dsfmt_t *dsfmt, const dsfmt_poly_t &jump) {
+    int degree;
+    dsfmt_minimal_poly(&degree);
+    apply_poly(dsfmt, jump, degree - 1);
+}
+
+/**
+ * This function moves \b dsfmt forward by \b nb_blocks blocks of
+ * DSFMT_N64 numbers, as if they had been generated. The index in the
+ * block is kept.
+ * @param dsfmt dsfmt state vector.
+ * @param nb_blocks number of blocks to jump over.
+ */
+void dsfmt_jump(dsfmt_t *dsfmt, uint64_t nb_blocks) {
+    if (nb_blocks == 0) {
+	return;
+    }
+    dsfmt_poly_t jump;
+    dsfmt_calc_jump(jump, nb_blocks);
+    dsfmt_jump_by(dsfmt, jump);
+}
@@ -271,6 +271,46 @@ inline static void gen_rand_array_c1o2(dsfmt_t *dsfmt, w128_t *array,
     dsfmt->status[DSFMT_N] = lung;
 }
 
+/**
+ * This function computes one 128-bit word, using the state as a
+ * circular buffer: word \b i is the oldest one and is replaced by the
+ * next one. Used to step the state one word at a time for jump-ahead.
+ * @param dsfmt dsfmt state vector.
+ * @param i index of the oldest word.
+ */
+void dsfmt_next_word(dsfmt_t *dsfmt, int i) {
+    do_recursion(&dsfmt->status[i], &dsfmt->status[i],
+		 &dsfmt->status[(i + DSFMT_POS1) % DSFMT_N],
+		 &dsfmt->status[DSFMT_N]);
+}
+
+/**
+ * This function computes the 128-bit words [first, last) of the block
+ * following the one in \b current, into \b next, without modifying
+ * \b current. Calling it for consecutive ranges covering 0 to DSFMT_N-1
+ * gives the same block as dsfmt_gen_rand_all(). The lung of \b next
+ * (next->status[DSFMT_N]) must be a copy of current's before the
+ * first word is computed.
+ * @param next dsfmt state vector receiving the next block.
+ * @param current dsfmt state vector holding the current block.
+ * @param first first word to compute.
+ * @param last one past the last word to compute.
+ */
+void dsfmt_gen_rand_words(dsfmt_t *next, dsfmt_t *current, int first,
+			  int last) {
+    int i;
+
+    for (i = first; i < last && i < DSFMT_N - DSFMT_POS1; i++) {
+	do_recursion(&next->status[i], &current->status[i],
+		     &current->status[i + DSFMT_POS1], &next->status[DSFMT_N]);
+    }
+    for (; i < last; i++) {
+	do_recursion(&next->status[i], &current->status[i],
+		     &next->status[i + DSFMT_POS1 - DSFMT_N],
+		     &next->status[DSFMT_N]);
+    }
+}
+
 /**
  * This function fills the user-specified array with double precision
  * floating point pseudorandom numbers of the IEEE 754 format.
@@ -524,6 +564,53 @@ void dsfmt_gen_rand_all(dsfmt_t *dsfmt) {
     dsfmt->status[DSFMT_N] = lung;
 }
 
+/**
+ * This function represents the recursion formula in standard C,
+ * whatever the SIMD instruction set the library is compiled for. It
+ * is the reference do_recursion() is checked against.
+ * @param r output 128-bit
+ * @param a a 128-bit part of the internal state array
+ * @param b a 128-bit part of the internal state array
+ * @param lung a 128-bit part of the internal state array (I/O)
+ */
+inline static void do_recursion_reference(w128_t *r, w128_t *a,
+					  w128_t * b, w128_t *lung) {
+    uint64_t t0, t1, L0, L1;
+
+    t0 = a->u[0];
+    t1 = a->u[1];
+    L0 = lung->u[0];
+    L1 = lung->u[1];
+    lung->u[0] = (t0 << DSFMT_SL1) ^ (L1 >> 32) ^ (L1 << 32) ^ b->u[0];
+    lung->u[1] = (t1 << DSFMT_SL1) ^ (L0 >> 32) ^ (L0 << 32) ^ b->u[1];
+    r->u[0] = (lung->u[0] >> DSFMT_SR) ^ (lung->u[0] & DSFMT_MSK1) ^ t0;
+    r->u[1] = (lung->u[1] >> DSFMT_SR) ^ (lung->u[1] & DSFMT_MSK2) ^ t1;
+}
+
+/**
+ * This function is dsfmt_gen_rand_all() using the standard C
+ * recursion, to check the vectorized one against.
+ * @param dsfmt dsfmt state vector.
+ */
+void dsfmt_gen_rand_all_reference(dsfmt_t *dsfmt) {
+    int i;
+    w128_t lung;
+
+    lung = dsfmt->status[DSFMT_N];
+    do_recursion_reference(&dsfmt->status[0], &dsfmt->status[0],
+			   &dsfmt->status[DSFMT_POS1], &lung);
+    for (i = 1; i < DSFMT_N - DSFMT_POS1; i++) {
+	do_recursion_reference(&dsfmt->status[i], &dsfmt->status[i],
+			       &dsfmt->status[i + DSFMT_POS1], &lung);
+    }
+    for (; i < DSFMT_N; i++) {
+	do_recursion_reference(&dsfmt->status[i], &dsfmt->status[i],
+			       &dsfmt->status[i + DSFMT_POS1 - DSFMT_N],
+			       &lung);
+    }
+    dsfmt->status[DSFMT_N] = lung;
+}
+
 /**
  * This function generates double precision floating point
  * pseudorandom numbers which distribute in the range [1, 2) to the
@@ -729,6 +816,43 @@ void dsfmt_chk_init_by_array(dsfmt_t *dsfmt, uint32_t init_key[],
     setup_const();
 #endif
 }
+
+/**
+ * This function initializes the internal state array with a 64-bit
+ * integer seed, filling it with the SplitMix64 sequence starting at
+ * \b seed. Much cheaper than dsfmt_chk_init_gen_rand() or
+ * dsfmt_chk_init_by_array(): no serial dependency between words, one
+ * pass over the state. Meant for many generators with well-mixed
+ * seeds (see Seed_Sequence).
+ * @param dsfmt dsfmt state vector.
+ * @param seed a 64-bit integer used as the seed.
+ * @param mexp caller's mersenne expornent
+ */
+void dsfmt_chk_init_by_seed64(dsfmt_t *dsfmt, uint64_t seed, int mexp) {
+    int i;
+    uint64_t *psfmt;
+    uint64_t z;
+
+    /* make sure caller program is compiled with the same MEXP */
+    if (mexp != dsfmt_mexp) {
+	fprintf(stderr, "DSFMT_MEXP doesn't match with dSFMT.c\n");
+	exit(1);
+    }
+    psfmt = &dsfmt->status[0].u[0];
+    for (i = 0; i < (DSFMT_N + 1) * 2; i++) {
+	seed += UINT64_C(0x9e3779b97f4a7c15);
+	z = seed;
+	z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+	z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+	psfmt[i] = z ^ (z >> 31);
+    }
+    initial_mask(dsfmt);
+    period_certification(dsfmt);
+    dsfmt->idx = DSFMT_N64;
+#if defined(HAVE_SSE2)
+    setup_const();
+#endif
+}
 #if defined(__INTEL_COMPILER)
 #  pragma warning(default:981)
 #endif
@@ -0,0 +1,34 @@
+/**
+ * @file dSFMT-jump.hpp
+ *
+ * @brief Jump-ahead for dSFMT: move a state forward by any number of
+ * blocks without generating them.
+ *
+ * The state advances by one 128-bit word per recursion step (matrix A).
+ * Jumping by J words applies A^J = g(A), where g(x) = x^J mod p(x) and
+ * p(A) is zero (p(x) is the minimal polynomial of the recurrence, maybe
+ * times a few small factors). p(x) is computed once per process from
+ * the generated sequence (Berlekamp-Massey), so no pre-computed
+ * polynomial file is needed for any DSFMT_MEXP. Computing p(x) and a
+ * jump polynomial costs O(DSFMT_MEXP^2): a few hundredths of a second
+ * for 19937, a few seconds for 216091. Applying a jump costs about as
+ * much as generating DSFMT_MEXP/104 blocks.
+ */
+
+#ifndef DSFMT_JUMP_H
+#define DSFMT_JUMP_H
+
+#include <vector>
+
+#include "dSFMT.hpp"
+
+/** polynomial over GF(2), one bit per coefficient, lowest degree first */
+typedef std::vector<uint64_t> dsfmt_poly_t;
+
+const dsfmt_poly_t &dsfmt_minimal_poly(int *degree);
+void dsfmt_calc_jump(dsfmt_poly_t &jump, uint64_t nb_blocks,
+		     int log2_factor = 0);
+void dsfmt_jump_by(dsfmt_t *dsfmt, const dsfmt_poly_t &jump);
+void dsfmt_jump(dsfmt_t *dsfmt, uint64_t nb_blocks);
+
+#endif // DSFMT_JUMP_H
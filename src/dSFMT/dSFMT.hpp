@@ -171,6 +171,10 @@ extern dsfmt_t dsfmt_global_data;
 extern const int dsfmt_global_mexp;
 
 void dsfmt_gen_rand_all(dsfmt_t *dsfmt);
+void dsfmt_gen_rand_all_reference(dsfmt_t *dsfmt);
+void dsfmt_gen_rand_words(dsfmt_t *next, dsfmt_t *current, int first,
+			  int last);
+void dsfmt_next_word(dsfmt_t *dsfmt, int i);
 void dsfmt_fill_array_open_close(dsfmt_t *dsfmt, double array[], int size);
 void dsfmt_fill_array_close_open(dsfmt_t *dsfmt, double array[], int size);
 void dsfmt_fill_array_open_open(dsfmt_t *dsfmt, double array[], int size);
@@ -178,6 +182,7 @@ void dsfmt_fill_array_close1_open2(dsfmt_t *dsfmt, double array[], int size);
 void dsfmt_chk_init_gen_rand(dsfmt_t *dsfmt, uint32_t seed, int mexp);
 void dsfmt_chk_init_by_array(dsfmt_t *dsfmt, uint32_t init_key[],
 			     int key_length, int mexp);
+void dsfmt_chk_init_by_seed64(dsfmt_t *dsfmt, uint64_t seed, int mexp);
 const char *dsfmt_get_idstring(void);
 int dsfmt_get_min_array_size(void);
 
@@ -220,6 +225,8 @@ DSFMT_PRE_INLINE void dsfmt_init_gen_rand(dsfmt_t *dsfmt, uint32_t seed)
     DSFMT_PST_INLINE;
 DSFMT_PRE_INLINE void dsfmt_init_by_array(dsfmt_t *dsfmt, uint32_t init_key[],
 					  int key_length) DSFMT_PST_INLINE;
+DSFMT_PRE_INLINE void dsfmt_init_by_seed64(dsfmt_t *dsfmt, uint64_t seed)
+    DSFMT_PST_INLINE;
 
 /**
  * This function generates and returns unsigned 32-bit integer.
@@ -460,6 +467,16 @@ inline static void dsfmt_init_by_array(dsfmt_t *dsfmt, uint32_t init_key[],
     dsfmt_chk_init_by_array(dsfmt, init_key, key_length, DSFMT_MEXP);
 }
 
+/**
+ * This function initializes the internal state array with a 64-bit
+ * integer seed, see dsfmt_chk_init_by_seed64().
+ * @param dsfmt dsfmt state vector.
+ * @param seed a 64-bit integer used as the seed.
+ */
+inline static void dsfmt_init_by_seed64(dsfmt_t *dsfmt, uint64_t seed) {
+    dsfmt_chk_init_by_seed64(dsfmt, seed, DSFMT_MEXP);
+}
+
 /**
  * This function initializes the internal state array,
  * with an array of 32-bit integers used as the seeds.
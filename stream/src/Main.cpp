@@ -0,0 +1,348 @@
+/***************************************************************
+ * Stream raw pseudo-random numbers (binary, native endianness)
+ * to stdout or to a file, to feed external test suites.
+ *
+ * Numbers are generated in large blocks by the bulk fill functions
+ * and written with a single write() per block. With OpenMP, each
+ * thread fills its own block while an extra thread writes the
+ * blocks of the previous round (double buffering).
+ ***************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <stdint.h> // (u)int64_t
+#include <unistd.h> // write()
+#include <fcntl.h>  // open()
+
+#ifdef PARALLEL_OMP
+#include <omp.h>
+#endif // #ifdef PARALLEL_OMP
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Mapped_Random_Source.hpp>
+
+// Bytes generated by each thread per round
+const uint64_t default_block_size = uint64_t(4) << 20;
+
+enum Stream_Types
+{
+    TYPE_UINT64,
+    TYPE_CLOSE1_OPEN2,
+    TYPE_CLOSE0_OPEN1,
+    TYPE_OPEN0_CLOSE1,
+    TYPE_OPEN0_OPEN1
+};
+
+struct Stream_Options
+{
+    uint32_t seed;
+    bool     seed_given;
+    uint32_t stream_id;
+    uint64_t nb_bytes;      // 0 means unlimited
+    int      nb_threads;
+    int      type;
+    uint64_t block_size;
+    std::string output;     // Empty means stdout
+    std::string pool;       // Pool file to generate instead of streaming
+};
+
+void     Usage(const char *program);
+bool     Parse_Options(int argc, char *argv[], Stream_Options &options);
+void     Fill_Block(PRNG &prng, const int type, void *block, const uint64_t block_size);
+bool     Write_All(const int fd, const char *data, uint64_t size);
+
+// **************************************************************
+int main(int argc, char *argv[])
+{
+    Stream_Options options;
+    if (!Parse_Options(argc, argv, options))
+    {
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const int nb_threads = options.nb_threads;
+
+    // One generator per thread.
+    PRNG *prngs = new PRNG[nb_threads];
+    if (!options.seed_given)
+    {
+        prngs[0].Initialize_Taking_Time_As_Seed(true); // quiet = true
+        options.seed = prngs[0].Get_Seed();
+    }
+    if (!options.pool.empty())
+    {
+        // Pools hold doubles and are always generated from the seed itself.
+        const int intervals[] = {PRNG_Open0_Close1, PRNG_Close1_Open2, PRNG_Close0_Open1, PRNG_Open0_Close1, PRNG_Open0_Open1};
+        const uint64_t count = options.nb_bytes / sizeof(double);
+        delete[] prngs;
+        return (Mapped_Random_Source::Generate(options.pool, options.seed, count, intervals[options.type]) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    // Thread t of stream s uses the jump-ahead substream s * nb_threads + t
+    // of the seed (see PRNG::Initialize_Rank()): substreams never overlap.
+    // Each jump takes a fraction of a second, so they are done in parallel.
+    const int nb_substreams = (int(options.stream_id) + 1) * nb_threads;
+#ifdef PARALLEL_OMP
+    #pragma omp parallel for num_threads(nb_threads)
+#endif // #ifdef PARALLEL_OMP
+    for (int t = 0 ; t < nb_threads ; t++)
+    {
+        prngs[t].Initialize_Rank(options.seed, int(options.stream_id) * nb_threads + t, nb_substreams, true); // quiet = true
+    }
+
+    // Messages go to stderr: stdout is the stream itself.
+    std::cerr << "prng_stream: " << prngs[0].Get_Id_String() << ", seed " << options.seed
+              << ", stream " << options.stream_id << ", " << nb_threads << " thread(s)\n" << std::flush;
+
+    // A closed pipe makes write() fail instead of killing the process.
+    signal(SIGPIPE, SIG_IGN);
+
+    int fd = STDOUT_FILENO;
+    if (!options.output.empty())
+    {
+        fd = open(options.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            std::cerr << "prng_stream: couldn't open " << options.output << " for writing: " << strerror(errno) << "\n";
+            delete[] prngs;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Two sets of blocks: one being filled while the other is written.
+    const uint64_t block_size = options.block_size;
+    const uint64_t round_size = block_size * uint64_t(nb_threads);
+    char *buffers[2];
+    for (int b = 0 ; b < 2 ; b++)
+    {
+        void *buffer = NULL;
+        if (posix_memalign(&buffer, 4096, round_size) != 0)
+        {
+            std::cerr << "prng_stream: couldn't allocate " << round_size << " bytes\n";
+            abort();
+        }
+        buffers[b] = (char *) buffer;
+    }
+
+    // Number of rounds to generate, 0 for unlimited
+    const uint64_t nb_rounds = (options.nb_bytes + round_size - 1) / round_size;
+    bool stop = false;
+    bool write_ok = true;
+
+#ifdef PARALLEL_OMP
+    #pragma omp parallel num_threads(nb_threads + 1)
+#endif // #ifdef PARALLEL_OMP
+    {
+#ifdef PARALLEL_OMP
+        const int thread_id = omp_get_thread_num();
+        const int nb_omp_threads = omp_get_num_threads();
+#else  // #ifdef PARALLEL_OMP
+        const int thread_id = 0;
+        const int nb_omp_threads = 1;
+#endif // #ifdef PARALLEL_OMP
+        const int writer_id = nb_omp_threads - 1;
+
+        for (uint64_t round = 0 ; ; round++)
+        {
+            // Generate this round's blocks...
+            if (nb_rounds == 0 || round < nb_rounds)
+            {
+                if (nb_omp_threads == nb_threads + 1)
+                {
+                    if (thread_id != writer_id)
+                        Fill_Block(prngs[thread_id], options.type, buffers[round % 2] + uint64_t(thread_id) * block_size, block_size);
+                }
+                else if (thread_id == 0)
+                {
+                    for (int t = 0 ; t < nb_threads ; t++)
+                        Fill_Block(prngs[t], options.type, buffers[round % 2] + uint64_t(t) * block_size, block_size);
+                }
+            }
+
+            // ...while the previous round is written.
+            if (thread_id == writer_id && round > 0)
+            {
+                uint64_t size = round_size;
+                if (nb_rounds != 0 && round == nb_rounds)
+                    size = options.nb_bytes - (nb_rounds - 1) * round_size;
+                write_ok = Write_All(fd, buffers[(round - 1) % 2], size);
+                if (!write_ok || (nb_rounds != 0 && round == nb_rounds))
+                    stop = true;
+            }
+#ifdef PARALLEL_OMP
+            #pragma omp barrier
+#endif // #ifdef PARALLEL_OMP
+            const bool done = stop;
+            // Everybody must have read "stop" before the writer can change it again.
+#ifdef PARALLEL_OMP
+            #pragma omp barrier
+#endif // #ifdef PARALLEL_OMP
+            if (done)
+                break;
+        }
+    }
+
+    if (fd != STDOUT_FILENO)
+        close(fd);
+
+    free(buffers[0]);
+    free(buffers[1]);
+    delete[] prngs;
+
+    return (write_ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+// **************************************************************
+void Usage(const char *program)
+{
+    std::cerr
+        << "Usage: " << program << " [options]\n"
+        << "Write raw pseudo-random numbers to stdout (or a file).\n"
+        << "    --seed S        Seed (default: time and pid based)\n"
+        << "    --stream ID     Independent stream number for this seed, (ID + 1) * T < 2^31 (default: 0)\n"
+        << "    --bytes N       Number of bytes to write (default: unlimited). Accepts 1e9, 4k, 16M or 2G.\n"
+        << "    --threads T     Number of generating threads (default: 1). Requires OpenMP to run in parallel.\n"
+        << "    --type TYPE     uint64 (default), or doubles in c1o2 [1,2[, c0o1 [0,1[, o0c1 ]0,1] or o0o1 ]0,1[\n"
+        << "    --block N       Bytes generated per thread and per write (default: 4M)\n"
+        << "    --output FILE   Write to FILE instead of stdout\n"
+        << "    --pool FILE     Instead of streaming, save \"--bytes\" of doubles (]0,1] for uint64)\n"
+        << "                    to a pool file for Mapped_Random_Source, with a header\n"
+        << "With one thread and stream 0, the doubles are the ones PRNG::Initialize(S)\n"
+        << "followed by the corresponding Get_Random_*() calls would give. Otherwise\n"
+        << "thread t draws from jump-ahead substream ID * T + t of the seed (see\n"
+        << "PRNG::Initialize_Rank()), so streams never overlap, and blocks of \"--block\"\n"
+        << "bytes are written in thread order: the output depends on the number of threads.\n";
+}
+
+// **************************************************************
+static bool Parse_Size(const char *string, uint64_t &size)
+/**
+ * Parse a size like "1e9", "4k", "16M" or "2G" (powers of 1024).
+ */
+{
+    char *end = NULL;
+    const double value = strtod(string, &end);
+    if (end == string || value < 0.0)
+        return false;
+    double multiplier = 1.0;
+    switch (*end)
+    {
+        case '\0':                          break;
+        case 'k': case 'K': multiplier = 1024.0;                  break;
+        case 'm': case 'M': multiplier = 1024.0*1024.0;           break;
+        case 'g': case 'G': multiplier = 1024.0*1024.0*1024.0;    break;
+        default: return false;
+    }
+    size = uint64_t(value * multiplier);
+    return true;
+}
+
+// **************************************************************
+bool Parse_Options(int argc, char *argv[], Stream_Options &options)
+{
+    options.seed        = 0;
+    options.seed_given  = false;
+    options.stream_id   = 0;
+    options.nb_bytes    = 0;
+    options.nb_threads  = 1;
+    options.type        = TYPE_UINT64;
+    options.block_size  = default_block_size;
+    options.output      = "";
+    options.pool        = "";
+
+    for (int i = 1 ; i < argc ; i++)
+    {
+        const std::string option(argv[i]);
+        if (option == "--help" || option == "-h" || i+1 >= argc)
+            return false;
+
+        const char *value = argv[++i];
+        if (option == "--seed")
+        {
+            options.seed = uint32_t(strtoul(value, NULL, 0));
+            options.seed_given = true;
+        }
+        else if (option == "--stream")
+            options.stream_id = uint32_t(strtoul(value, NULL, 0));
+        else if (option == "--bytes")
+        {
+            if (!Parse_Size(value, options.nb_bytes))
+                return false;
+        }
+        else if (option == "--threads")
+            options.nb_threads = atoi(value);
+        else if (option == "--block")
+        {
+            if (!Parse_Size(value, options.block_size))
+                return false;
+        }
+        else if (option == "--output")
+            options.output = value;
+        else if (option == "--pool")
+            options.pool = value;
+        else if (option == "--type")
+        {
+            const std::string type(value);
+            if      (type == "uint64")  options.type = TYPE_UINT64;
+            else if (type == "c1o2")    options.type = TYPE_CLOSE1_OPEN2;
+            else if (type == "c0o1")    options.type = TYPE_CLOSE0_OPEN1;
+            else if (type == "o0c1")    options.type = TYPE_OPEN0_CLOSE1;
+            else if (type == "o0o1")    options.type = TYPE_OPEN0_OPEN1;
+            else return false;
+        }
+        else
+            return false;
+    }
+
+    // Blocks hold a whole number of 64 bits values.
+    options.block_size -= options.block_size % sizeof(uint64_t);
+    // Substreams are numbered with ints (see PRNG::Initialize_Rank()).
+    if (options.nb_threads < 1 || uint64_t(options.stream_id) + 1 > uint64_t(INT_MAX / options.nb_threads))
+        return false;
+    return (options.block_size > 0 && (options.pool.empty() || options.nb_bytes > 0));
+}
+
+// **************************************************************
+void Fill_Block(PRNG &prng, const int type, void *block, const uint64_t block_size)
+{
+    const uint64_t n = block_size / sizeof(uint64_t);
+    double *doubles = (double *) block;
+    switch (type)
+    {
+        case TYPE_UINT64:       prng.Fill_Array_Uint64((uint64_t *) block, n);  break;
+        case TYPE_CLOSE1_OPEN2: prng.Fill_Array_Close1_Open2(doubles, n);       break;
+        case TYPE_CLOSE0_OPEN1: prng.Fill_Array_Close0_Open1(doubles, n);       break;
+        case TYPE_OPEN0_CLOSE1: prng.Fill_Array_Open0_Close1(doubles, n);       break;
+        case TYPE_OPEN0_OPEN1:  prng.Fill_Array_Open0_Open1(doubles, n);        break;
+    }
+}
+
+// **************************************************************
+bool Write_All(const int fd, const char *data, uint64_t size)
+/**
+ * Write "size" bytes, retrying after partial writes. Returns false on
+ * error (for example when the reading end of a pipe was closed).
+ */
+{
+    while (size > 0)
+    {
+        const ssize_t written = write(fd, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno != EPIPE)
+                std::cerr << "prng_stream: write error: " << strerror(errno) << "\n";
+            return false;
+        }
+        data += written;
+        size -= uint64_t(written);
+    }
+    return true;
+}
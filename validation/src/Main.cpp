@@ -4,26 +4,131 @@
  ***************************************************************/
 
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <stdint.h> // (u)int64_t
 #include <cmath>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <algorithm> // std::min()
+#include <sys/stat.h> // mkdir()
 
 #ifdef PARALLEL_OMP
 #include <omp.h>
 #endif // #ifdef PARALLEL_OMP
 
 #include <PseudoRandomNumberGenerator.hpp>
+#include <Conformance.hpp>
 #include <Memory.hpp>
 
 const unsigned int N = 100000;
 const uint32_t seed  = 0;
 
+// Binary golden streams. Each method's stream is summarized by a rolling
+// digest saved every "golden_interval" draws, plus its first
+// "golden_nb_raw" draws saved verbatim to locate a divergence exactly.
+// The number of draws must be even so Box-Muller's cached deviate is
+// consumed before the next method (or run) uses it.
+const uint64_t golden_default_nb_draws = uint64_t(1) << 22;
+const uint64_t golden_interval         = uint64_t(1) << 16;
+const uint64_t golden_nb_raw           = 1024;
+const char     golden_magic[8]         = {'P','R','N','G','G','L','D','1'};
+
+struct Golden_Header
+{
+    char     magic[8];
+    uint32_t seed;
+    int32_t  mexp;
+    int32_t  method;
+    int32_t  values_per_draw;
+    uint64_t nb_draws;
+    uint64_t interval;
+    uint64_t nb_raw;
+};
+
+enum Golden_Methods
+{
+    GET_RANDOM = 0,
+    CLOSE1_OPEN2,
+    CLOSE0_OPEN1,
+    OPEN0_CLOSE1,
+    CLOSEN1_OPEN1,
+    CLOSE0_CLOSE1,
+    CLOSEN1_CLOSE1,
+    DIRECTION,
+    BOX_MULLER_POLAR,
+    NB_GOLDEN_METHODS
+};
+
+const char *golden_method_names[NB_GOLDEN_METHODS] = {
+    "Get_Random",
+    "Get_Random_Close1_Open2",
+    "Get_Random_Close0_Open1",
+    "Get_Random_Open0_Close1",
+    "Get_Random_CloseN1_Open1",
+    "Get_Random_Close0_Close1",
+    "Get_Random_CloseN1_Close1",
+    "Get_Random_Direction",
+    "Get_Random_Box_Muller_Polar"
+};
+
 void generate_input_file();
 void compare_previously_generated_file();
+int  Golden_Values_Per_Draw(const int method);
+void Golden_Draw(PRNG &prng, const int method, double *values, const uint64_t nb_draws);
+void Golden_Filename(char *filename, const char *folder, const int mexp, const int method);
+bool Generate_Golden(const int method, const char *folder, const uint64_t nb_draws, std::string &message);
+bool Compare_Golden(const int method, const char *folder, const uint64_t nb_draws, std::string &message);
 
 // **************************************************************
 int main(int argc, char *argv[])
+/**
+ * Usage: prng_validation [--generate] [--draws N] [--conformance N]
+ *
+ *  --generate       Write binary golden streams to output/golden/ instead of
+ *                   comparing against the ones in input/golden/.
+ *  --draws N        Number of draws per method (must be even). When comparing,
+ *                   defaults to (and is limited by) what the golden file holds.
+ *  --conformance N  Only check that the SIMD code paths give the bits of
+ *                   their scalar references, on N outputs per method, and
+ *                   report the first divergence.
+ */
 {
+    bool generate_golden = false;
+    uint64_t nb_draws = 0;
+    uint64_t nb_conformance_outputs = 0;
+    for (int i = 1 ; i < argc ; i++)
+    {
+        if (strcmp(argv[i], "--generate") == 0)
+            generate_golden = true;
+        else if (strcmp(argv[i], "--draws") == 0 && i+1 < argc)
+            nb_draws = uint64_t(strtod(argv[++i], NULL));
+        else if (strcmp(argv[i], "--conformance") == 0 && i+1 < argc)
+            nb_conformance_outputs = uint64_t(strtod(argv[++i], NULL));
+        else
+        {
+            std_cout << "Usage: " << argv[0] << " [--generate] [--draws N] [--conformance N]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (nb_conformance_outputs != 0)
+    {
+        std::cout << "Comparing SIMD kernels to their scalar references on " << nb_conformance_outputs << " outputs per method"
+                  << (prng::Strict_FP_Mode() ? " (strict floating point mode)" : "") << "...\n" << std::flush;
+        std::string report;
+        const bool identical = prng::Check_Conformance(nb_conformance_outputs, report, seed);
+        std::cout << report << (identical ? "Conformance: no divergence\n" : "Conformance: FAILED\n") << std::flush;
+        return (identical ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    if (nb_draws % 2 != 0)
+    {
+        std_cout << "Number of draws must be even. Aborting.\n" << std::flush;
+        return EXIT_FAILURE;
+    }
+
 #ifdef PARALLEL_OMP
     std_cout << "Compiled with OpenMP\n";
     omp_set_num_threads(12);
@@ -53,7 +158,46 @@ int main(int argc, char *argv[])
 #endif // #ifdef PARALLEL_OMP
     compare_previously_generated_file();
 
-    return EXIT_SUCCESS;
+    std::cout << "**************************************************************\n";
+    bool golden_ok[NB_GOLDEN_METHODS];
+    std::string golden_messages[NB_GOLDEN_METHODS];
+    if (generate_golden)
+    {
+        if (nb_draws == 0)
+            nb_draws = golden_default_nb_draws;
+        mkdir("output/golden", 0755);
+        std::cout << "Generating binary golden streams of " << nb_draws << " draws per method...\n" << std::flush;
+    }
+    else
+    {
+        std::cout << "Comparing binary golden streams bit-exactly...\n" << std::flush;
+    }
+
+    // Methods are independent: check them concurrently. Only one
+    // thread ever draws from Box-Muller, whose cache is static.
+#ifdef PARALLEL_OMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif // #ifdef PARALLEL_OMP
+    for (int method = 0 ; method < NB_GOLDEN_METHODS ; method++)
+    {
+        if (generate_golden)
+            golden_ok[method] = Generate_Golden(method, "output/golden", nb_draws, golden_messages[method]);
+        else
+            golden_ok[method] = Compare_Golden(method, "input/golden", nb_draws, golden_messages[method]);
+    }
+
+    int nb_golden_failures = 0;
+    for (int method = 0 ; method < NB_GOLDEN_METHODS ; method++)
+    {
+        std::cout << "    " << golden_method_names[method] << ": " << golden_messages[method] << "\n";
+        if (!golden_ok[method])
+            ++nb_golden_failures;
+    }
+    std::cout << "Golden streams done. " << nb_golden_failures << " failure" << (nb_golden_failures > 1 ? "s" : "") << "\n" << std::flush;
+    if (generate_golden)
+        std::cout << "Please copy output/golden/ into the input/ folder.\n";
+
+    return (nb_golden_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
 }
 
 
@@ -88,7 +232,7 @@ void generate_input_file()
 
     for (unsigned int i = 0 ; i < N ; i++)
     {
-        file << prng.Get_Random() << "\n" << std::flush;
+        file << prng.Get_Random() << "\n";
     }
 
     file.close();
@@ -144,3 +288,222 @@ void compare_previously_generated_file()
     file.close();
 }
 
+
+// **************************************************************
+int Golden_Values_Per_Draw(const int method)
+{
+    return (method == DIRECTION ? 3 : 1);
+}
+
+// **************************************************************
+void Golden_Draw(PRNG &prng, const int method, double *values, const uint64_t nb_draws)
+/**
+ * Fill "values" with "nb_draws" draws of the given method.
+ */
+{
+    switch (method)
+    {
+        case GET_RANDOM:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) values[i] = prng.Get_Random();
+            break;
+        case CLOSE1_OPEN2:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) values[i] = prng.Get_Random_Close1_Open2();
+            break;
+        case CLOSE0_OPEN1:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) values[i] = prng.Get_Random_Close0_Open1();
+            break;
+        case OPEN0_CLOSE1:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) values[i] = prng.Get_Random_Open0_Close1();
+            break;
+        case CLOSEN1_OPEN1:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) values[i] = prng.Get_Random_CloseN1_Open1();
+            break;
+        case CLOSE0_CLOSE1:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) values[i] = prng.Get_Random_Close0_Close1();
+            break;
+        case CLOSEN1_CLOSE1:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) values[i] = prng.Get_Random_CloseN1_Close1();
+            break;
+        case DIRECTION:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) prng.Get_Random_Direction(&values[3*i]);
+            break;
+        case BOX_MULLER_POLAR:
+            for (uint64_t i = 0 ; i < nb_draws ; i++) values[i] = prng.Get_Random_Box_Muller_Polar();
+            break;
+        default:
+            std::cout << "Unknown golden method " << method << ". Aborting.\n" << std::flush;
+            abort();
+    }
+}
+
+// **************************************************************
+void Golden_Filename(char *filename, const char *folder, const int mexp, const int method)
+/**
+ * The strict floating point mode doesn't use libm, which changes the
+ * Box-Muller stream: it has its own golden file.
+ */
+{
+    const bool strict = (prng::Strict_FP_Mode() && method == BOX_MULLER_POLAR);
+    sprintf(filename, "%s/MEXP%d_%s%s.bin", folder, mexp, (strict ? "strict_" : ""), golden_method_names[method]);
+}
+
+// **************************************************************
+bool Generate_Golden(const int method, const char *folder, const uint64_t nb_draws, std::string &message)
+/**
+ * Save a method's stream as checkpoint digests plus its first draws verbatim.
+ */
+{
+    PRNG prng;
+    prng.Initialize(seed, true); // quiet = true
+
+    Golden_Header header;
+    memcpy(header.magic, golden_magic, sizeof(golden_magic));
+    header.seed             = seed;
+    header.mexp             = prng.Get_Mersenne_Exponent();
+    header.method           = method;
+    header.values_per_draw  = Golden_Values_Per_Draw(method);
+    header.nb_draws         = nb_draws;
+    header.interval         = golden_interval;
+    header.nb_raw           = (nb_draws < golden_nb_raw ? nb_draws : golden_nb_raw);
+
+    const uint64_t nb_checkpoints = (nb_draws + golden_interval - 1) / golden_interval;
+    const uint64_t nb_raw_values  = header.nb_raw * header.values_per_draw;
+    uint64_t *digests = (uint64_t *) calloc_and_check(nb_checkpoints, sizeof(uint64_t));
+    double *values    = (double *)   calloc_and_check(golden_interval * header.values_per_draw, sizeof(double));
+    double *raw       = (double *)   calloc_and_check(nb_raw_values, sizeof(double));
+
+    uint64_t digest = 0;
+    for (uint64_t c = 0 ; c < nb_checkpoints ; c++)
+    {
+        const uint64_t first = c * golden_interval;
+        const uint64_t n     = std::min(nb_draws - first, golden_interval);
+        Golden_Draw(prng, method, values, n);
+        if (first < header.nb_raw)
+        {
+            const uint64_t nb_to_copy = std::min(header.nb_raw - first, n);
+            memcpy(&raw[first * header.values_per_draw], values, nb_to_copy * header.values_per_draw * sizeof(double));
+        }
+        digest = prng::Digest(values, n * header.values_per_draw, digest);
+        digests[c] = digest;
+    }
+
+    char filename[1000];
+    Golden_Filename(filename, folder, header.mexp, method);
+    FILE *file = fopen(filename, "wb");
+    bool success = (file != NULL);
+    if (success)
+    {
+        success = (fwrite(&header, sizeof(header), 1, file) == 1)
+               && (fwrite(digests, sizeof(uint64_t), nb_checkpoints, file) == nb_checkpoints)
+               && (fwrite(raw, sizeof(double), nb_raw_values, file) == nb_raw_values);
+        fclose(file);
+    }
+
+    message = (success ? "saved to " : "ERROR: couldn't write ") + std::string(filename);
+
+    free(digests);
+    free(values);
+    free(raw);
+
+    return success;
+}
+
+// **************************************************************
+bool Compare_Golden(const int method, const char *folder, const uint64_t nb_draws, std::string &message)
+/**
+ * Regenerate a method's stream and compare it bit-exactly to its golden
+ * file, reporting the first divergence found.
+ */
+{
+    PRNG prng;
+
+    char filename[1000];
+    Golden_Filename(filename, folder, prng.Get_Mersenne_Exponent(), method);
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        message = "ERROR: couldn't open " + std::string(filename) + " (create it with --generate)";
+        return false;
+    }
+
+    Golden_Header header;
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, golden_magic, sizeof(golden_magic)) != 0
+        || header.method != method
+        || header.values_per_draw != Golden_Values_Per_Draw(method)
+        || header.interval == 0)
+    {
+        fclose(file);
+        message = "ERROR: " + std::string(filename) + " is not a valid golden file";
+        return false;
+    }
+
+    const uint64_t nb_to_check    = (nb_draws == 0 ? header.nb_draws : std::min(nb_draws, header.nb_draws));
+    const uint64_t nb_checkpoints = (header.nb_draws + header.interval - 1) / header.interval;
+    const uint64_t nb_raw_values  = header.nb_raw * header.values_per_draw;
+    uint64_t *digests = (uint64_t *) calloc_and_check(nb_checkpoints, sizeof(uint64_t));
+    double *values    = (double *)   calloc_and_check(header.interval * header.values_per_draw, sizeof(double));
+    double *raw       = (double *)   calloc_and_check(nb_raw_values, sizeof(double));
+    const bool read_ok = (fread(digests, sizeof(uint64_t), nb_checkpoints, file) == nb_checkpoints)
+                      && (fread(raw, sizeof(double), nb_raw_values, file) == nb_raw_values);
+    fclose(file);
+    if (!read_ok)
+    {
+        free(digests);
+        free(values);
+        free(raw);
+        message = "ERROR: " + std::string(filename) + " is truncated";
+        return false;
+    }
+
+    prng.Initialize(header.seed, true); // quiet = true
+
+    std::ostringstream report;
+    bool success = true;
+    uint64_t digest = 0;
+    uint64_t first = 0;
+    for (uint64_t c = 0 ; success && first < nb_to_check ; c++)
+    {
+        const uint64_t n = std::min(nb_to_check - first, header.interval);
+        Golden_Draw(prng, method, values, n);
+
+        // Values saved verbatim locate the exact divergence.
+        const uint64_t raw_offset = first * header.values_per_draw;
+        const uint64_t nb_raw_here = (raw_offset < nb_raw_values ? std::min(nb_raw_values - raw_offset, n * header.values_per_draw) : 0);
+        for (uint64_t i = 0 ; i < nb_raw_here ; i++)
+        {
+            union { double d; uint64_t u; } obtained, expected;
+            obtained.d = values[i];
+            expected.d = raw[raw_offset + i];
+            if (obtained.u != expected.u)
+            {
+                report << "ERROR: first divergence at value " << raw_offset + i << ": "
+                       << std::hex << std::setfill('0')
+                       << "0x" << std::setw(16) << obtained.u << " != 0x" << std::setw(16) << expected.u
+                       << std::dec << std::setprecision(17)
+                       << " (" << obtained.d << " != " << expected.d << ")";
+                success = false;
+                break;
+            }
+        }
+
+        // Digests are only comparable at checkpoint boundaries.
+        digest = prng::Digest(values, n * header.values_per_draw, digest);
+        if (success && (n == header.interval || first + n == header.nb_draws) && digest != digests[c])
+        {
+            report << "ERROR: digest differs in draws [" << first << "," << first + n << "[";
+            success = false;
+        }
+        first += n;
+    }
+    if (success)
+        report << nb_to_check << " draws bit-identical";
+
+    message = report.str();
+
+    free(digests);
+    free(values);
+    free(raw);
+
+    return success;
+}
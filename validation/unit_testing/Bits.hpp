@@ -0,0 +1,25 @@
+#ifndef INC_Bits_hpp
+#define INC_Bits_hpp
+
+#include <stdint.h> // (u)int64_t
+#include <cstring>  // memcpy()
+
+// **************************************************************
+// Exact comparisons of doubles for the unit tests, through their bit
+// patterns (== on doubles is -Wfloat-equal; NaNs compare equal to
+// themselves, 0 and -0 differ).
+inline uint64_t Bits(const double d)
+{
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    return u;
+}
+
+inline bool Same_Bits(const double a, const double b)
+{
+    return (Bits(a) == Bits(b));
+}
+
+#endif // INC_Bits_hpp
+
+// ********** End of file ***************************************
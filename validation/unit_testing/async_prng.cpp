@@ -0,0 +1,52 @@
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Async_PRNG.hpp>
+
+#include "Bits.hpp"
+
+BOOST_AUTO_TEST_CASE(Async_PRNG_Same_Sequence_As_PRNG)
+{
+    const int N = 1000000;
+
+    // A small ring makes the producer wait on the consumer often.
+    Async_PRNG async_prng(2, 1000);
+    async_prng.Initialize(2011, true); // quiet == true
+
+    PRNG prng;
+    prng.Initialize(2011, true); // quiet == true
+
+    int nb_errors = 0;
+    for (int i = 0 ; i < N ; i++)
+    {
+        if (!Same_Bits(async_prng.Get_Random(), prng.Get_Random()))
+            ++nb_errors;
+    }
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+    BOOST_CHECK_EQUAL(async_prng.Get_Nb_Calls(), uint64_t(N));
+}
+
+BOOST_AUTO_TEST_CASE(Async_PRNG_Reinitialize)
+{
+    Async_PRNG async_prng;
+    async_prng.Initialize(1, true); // quiet == true
+    for (int i = 0 ; i < 12345 ; i++)
+        async_prng.Get_Random_Close0_Open1();
+
+    // Restarting discards what was produced ahead.
+    async_prng.Initialize(7, true); // quiet == true
+    PRNG prng;
+    prng.Initialize(7, true); // quiet == true
+    int nb_errors = 0;
+    for (int i = 0 ; i < 100000 ; i++)
+    {
+        if (!Same_Bits(async_prng.Get_Random_CloseN1_Close1(), prng.Get_Random_CloseN1_Close1()))
+            ++nb_errors;
+    }
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+
+    async_prng.Stop();
+    BOOST_CHECK_EQUAL(async_prng.Get_Nb_Calls(), uint64_t(0));
+}
@@ -0,0 +1,137 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <cmath>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Bernoulli.hpp>
+
+static uint64_t Bit(const std::vector<uint64_t> &mask, const uint64_t i)
+{
+    return (mask[i / 64] >> (i % 64)) & 1;
+}
+
+BOOST_AUTO_TEST_CASE(Bernoulli_Bits)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    const uint64_t nbits = 1000003; // Last word partially used
+    const uint64_t nb_words = (nbits + 63) / 64;
+    std::vector<uint64_t> mask(nb_words);
+
+    const int nb_probabilities = 6;
+    const double probabilities[nb_probabilities] = {0.5, 0.1, 0.9, 1.0 / 3.0, 0.75, 1.0e-3};
+    for (int k = 0 ; k < nb_probabilities ; k++)
+    {
+        const double p = probabilities[k];
+        prng::Fill_Bernoulli_Bits(prng, &mask[0], nbits, p);
+        BOOST_REQUIRE_EQUAL(mask[nb_words - 1] >> (nbits % 64), uint64_t(0));
+
+        uint64_t nb_ones = 0, nb_pairs = 0;
+        for (uint64_t i = 0 ; i < nbits ; i++)
+        {
+            nb_ones  += Bit(mask, i);
+            nb_pairs += (i + 1 < nbits ? Bit(mask, i) & Bit(mask, i + 1) : 0);
+        }
+        // Within about 4 standard deviations; neighbouring bits independent
+        // (too few pairs expected to check with a small p)
+        BOOST_CHECK_CLOSE(double(nb_ones) / double(nbits), p, (p < 0.01 ? 15.0 : 1.0));
+        if (p > 0.01)
+            BOOST_CHECK_CLOSE(double(nb_pairs) / double(nbits - 1), p * p, 2.5);
+    }
+
+    prng::Fill_Bernoulli_Bits(prng, &mask[0], nbits, 0.0);
+    for (uint64_t w = 0 ; w < nb_words ; w++)
+        BOOST_REQUIRE_EQUAL(mask[w], uint64_t(0));
+    prng::Fill_Bernoulli_Bits(prng, &mask[0], nbits, 1.0);
+    for (uint64_t w = 0 ; w + 1 < nb_words ; w++)
+        BOOST_REQUIRE_EQUAL(mask[w], ~uint64_t(0));
+    BOOST_CHECK_EQUAL(mask[nb_words - 1], (uint64_t(1) << (nbits % 64)) - 1);
+}
+
+BOOST_AUTO_TEST_CASE(Bernoulli_Sparse_Hits)
+{
+    PRNG prng;
+    prng.Initialize(7, true); // quiet == true
+
+    // Fixed p
+    const uint64_t n = 10000000;
+    const double p = 1.0e-3;
+    std::vector<uint64_t> hits;
+    const uint64_t nb_hits = prng::Bernoulli_Hits(prng, n, p, hits);
+    BOOST_CHECK_EQUAL(nb_hits, hits.size());
+    BOOST_CHECK_CLOSE(double(hits.size()) / double(n), p, 4.0);
+    for (size_t i = 0 ; i < hits.size() ; i++)
+        BOOST_REQUIRE(hits[i] < n && (i == 0 || hits[i] > hits[i - 1]));
+    // Geometric gaps: P(gap == 1) = p, P(gap > 1000) = (1-p)^1000
+    uint64_t nb_adjacent = 0, nb_long = 0;
+    for (size_t i = 1 ; i < hits.size() ; i++)
+    {
+        nb_adjacent += (hits[i] - hits[i - 1] == 1 ? 1 : 0);
+        nb_long     += (hits[i] - hits[i - 1] > 1000 ? 1 : 0);
+    }
+    BOOST_CHECK(nb_adjacent < 30);
+    BOOST_CHECK_CLOSE(double(nb_long) / double(hits.size() - 1), std::pow(1.0 - p, 1000.0), 5.0);
+
+    // Piecewise constant p, with ranges that never and always succeed
+    const int nb_ranges = 4;
+    const uint64_t ends[nb_ranges] = {1000000, 2000000, 2001000, 3000000};
+    const double probabilities[nb_ranges] = {1.0e-3, 0.0, 1.0, 1.0e-2};
+    prng::Bernoulli_Hits(prng, ends, probabilities, nb_ranges, hits);
+    uint64_t counts[nb_ranges] = {0, 0, 0, 0};
+    for (size_t i = 0 ; i < hits.size() ; i++)
+    {
+        BOOST_REQUIRE(i == 0 || hits[i] > hits[i - 1]);
+        int r = 0;
+        while (r < nb_ranges && hits[i] >= ends[r])
+            r++;
+        BOOST_REQUIRE(r < nb_ranges);
+        counts[r]++;
+    }
+    BOOST_CHECK_CLOSE(double(counts[0]), 1000.0, 15.0);
+    BOOST_CHECK_EQUAL(counts[1], uint64_t(0));
+    BOOST_CHECK_EQUAL(counts[2], uint64_t(1000));
+    BOOST_CHECK_CLOSE(double(counts[3]), 9990.0, 5.0);
+
+    // Iterator: ends after the last range, restarts with Seek()
+    Sparse_Bernoulli trials(prng, ends, probabilities, nb_ranges);
+    trials.Seek(2000000);
+    for (uint64_t i = 2000000 ; i < 2001000 ; i++)
+        BOOST_REQUIRE_EQUAL(trials.Next(), i);
+    trials.Seek(1999999);
+    BOOST_CHECK_EQUAL(trials.Next(), uint64_t(2000000));
+    uint64_t last = 0;
+    for (uint64_t i = trials.Next() ; i != Sparse_Bernoulli::end ; i = trials.Next())
+        last = i;
+    BOOST_CHECK(last >= 2001000 && last < 3000000);
+    BOOST_CHECK_EQUAL(trials.Next(), Sparse_Bernoulli::end);
+    BOOST_CHECK_EQUAL(trials.Get_Position(), uint64_t(3000000));
+
+    // Unbounded sequence
+    Sparse_Bernoulli unbounded(prng, 1.0e-6);
+    uint64_t previous = unbounded.Next();
+    for (int i = 0 ; i < 1000 ; i++)
+    {
+        const uint64_t next = unbounded.Next();
+        BOOST_REQUIRE(next > previous);
+        previous = next;
+    }
+    BOOST_CHECK_CLOSE(double(previous), 1.0e9, 10.0);
+
+    // No number drawn once only ranges of p = 0 are left
+    const uint64_t zero_ends[2] = {1000, 2000};
+    const double zero_probabilities[2] = {1.0, 0.0};
+    Sparse_Bernoulli zero_tail(prng, zero_ends, zero_probabilities, 2);
+    for (uint64_t i = 0 ; i < 1000 ; i++)
+        BOOST_REQUIRE_EQUAL(zero_tail.Next(), i);
+    const uint64_t nb_calls = prng.Get_Nb_Calls();
+    BOOST_CHECK_EQUAL(zero_tail.Next(), Sparse_Bernoulli::end);
+    BOOST_CHECK_EQUAL(zero_tail.Get_Position(), uint64_t(2000));
+    Sparse_Bernoulli never(prng, 0.0);
+    BOOST_CHECK_EQUAL(never.Next(), Sparse_Bernoulli::end);
+    BOOST_CHECK_EQUAL(prng.Get_Nb_Calls(), nb_calls);
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,26 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <string>
+
+#include <Conformance.hpp>
+
+BOOST_AUTO_TEST_CASE(Conformance_SIMD_Same_As_Scalar)
+{
+    // Set PRNG_CONFORMANCE_OUTPUTS (e.g. to 1e9) for a longer check
+    uint64_t nb_outputs = 1000000;
+    const char *nb_outputs_env = getenv("PRNG_CONFORMANCE_OUTPUTS");
+    if (nb_outputs_env != NULL)
+        nb_outputs = uint64_t(strtod(nb_outputs_env, NULL));
+
+    std::string report;
+    const bool identical = prng::Check_Conformance(nb_outputs, report);
+    BOOST_TEST_MESSAGE(report);
+    BOOST_CHECK_MESSAGE(identical, report);
+
+    // One line per method, each reporting all its outputs
+    BOOST_CHECK(report.find("divergence") == std::string::npos);
+    BOOST_CHECK(report.find("dSFMT [1,2[") != std::string::npos);
+    BOOST_CHECK(report.find("prng::Box_Muller_Array()") != std::string::npos);
+}
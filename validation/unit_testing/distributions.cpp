@@ -0,0 +1,147 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Distributions.hpp>
+
+BOOST_AUTO_TEST_CASE(Distributions_Exponential)
+{
+    PRNG prng, same_prng;
+    prng.Initialize(42, true);      // quiet == true
+    same_prng.Initialize(42, true); // quiet == true
+
+    const uint64_t n = 100003;
+    const double rate = 2.5;
+    std::vector<double> values(n), rates(n, rate), same_values(n);
+    prng::Fill_Exponential(prng, &values[0], n, rate);
+    prng::Fill_Exponential(same_prng, &same_values[0], n, &rates[0]);
+
+    double sum = 0.0, sum_squares = 0.0;
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        BOOST_REQUIRE(values[i] >= 0.0);
+        BOOST_REQUIRE_EQUAL(values[i], same_values[i]);
+        sum         += values[i];
+        sum_squares += values[i] * values[i];
+    }
+    // Mean and standard deviation 1/rate = 0.4, within a few standard errors
+    const double mean = sum / double(n);
+    BOOST_CHECK_CLOSE(mean, 1.0 / rate, 1.0);
+    BOOST_CHECK_CLOSE(std::sqrt(sum_squares / double(n) - mean * mean), 1.0 / rate, 2.0);
+
+    // Per element rates, in place
+    for (uint64_t i = 0 ; i < n ; i++)
+        rates[i] = (i % 2 == 0 ? 1.0 : 100.0);
+    prng::Fill_Exponential(prng, &rates[0], n, &rates[0]);
+    double sums[2] = {0.0, 0.0};
+    for (uint64_t i = 0 ; i < n ; i++)
+        sums[i % 2] += rates[i];
+    BOOST_CHECK_CLOSE(sums[0] / double((n + 1) / 2), 1.0, 2.0);
+    BOOST_CHECK_CLOSE(sums[1] / double(n / 2), 0.01, 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(Distributions_Poisson_Process)
+{
+    PRNG prng;
+    prng.Initialize(2015, true); // quiet == true
+
+    const double rate = 3.0, begin = 10.0, end = 20.0;
+    const int nb_windows = 2000;
+    std::vector<double> times;
+    uint64_t total = 0;
+    for (int w = 0 ; w < nb_windows ; w++)
+    {
+        const uint64_t count = prng::Poisson_Process(prng, rate, begin, end, times);
+        BOOST_REQUIRE_EQUAL(count, uint64_t(times.size()));
+        for (uint64_t i = 0 ; i < count ; i++)
+        {
+            BOOST_REQUIRE(times[i] >= begin && times[i] < end);
+            if (i > 0)
+                BOOST_REQUIRE(times[i] >= times[i - 1]);
+        }
+        total += count;
+    }
+    // 30 arrivals per window on average
+    BOOST_CHECK_CLOSE(double(total) / double(nb_windows), rate * (end - begin), 1.0);
+
+    // Just under a chunk of arrivals expected: the gaps still fit in it
+    const uint64_t dense = prng::Poisson_Process(prng, 102.0, begin, end, times);
+    BOOST_CHECK_EQUAL(dense, uint64_t(times.size()));
+    BOOST_CHECK(std::fabs(double(dense) - 1020.0) < 5.0 * std::sqrt(1020.0));
+    for (uint64_t i = 0 ; i < dense ; i++)
+        BOOST_REQUIRE(times[i] >= begin && times[i] < end);
+
+    BOOST_CHECK_EQUAL(prng::Poisson_Process(prng, rate, end, begin, times), uint64_t(0));
+    BOOST_CHECK(times.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Distributions_Maxwell_Boltzmann)
+{
+    PRNG prng;
+    prng.Initialize(7, true); // quiet == true
+
+    // Two species: <v_x^2> = kT/m
+    const uint64_t n = 200001;
+    const double kT = 2.0;
+    const double masses[2] = {1.0, 16.0};
+    std::vector<int> species(n);
+    for (uint64_t i = 0 ; i < n ; i++)
+        species[i] = int(i % 3 == 0);
+    std::vector<double> vx(n), vy(n), vz(n);
+    prng::Fill_Maxwell_Boltzmann(prng, &vx[0], &vy[0], &vz[0], n, kT, masses, &species[0]);
+
+    double sums[2] = {0.0, 0.0}, counts[2] = {0.0, 0.0};
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        sums[species[i]]   += vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+        counts[species[i]] += 3.0;
+    }
+    BOOST_CHECK_CLOSE(sums[0] / counts[0], kT / masses[0], 1.0);
+    BOOST_CHECK_CLOSE(sums[1] / counts[1], kT / masses[1], 1.0);
+
+    // Threads don't change the velocities; block b is stream first_stream + b
+    const Seed_Sequence seeds(123);
+    std::vector<double> wx(n), wy(n), wz(n);
+    BOOST_CHECK_EQUAL(prng::Parallel_Fill_Maxwell_Boltzmann(seeds, 10, &vx[0], &vy[0], &vz[0], n, kT,
+                                                            masses, &species[0], 1), uint64_t(4));
+    BOOST_CHECK_EQUAL(prng::Parallel_Fill_Maxwell_Boltzmann(seeds, 10, &wx[0], &wy[0], &wz[0], n, kT,
+                                                            masses, &species[0], 3), uint64_t(4));
+    BOOST_CHECK(vx == wx && vy == wy && vz == wz);
+
+    PRNG last_block;
+    last_block.Initialize(seeds, 13, true); // quiet == true
+    const uint64_t first = 3 * 65536;
+    prng::Fill_Maxwell_Boltzmann(last_block, &wx[first], &wy[first], &wz[first], n - first, kT,
+                                 masses, &species[first]);
+    BOOST_CHECK(vx == wx && vy == wy && vz == wz);
+
+    // One mass
+    prng::Fill_Maxwell_Boltzmann(prng, &vx[0], &vy[0], &vz[0], n, kT, 4.0);
+    double sum = 0.0;
+    for (uint64_t i = 0 ; i < n ; i++)
+        sum += vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+    BOOST_CHECK_CLOSE(sum / double(3 * n), kT / 4.0, 1.0);
+
+    // One mass, on threads: same as its blocks drawn one after the other
+    BOOST_CHECK_EQUAL(prng::Parallel_Fill_Maxwell_Boltzmann(seeds, 20, &vx[0], &vy[0], &vz[0], n, kT,
+                                                            4.0, 3), uint64_t(4));
+    for (uint64_t block = 0 ; block < 4 ; block++)
+    {
+        PRNG block_prng;
+        block_prng.Initialize(seeds, 20 + block, true); // quiet == true
+        const uint64_t begin = block * 65536;
+        prng::Fill_Maxwell_Boltzmann(block_prng, &wx[begin], &wy[begin], &wz[begin],
+                                     std::min(uint64_t(65536), n - begin), kT, 4.0);
+    }
+    BOOST_CHECK(vx == wx && vy == wy && vz == wz);
+    sum = 0.0;
+    for (uint64_t i = 0 ; i < n ; i++)
+        sum += vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+    BOOST_CHECK_CLOSE(sum / double(3 * n), kT / 4.0, 1.0);
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,89 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Feistel_Permutation.hpp>
+
+BOOST_AUTO_TEST_CASE(Feistel_Permutation_Is_Bijection)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    const int nb_sizes = 8;
+    const uint64_t sizes[nb_sizes] = {1, 2, 3, 7, 1000, 1025, 65536, 100003};
+    for (int s = 0 ; s < nb_sizes ; s++)
+    {
+        const uint64_t n = sizes[s];
+        const Feistel_Permutation permutation(n, prng);
+        BOOST_CHECK_EQUAL(permutation.Get_Size(), n);
+
+        std::vector<bool> seen(n, false);
+        uint64_t nb_fixed = 0;
+        for (uint64_t i = 0 ; i < n ; i++)
+        {
+            const uint64_t image = permutation.Permute(i);
+            BOOST_REQUIRE(image < n);
+            BOOST_REQUIRE(!seen[image]);
+            seen[image] = true;
+            BOOST_REQUIRE_EQUAL(permutation.Inverse(image), i);
+            nb_fixed += (image == i ? 1 : 0);
+        }
+        if (n >= 1000)
+            BOOST_CHECK(nb_fixed < 10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Feistel_Permutation_Batch_Same_As_Scalar)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    const uint64_t n = 100003;
+    const Feistel_Permutation permutation(n, prng);
+
+    const uint64_t first = 12345;
+    const uint64_t nb = 10007; // Not a multiple of the SIMD width
+    std::vector<uint64_t> images(nb), indices(nb);
+    permutation.Permute_Range(first, nb, &images[0]);
+    permutation.Inverse_Array(&images[0], &indices[0], nb);
+    for (uint64_t k = 0 ; k < nb ; k++)
+    {
+        BOOST_REQUIRE_EQUAL(images[k], permutation.Permute(first + k));
+        BOOST_REQUIRE_EQUAL(indices[k], first + k);
+    }
+
+    // In place
+    permutation.Permute_Array(&indices[0], &indices[0], nb);
+    BOOST_CHECK(indices == images);
+}
+
+BOOST_AUTO_TEST_CASE(Feistel_Permutation_Huge)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    const int nb_sizes = 4;
+    const uint64_t sizes[nb_sizes] = {uint64_t(100000000000.0), uint64_t(1) << 40,
+                                      (uint64_t(1) << 63) + 1, ~uint64_t(0)};
+    for (int s = 0 ; s < nb_sizes ; s++)
+    {
+        const uint64_t n = sizes[s];
+        const Feistel_Permutation permutation(n, prng);
+        const uint64_t nb = 1001;
+        std::vector<uint64_t> images(nb), indices(nb);
+        permutation.Permute_Range(n - nb, nb, &images[0]);
+        permutation.Inverse_Array(&images[0], &indices[0], nb);
+        uint64_t nb_high = 0;
+        for (uint64_t k = 0 ; k < nb ; k++)
+        {
+            BOOST_REQUIRE(images[k] < n);
+            BOOST_REQUIRE_EQUAL(indices[k], n - nb + k);
+            BOOST_REQUIRE_EQUAL(permutation.Permute(n - nb + k), images[k]);
+            nb_high += (images[k] >= n / 2 ? 1 : 0);
+        }
+        // Spread over the whole range
+        BOOST_CHECK(nb_high > 400 && nb_high < 600);
+    }
+}
@@ -0,0 +1,76 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <Generator_Array.hpp>
+
+// Reference xoshiro128++ (D. Blackman and S. Vigna's xoshiro128plusplus.c)
+static inline uint32_t rotl(const uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+static uint32_t next(uint32_t *s)
+{
+    const uint32_t result = rotl(s[0] + s[3], 7) + s[0];
+    const uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(Generator_Array_Is_Xoshiro128pp)
+{
+    const Seed_Sequence seeds(42);
+    Generator_Array generators(3, seeds);
+
+    uint32_t state[Generator_Array::state_size] = {1, 2, 3, 4};
+    generators.Set_State(1, state);
+    BOOST_CHECK_EQUAL(generators.Next_Uint32(1), 641U); // rotl(1 + 4, 7) + 1
+    next(state);
+    for (int k = 0 ; k < 1000 ; k++)
+        BOOST_REQUIRE_EQUAL(generators.Next_Uint32(1), next(state));
+
+    // Entity "id"'s numbers only depend on the seed and the id
+    Generator_Array others(2, seeds, 2);
+    for (int k = 0 ; k < 100 ; k++)
+        BOOST_REQUIRE_EQUAL(generators.Next_Uint32(2), others.Next_Uint32(0));
+}
+
+BOOST_AUTO_TEST_CASE(Generator_Array_Step_Same_As_Scalar)
+{
+    const Seed_Sequence seeds(2015);
+    const uint64_t n = 1003; // Not a multiple of the SIMD width
+    Generator_Array bulk(n, seeds, 100);
+    Generator_Array scalar(n, seeds, 100);
+
+    std::vector<uint32_t> integers(n);
+    std::vector<double> doubles(n);
+    for (int step = 0 ; step < 10 ; step++)
+    {
+        bulk.Step_Uint32(&integers[0]);
+        bulk.Step_Close0_Open1(&doubles[0]);
+        for (uint64_t i = 0 ; i < n ; i++)
+        {
+            BOOST_REQUIRE_EQUAL(integers[i], scalar.Next_Uint32(i));
+            const double d = scalar.Next_Close0_Open1(i);
+            BOOST_REQUIRE(doubles[i] >= 0.0 && doubles[i] < 1.0);
+            BOOST_REQUIRE_EQUAL(doubles[i], d);
+        }
+    }
+
+    // A state moved to another slot (or process) continues the same stream
+    uint32_t state[Generator_Array::state_size];
+    bulk.Get_State(7, state);
+    Generator_Array moved(1, Seed_Sequence(0));
+    moved.Set_State(0, state);
+    for (int k = 0 ; k < 100 ; k++)
+        BOOST_REQUIRE_EQUAL(moved.Next_Close0_Open1(0), bulk.Next_Close0_Open1(7));
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,215 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <cmath>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Geometry.hpp>
+
+BOOST_AUTO_TEST_CASE(Geometry_Random_Quaternions)
+{
+    PRNG aos_prng, soa_prng;
+    aos_prng.Initialize(42, true); // quiet == true
+    soa_prng.Initialize(42, true); // quiet == true
+
+    const uint64_t n = 100003;
+    std::vector<double> aos(4*n), soa(4*n);
+    prng::Fill_Random_Quaternions(aos_prng, &aos[0], n);
+    prng::Fill_Random_Quaternions(soa_prng, &soa[0], n, PRNG_SoA);
+
+    double sum_squares[4] = {0.0, 0.0, 0.0, 0.0};
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        double norm = 0.0;
+        for (int c = 0 ; c < 4 ; c++)
+        {
+            const double q = aos[4*i + c];
+            BOOST_REQUIRE_EQUAL(q, soa[uint64_t(c)*n + i]);
+            norm += q * q;
+            sum_squares[c] += q * q;
+        }
+        BOOST_REQUIRE_CLOSE(norm, 1.0, 1.0e-12);
+    }
+    // Uniform on the 3-sphere: <q_c^2> = 1/4
+    for (int c = 0 ; c < 4 ; c++)
+        BOOST_CHECK_CLOSE(sum_squares[c] / double(n), 0.25, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(Geometry_Random_Rotation_Matrices)
+{
+    PRNG prng, quaternion_prng;
+    prng.Initialize(2015, true);            // quiet == true
+    quaternion_prng.Initialize(2015, true); // quiet == true
+
+    const uint64_t n = 20011;
+    std::vector<double> R(9*n), q(4*n);
+    prng::Fill_Random_Rotation_Matrices(prng, &R[0], n);
+    prng::Fill_Random_Quaternions(quaternion_prng, &q[0], n);
+
+    double sum[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        const double *m = &R[9*i];
+        // Orthonormal rows
+        for (int r = 0 ; r < 3 ; r++)
+        {
+            for (int s = 0 ; s < 3 ; s++)
+            {
+                const double dot = m[3*r] * m[3*s] + m[3*r + 1] * m[3*s + 1] + m[3*r + 2] * m[3*s + 2];
+                BOOST_REQUIRE_SMALL(dot - (r == s ? 1.0 : 0.0), 1.0e-14);
+            }
+        }
+        // Proper rotation
+        const double det = m[0] * (m[4]*m[8] - m[5]*m[7]) - m[1] * (m[3]*m[8] - m[5]*m[6]) + m[2] * (m[3]*m[7] - m[4]*m[6]);
+        BOOST_REQUIRE_SMALL(det - 1.0, 1.0e-14);
+        // Trace of a quaternion's matrix: 4 w^2 - 1
+        BOOST_REQUIRE_SMALL(m[0] + m[4] + m[8] - (4.0 * q[4*i] * q[4*i] - 1.0), 1.0e-14);
+        for (int c = 0 ; c < 9 ; c++)
+            sum[c] += m[c];
+    }
+    // Uniform rotations: <R> = 0, each element of variance 1/3
+    for (int c = 0 ; c < 9 ; c++)
+        BOOST_CHECK_SMALL(sum[c] / double(n), 0.02);
+
+    // Same matrices in SoA
+    PRNG soa_prng;
+    soa_prng.Initialize(2015, true); // quiet == true
+    std::vector<double> soa(9*n);
+    prng::Fill_Random_Rotation_Matrices(soa_prng, &soa[0], n, PRNG_SoA);
+    for (uint64_t i = 0 ; i < n ; i++)
+        for (uint64_t c = 0 ; c < 9 ; c++)
+            BOOST_REQUIRE_EQUAL(soa[c*n + i], R[9*i + c]);
+}
+
+BOOST_AUTO_TEST_CASE(Geometry_Points_In_Volumes)
+{
+    PRNG prng, soa_prng;
+    prng.Initialize(11, true);      // quiet == true
+    soa_prng.Initialize(11, true);  // quiet == true
+
+    const uint64_t n = 100003;
+    std::vector<double> p(3*n), soa(3*n);
+    const double center[3] = {1.0, -2.0, 3.0};
+
+    // Box
+    const double low[3] = {-1.0, 0.0, 10.0}, high[3] = {1.0, 0.5, 13.0};
+    prng::Fill_Points_In_Box(prng, &p[0], n, low, high);
+    prng::Fill_Points_In_Box(soa_prng, &soa[0], n, low, high, PRNG_SoA);
+    double mean[3] = {0.0, 0.0, 0.0};
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        for (int c = 0 ; c < 3 ; c++)
+        {
+            BOOST_REQUIRE(p[3*i + c] >= low[c] && p[3*i + c] < high[c]);
+            BOOST_REQUIRE_EQUAL(p[3*i + c], soa[uint64_t(c)*n + i]);
+            mean[c] += p[3*i + c] / double(n);
+        }
+    }
+    for (int c = 0 ; c < 3 ; c++)
+        BOOST_CHECK_SMALL(mean[c] - 0.5 * (low[c] + high[c]), 0.01 * (high[c] - low[c]));
+
+    // Ball: an eighth of the points within half the radius
+    const double radius = 2.0;
+    prng::Fill_Points_In_Ball(prng, &p[0], n, center, radius);
+    prng::Fill_Points_In_Ball(soa_prng, &soa[0], n, center, radius, PRNG_SoA);
+    uint64_t nb_inner = 0;
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        double r2 = 0.0;
+        for (int c = 0 ; c < 3 ; c++)
+        {
+            BOOST_REQUIRE_EQUAL(p[3*i + c], soa[uint64_t(c)*n + i]);
+            r2 += (p[3*i + c] - center[c]) * (p[3*i + c] - center[c]);
+        }
+        BOOST_REQUIRE(std::sqrt(r2) <= radius * (1.0 + 1.0e-14));
+        nb_inner += (r2 < 0.25 * radius * radius ? 1 : 0);
+    }
+    BOOST_CHECK_CLOSE(double(nb_inner) / double(n), 0.125, 3.0);
+
+    // Shell: half the volume below the radius of cube (r_in^3 + r_out^3) / 2
+    const double inner = 1.0, outer = 2.0;
+    prng::Fill_Points_In_Shell(prng, &p[0], n, center, inner, outer);
+    nb_inner = 0;
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        double r2 = 0.0;
+        for (int c = 0 ; c < 3 ; c++)
+            r2 += (p[3*i + c] - center[c]) * (p[3*i + c] - center[c]);
+        const double r = std::sqrt(r2);
+        BOOST_REQUIRE(r >= inner * (1.0 - 1.0e-14) && r <= outer * (1.0 + 1.0e-14));
+        nb_inner += (r * r * r < 4.5 ? 1 : 0);
+    }
+    BOOST_CHECK_CLOSE(double(nb_inner) / double(n), 0.5, 1.0);
+
+    // Disk: a quarter of the points within half the radius
+    prng::Fill_Points_In_Disk(prng, &p[0], n, center, radius);
+    nb_inner = 0;
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        const double r2 = (p[2*i] - center[0]) * (p[2*i] - center[0]) + (p[2*i + 1] - center[1]) * (p[2*i + 1] - center[1]);
+        BOOST_REQUIRE(std::sqrt(r2) <= radius * (1.0 + 1.0e-14));
+        nb_inner += (r2 < 0.25 * radius * radius ? 1 : 0);
+    }
+    BOOST_CHECK_CLOSE(double(nb_inner) / double(n), 0.25, 2.0);
+
+    // Unit tetrahedron and triangle: inside, centered on the centroid
+    const double o[3] = {0.0, 0.0, 0.0}, x[3] = {1.0, 0.0, 0.0}, y[3] = {0.0, 1.0, 0.0}, z[3] = {0.0, 0.0, 1.0};
+    prng::Fill_Points_In_Tetrahedron(prng, &p[0], n, o, x, y, z);
+    double sums[3] = {0.0, 0.0, 0.0};
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        BOOST_REQUIRE(p[3*i] >= 0.0 && p[3*i + 1] >= 0.0 && p[3*i + 2] >= 0.0);
+        BOOST_REQUIRE(p[3*i] + p[3*i + 1] + p[3*i + 2] <= 1.0 + 1.0e-15);
+        for (int c = 0 ; c < 3 ; c++)
+            sums[c] += p[3*i + c];
+    }
+    for (int c = 0 ; c < 3 ; c++)
+        BOOST_CHECK_CLOSE(sums[c] / double(n), 0.25, 1.0);
+
+    prng::Fill_Points_In_Triangle(prng, &p[0], n, x, y, z);
+    sums[0] = sums[1] = sums[2] = 0.0;
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        BOOST_REQUIRE(p[3*i] >= 0.0 && p[3*i + 1] >= 0.0 && p[3*i + 2] >= -1.0e-15);
+        BOOST_REQUIRE_SMALL(p[3*i] + p[3*i + 1] + p[3*i + 2] - 1.0, 1.0e-15);
+        for (int c = 0 ; c < 3 ; c++)
+            sums[c] += p[3*i + c];
+    }
+    for (int c = 0 ; c < 3 ; c++)
+        BOOST_CHECK_CLOSE(sums[c] / double(n), 1.0 / 3.0, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(Geometry_Triangle_Mesh_Sampler)
+{
+    PRNG prng;
+    prng.Initialize(5, true); // quiet == true
+
+    // Triangles of areas 0.5, 1.5 and 0 (degenerate), in the z = 0 plane
+    const double vertices[] = {0.0, 0.0, 0.0,   1.0, 0.0, 0.0,   0.0, 1.0, 0.0,
+                               10.0, 0.0, 0.0,  13.0, 0.0, 0.0,  10.0, 1.0, 0.0,
+                               20.0, 0.0, 0.0,  21.0, 0.0, 0.0};
+    const uint32_t triangles[] = {0, 1, 2,  3, 4, 5,  6, 7, 6};
+    const Triangle_Mesh_Sampler mesh(vertices, triangles, 3);
+    BOOST_CHECK_EQUAL(mesh.Get_Nb_Triangles(), 3U);
+    BOOST_CHECK_CLOSE(mesh.Get_Area(), 2.0, 1.0e-12);
+
+    const uint64_t n = 100003;
+    std::vector<double> p(3*n);
+    std::vector<uint32_t> indices(n);
+    mesh.Fill_Points(prng, &p[0], n, PRNG_AoS, &indices[0]);
+    uint64_t counts[3] = {0, 0, 0};
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        BOOST_REQUIRE(indices[i] < 2);
+        counts[indices[i]]++;
+        BOOST_REQUIRE_EQUAL(p[3*i + 2], 0.0);
+        const double offset = (indices[i] == 0 ? 0.0 : 10.0);
+        const double width  = (indices[i] == 0 ? 1.0 : 3.0);
+        BOOST_REQUIRE(p[3*i] >= offset && p[3*i + 1] >= 0.0);
+        BOOST_REQUIRE((p[3*i] - offset) / width + p[3*i + 1] <= 1.0 + 1.0e-14);
+    }
+    BOOST_CHECK_CLOSE(double(counts[0]) / double(n), 0.25, 2.0);
+}
+
+// ********** End of file ***************************************
@@ -0,0 +1,55 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Incremental_PRNG.hpp>
+
+#include "Bits.hpp"
+
+BOOST_AUTO_TEST_CASE(Incremental_PRNG_Same_Sequence_As_PRNG)
+{
+    // Many blocks, whatever the Mersenne exponent
+    const int N = 1000000;
+
+    Incremental_PRNG incremental_prng;
+    incremental_prng.Initialize(2011, true); // quiet == true
+
+    PRNG prng;
+    prng.Initialize(2011, true); // quiet == true
+
+    int nb_errors = 0;
+    for (int i = 0 ; i < N ; i++)
+    {
+        if (!Same_Bits(incremental_prng.Get_Random_Close1_Open2(), prng.Get_Random_Close1_Open2()))
+            ++nb_errors;
+    }
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+    BOOST_CHECK_EQUAL(incremental_prng.Get_Nb_Calls(), uint64_t(N));
+
+    for (int i = 0 ; i < 1000 ; i++)
+    {
+        if (!Same_Bits(incremental_prng.Get_Random_CloseN1_Close1(), prng.Get_Random_CloseN1_Close1()))
+            ++nb_errors;
+    }
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Incremental_PRNG_Reinitialize)
+{
+    Incremental_PRNG incremental_prng;
+    incremental_prng.Initialize(1, true); // quiet == true
+    for (int i = 0 ; i < 12345 ; i++)
+        incremental_prng.Get_Random();
+
+    // Re-initializing discards the partially computed block.
+    incremental_prng.Initialize(7, true); // quiet == true
+    PRNG prng;
+    prng.Initialize(7, true); // quiet == true
+    int nb_errors = 0;
+    for (int i = 0 ; i < 100000 ; i++)
+    {
+        if (!Same_Bits(incremental_prng.Get_Random(), prng.Get_Random()))
+            ++nb_errors;
+    }
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+}
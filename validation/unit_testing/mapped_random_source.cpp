@@ -0,0 +1,70 @@
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio> // remove()
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Mapped_Random_Source.hpp>
+#include <Memory.hpp>
+
+#include "Bits.hpp"
+
+BOOST_AUTO_TEST_CASE(Mapped_Random_Source_Same_As_PRNG)
+{
+    const char *filename = "unit_testing_pool.bin";
+    const uint64_t N = 1000003;
+    const uint32_t seed = 42;
+
+    BOOST_REQUIRE(Mapped_Random_Source::Generate(filename, seed, N, PRNG_Close0_Open1, true)); // quiet == true
+
+    Mapped_Random_Source pool;
+    BOOST_REQUIRE(pool.Open(filename, true)); // quiet == true
+    BOOST_CHECK_EQUAL(pool.Get_Count(), N);
+    BOOST_CHECK_EQUAL(pool.Get_Seed(), seed);
+    BOOST_CHECK_EQUAL(pool.Get_Interval(), int(PRNG_Close0_Open1));
+    BOOST_CHECK(pool.Verify());
+
+    PRNG prng;
+    prng.Initialize(seed, true); // quiet == true
+
+    // Sequential access
+    int nb_errors = 0;
+    for (uint64_t i = 0 ; i < 1000 ; i++)
+    {
+        if (!Same_Bits(pool.Get_Random(), prng.Get_Random_Close0_Open1()))
+            ++nb_errors;
+    }
+    // Zero-copy block access continues the sequence
+    const double *block = pool.Get_Block(N - 1000);
+    for (uint64_t i = 0 ; i < N - 1000 ; i++)
+    {
+        if (!Same_Bits(block[i], prng.Get_Random_Close0_Open1()))
+            ++nb_errors;
+    }
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+    BOOST_CHECK_EQUAL(pool.Get_Position(), N);
+
+    // Random access
+    BOOST_CHECK_EQUAL(pool.Get_Value(1000), pool.Get_Values()[1000]);
+    pool.Seek(10);
+    BOOST_CHECK_EQUAL(pool.Get_Random(), pool.Get_Value(10));
+
+    pool.Close();
+    remove(filename);
+}
+
+BOOST_AUTO_TEST_CASE(Mapped_Random_Source_Rejects_Invalid_File)
+{
+    const char *filename = "unit_testing_not_a_pool.bin";
+    FILE *file = fopen(filename, "wb");
+    BOOST_REQUIRE(file != NULL);
+    fprintf(file, "Not a pool\n");
+    fclose(file);
+
+    Mapped_Random_Source pool;
+    BOOST_CHECK(!pool.Open(filename, true)); // quiet == true
+    BOOST_CHECK(!pool.Open("unit_testing_missing_pool.bin", true)); // quiet == true
+
+    remove(filename);
+}
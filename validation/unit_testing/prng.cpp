@@ -2,10 +2,18 @@
 #include <boost/test/unit_test.hpp>
 
 #include <cmath>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <utility> // std::pair
+#include <unistd.h> // fork(), pipe()
+#include <sys/wait.h> // waitpid()
 
 #include <PseudoRandomNumberGenerator.hpp>
 #include <Memory.hpp>
 
+#include "Bits.hpp"
+
 BOOST_AUTO_TEST_CASE(PRNG_Seed_Time_Get_Random)
 {
     // Initialize object
@@ -140,3 +148,426 @@ BOOST_AUTO_TEST_CASE(PRNG_Reloading)
     }
 }
 
+
+BOOST_AUTO_TEST_CASE(PRNG_Copy_Is_Independent)
+{
+    const int N = 5000;
+    PRNG prng;
+    prng.Initialize(2718, true);    // quiet == true
+    for (int i = 0 ; i < 1000 ; i++)
+        prng.Get_Random();
+
+    // A copy continues with the same numbers, from its own state: the
+    // original's draws don't move it
+    PRNG copy(prng);
+    BOOST_CHECK_EQUAL(copy.Get_Nb_Calls(), prng.Get_Nb_Calls());
+    std::vector<double> expected(N);
+    for (int i = 0 ; i < N ; i++)
+        expected[i] = prng.Get_Random();
+    int nb_errors = 0;
+    for (int i = 0 ; i < N ; i++)
+        nb_errors += (Same_Bits(copy.Get_Random(), expected[i]) ? 0 : 1);
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+
+    // Assignment to an initialized generator, in a block converted by
+    // Next_Block() (restored by both before the next block)
+    uint64_t size;
+    prng.Next_Block(size, PRNG_Open0_Open1);
+    PRNG assigned;
+    assigned.Initialize(1, true);   // quiet == true
+    assigned = prng;
+    for (int i = 0 ; i < N ; i++)
+        expected[i] = prng.Get_Random_Close1_Open2();
+    nb_errors = 0;
+    for (int i = 0 ; i < N ; i++)
+        nb_errors += (Same_Bits(assigned.Get_Random_Close1_Open2(), expected[i]) ? 0 : 1);
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+
+    // Copies made by a growing std::vector
+    std::vector<PRNG> prngs;
+    for (int k = 0 ; k < 10 ; k++)
+        prngs.push_back(prng);
+    const double next = prng.Get_Random();
+    for (int k = 0 ; k < 10 ; k++)
+        BOOST_CHECK(Same_Bits(prngs[k].Get_Random(), next));
+}
+
+
+BOOST_AUTO_TEST_CASE(PRNG_Fill_Array_Same_As_One_At_A_Time)
+{
+    // Odd sizes and offsets make sure the partially used block, the bulk
+    // generation and the one-at-a-time tail all line up.
+    const int nb_sizes = 6;
+    const int sizes[nb_sizes] = {1, 7, 382, 383, 1001, 100000};
+    const int N = 2*100000 + 2;
+
+    double *array_one = (double *) calloc_and_check(N, sizeof(double));
+    double *array_bulk = (double *) calloc_and_check(N, sizeof(double));
+
+    for (int s = 0 ; s < nb_sizes ; s++)
+    {
+        for (int offset = 0 ; offset < 2 ; offset++)
+        {
+            PRNG prng_one;
+            PRNG prng_bulk;
+            prng_one.Initialize(s, true);   // quiet == true
+            prng_bulk.Initialize(s, true);  // quiet == true
+
+            // Start in the middle of a block
+            for (int i = 0 ; i < 5 ; i++)
+            {
+                prng_one.Get_Random_Close1_Open2();
+                prng_bulk.Get_Random_Close1_Open2();
+            }
+
+            for (int i = 0 ; i < sizes[s] ; i++)
+                array_one[i] = prng_one.Get_Random_CloseN1_Open1();
+            for (int i = 0 ; i < sizes[s] ; i++)
+                array_one[sizes[s]+i] = prng_one.Get_Random();
+            const double next_one = prng_one.Get_Random_Close0_Open1();
+
+            prng_bulk.Fill_Array_CloseN1_Open1(&array_bulk[offset], sizes[s]);
+            prng_bulk.Fill_Array_Random(&array_bulk[offset+sizes[s]], sizes[s]);
+            const double next_bulk = prng_bulk.Get_Random_Close0_Open1();
+
+            BOOST_CHECK_EQUAL(prng_one.Get_Nb_Calls(), prng_bulk.Get_Nb_Calls());
+            BOOST_CHECK(memcmp(array_one, &array_bulk[offset], 2*sizes[s]*sizeof(double)) == 0);
+            BOOST_CHECK_EQUAL(next_one, next_bulk);
+        }
+    }
+
+    free(array_one);
+    free(array_bulk);
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_Fill_Array_Uint64_Packs_Mantissas)
+{
+    const int N = 1000;
+    PRNG prng_bits;
+    PRNG prng_doubles;
+    prng_bits.Initialize(1234, true);       // quiet == true
+    prng_doubles.Initialize(1234, true);    // quiet == true
+
+    uint64_t *array = (uint64_t *) calloc_and_check(N, sizeof(uint64_t));
+    prng_bits.Fill_Array_Uint64(array, N);
+
+    // 16 draws are consumed per group of 13 integers.
+    BOOST_CHECK_EQUAL(prng_bits.Get_Nb_Calls(), uint64_t(16 * ((N + 12) / 13)));
+
+    // Rebuild the bit stream, least significant bits first.
+    union {
+        double   d;
+        uint64_t u;
+    } bits;
+    int nb_errors = 0;
+    int word = 0;
+    int bit = 0;
+    for (int i = 0 ; i < 16 * (N / 13) ; i++)
+    {
+        bits.d = prng_doubles.Get_Random_Close1_Open2();
+        for (int b = 0 ; b < 52 ; b++)
+        {
+            if (((array[word] >> bit) & 1) != ((bits.u >> b) & 1))
+                ++nb_errors;
+            if (++bit == 64)
+            {
+                bit = 0;
+                ++word;
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+
+    free(array);
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_Stats_Counters)
+{
+    const int N = 100000;
+    PRNG prng;
+    prng.Initialize(1234, true);    // quiet == true
+
+    for (int i = 0 ; i < N ; i++)
+        prng.Get_Random();
+    double xyz[3];
+    for (int i = 0 ; i < 1000 ; i++)
+        prng.Get_Random_Direction(xyz);
+
+    const PRNG_Stats &stats = prng.Get_Stats();
+#ifdef PRNG_STATS
+    // Blocks are regenerated on the first call and every time one is used up.
+    BOOST_CHECK(stats.nb_refills >= uint64_t(N) / 2000);
+    BOOST_CHECK(stats.nb_refills <= uint64_t(N) / 2 + 1);
+    BOOST_CHECK_EQUAL(stats.direction_calls, uint64_t(1000));
+    // Two uniforms in [-1,1] per attempt, each possibly rejected by Close0_Close1()
+    BOOST_CHECK(stats.direction_uniforms >= 2 * (stats.direction_calls + stats.direction_rejections));
+    BOOST_CHECK_EQUAL(stats.direction_uniforms, 2 * (stats.direction_calls + stats.direction_rejections)
+                                                + stats.close0_close1_rejections);
+    // pi/4 acceptance
+    BOOST_CHECK(stats.direction_rejections > 100 && stats.direction_rejections < 500);
+
+    const uint64_t refills = stats.nb_refills;
+    const PRNG_Stats before = prng::Get_Stats();
+    prng.Merge_Stats();
+    BOOST_CHECK_EQUAL(prng.Get_Stats().nb_refills, uint64_t(0));
+    BOOST_CHECK_EQUAL(prng::Get_Stats().nb_refills, before.nb_refills + refills);
+#else  // #ifdef PRNG_STATS
+    // Nothing is counted
+    BOOST_CHECK_EQUAL(stats.nb_refills, uint64_t(0));
+    BOOST_CHECK_EQUAL(stats.direction_calls, uint64_t(0));
+#endif // #ifdef PRNG_STATS
+}
+
+// Sums the blocks given to PRNG::Consume_Block()
+class Block_Sum
+{
+    public:
+        double sum;
+        Block_Sum() : sum(0.0) {}
+        void operator()(const double *block, const uint64_t size)
+        {
+            for (uint64_t i = 0 ; i < size ; i++)
+                sum += block[i];
+        }
+};
+
+BOOST_AUTO_TEST_CASE(PRNG_Next_Block_Same_As_One_At_A_Time)
+{
+    const int N = 100000;
+    const int intervals[] = {PRNG_Close1_Open2, PRNG_Close0_Open1, PRNG_Open0_Close1, PRNG_Open0_Open1, PRNG_CloseN1_Open1};
+
+    double *expected = (double *) calloc_and_check(N, sizeof(double));
+    double *values   = (double *) calloc_and_check(N, sizeof(double));
+
+    for (int t = 0 ; t < 5 ; t++)
+    {
+        const int interval = intervals[t];
+        PRNG prng_reference;
+        prng_reference.Initialize(4321, true);  // quiet == true
+        prng_reference.Fill_Array(expected, N, interval);
+
+        // Mix blocks, one at a time calls and bulk fills; all but the
+        // one at a time calls of Open0_Open1 (no such function) must
+        // follow the reference sequence.
+        PRNG prng;
+        prng.Initialize(4321, true);    // quiet == true
+        int i = 0;
+        int round = 0;
+        while (i < N)
+        {
+            if (round % 3 == 1 && interval != PRNG_Open0_Open1)
+            {
+                for (int j = 0 ; j < 17 && i < N ; j++)
+                {
+                    double r = prng.Get_Random_Close1_Open2();
+                    if      (interval == PRNG_Close0_Open1)   r = r - 1.0;
+                    else if (interval == PRNG_Open0_Close1)   r = 2.0 - r;
+                    else if (interval == PRNG_CloseN1_Open1)  r = 2.0 * r - 3.0;
+                    values[i++] = r;
+                }
+            }
+            else if (round % 5 == 2)
+            {
+                const int n = std::min(N - i, 1000);
+                prng.Fill_Array(&values[i], n, interval);
+                i += n;
+            }
+            else
+            {
+                uint64_t size;
+                const double *block = prng.Next_Block(size, interval);
+                BOOST_REQUIRE(size > 0);
+                for (uint64_t j = 0 ; j < size && i < N ; j++)
+                    values[i++] = block[j];
+            }
+            ++round;
+        }
+
+        int nb_errors = 0;
+        for (i = 0 ; i < N ; i++)
+        {
+            if (memcmp(&values[i], &expected[i], sizeof(double)) != 0)
+                ++nb_errors;
+        }
+        BOOST_CHECK_EQUAL(nb_errors, 0);
+    }
+
+    // Callback version, and the calls are counted
+    PRNG prng;
+    prng.Initialize(4321, true);    // quiet == true
+    PRNG prng_reference;
+    prng_reference.Initialize(4321, true);  // quiet == true
+    Block_Sum block_sum;
+    const uint64_t size = prng.Consume_Block(block_sum, PRNG_Close0_Open1);
+    double sum = 0.0;
+    for (uint64_t j = 0 ; j < size ; j++)
+        sum += prng_reference.Get_Random_Close0_Open1();
+    BOOST_CHECK_EQUAL(block_sum.sum, sum);
+    BOOST_CHECK_EQUAL(prng.Get_Nb_Calls(), size);
+    BOOST_CHECK_EQUAL(prng.Get_Random(), prng_reference.Get_Random());
+
+    free(expected);
+    free(values);
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_Jump_Same_As_Generating)
+{
+    // Jumps inside a block, across one or many blocks, from a block
+    // partially used by one at a time calls or by Next_Block().
+    const int nb_jumps = 7;
+    const int jumps[nb_jumps] = {0, 1, 5, 382, 383, 1000, 123457};
+
+    for (int j = 0 ; j < nb_jumps ; j++)
+    {
+        PRNG prng_one;
+        PRNG prng_jump;
+        prng_one.Initialize(j, true);   // quiet == true
+        prng_jump.Initialize(j, true);  // quiet == true
+
+        for (int i = 0 ; i < 3 ; i++)
+        {
+            prng_one.Get_Random_Close1_Open2();
+            prng_jump.Get_Random_Close1_Open2();
+        }
+        if (j % 2 == 1)
+        {
+            uint64_t size;
+            prng_one.Next_Block(size, PRNG_Close0_Open1);
+            prng_jump.Next_Block(size, PRNG_Close0_Open1);
+        }
+
+        for (int i = 0 ; i < jumps[j] ; i++)
+            prng_one.Get_Random_Close1_Open2();
+        prng_jump.Jump(uint64_t(jumps[j]));
+
+        BOOST_CHECK_EQUAL(prng_one.Get_Nb_Calls(), prng_jump.Get_Nb_Calls());
+        for (int i = 0 ; i < 1000 ; i++)
+            BOOST_CHECK_EQUAL(prng_one.Get_Random_Close1_Open2(), prng_jump.Get_Random_Close1_Open2());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_Parallel_Fill_Same_As_Fill_Array)
+{
+    // Sizes smaller than a block, not a multiple of the number of threads,
+    // and more threads than blocks.
+    const int nb_sizes = 4;
+    const int sizes[nb_sizes] = {100, 1001, 38200, 250001};
+    const int nb_thread_counts = 4;
+    const int thread_counts[nb_thread_counts] = {1, 2, 3, 8};
+    const int N = 250001;
+
+    double *array_serial = (double *) calloc_and_check(N, sizeof(double));
+    double *array_parallel = (double *) calloc_and_check(N, sizeof(double));
+
+    for (int s = 0 ; s < nb_sizes ; s++)
+    {
+        for (int t = 0 ; t < nb_thread_counts ; t++)
+        {
+            PRNG prng_serial;
+            PRNG prng_parallel;
+            prng_serial.Initialize(s, true);    // quiet == true
+            prng_parallel.Initialize(s, true);  // quiet == true
+
+            // Start in the middle of a block
+            for (int i = 0 ; i < 2*t ; i++)
+            {
+                prng_serial.Get_Random_Close1_Open2();
+                prng_parallel.Get_Random_Close1_Open2();
+            }
+
+            prng_serial.Fill_Array(array_serial, sizes[s], PRNG_Open0_Open1);
+            prng_parallel.Parallel_Fill(array_parallel, sizes[s], thread_counts[t], PRNG_Open0_Open1);
+
+            BOOST_CHECK(memcmp(array_serial, array_parallel, sizes[s]*sizeof(double)) == 0);
+            BOOST_CHECK_EQUAL(prng_serial.Get_Nb_Calls(), prng_parallel.Get_Nb_Calls());
+            BOOST_CHECK_EQUAL(prng_serial.Get_Random(), prng_parallel.Get_Random());
+        }
+    }
+
+    free(array_serial);
+    free(array_parallel);
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_Initialize_Rank_Disjoint_Processes)
+{
+    // Like a parallel job: one forked process per rank, each sending
+    // its first numbers back through a pipe.
+    const uint32_t master_seed = 2013;
+    const int nb_ranks = 4;
+    const int N = 20000;
+
+    std::vector<std::vector<double> > values(nb_ranks, std::vector<double>(N));
+    std::vector<pid_t> pids(nb_ranks);
+    std::vector<int> pipes(nb_ranks);
+    for (int rank = 0 ; rank < nb_ranks ; rank++)
+    {
+        int fds[2];
+        BOOST_REQUIRE(pipe(fds) == 0);
+        pids[rank] = fork();
+        BOOST_REQUIRE(pids[rank] >= 0);
+        if (pids[rank] == 0)
+        {
+            close(fds[0]);
+            PRNG prng;
+            prng.Initialize_Rank(master_seed, rank, nb_ranks, true); // quiet == true
+            prng.Fill_Array_Close1_Open2(&values[rank][0], N);
+            const char *data = (const char *) &values[rank][0];
+            size_t size = N * sizeof(double);
+            while (size > 0)
+            {
+                const ssize_t written = write(fds[1], data, size);
+                if (written <= 0)
+                    _exit(EXIT_FAILURE);
+                data += written;
+                size -= size_t(written);
+            }
+            _exit(EXIT_SUCCESS);
+        }
+        close(fds[1]);
+        pipes[rank] = fds[0];
+    }
+
+    for (int rank = 0 ; rank < nb_ranks ; rank++)
+    {
+        char *data = (char *) &values[rank][0];
+        size_t size = N * sizeof(double);
+        while (size > 0)
+        {
+            const ssize_t nb_read = read(pipes[rank], data, size);
+            if (nb_read <= 0)
+                break;
+            data += nb_read;
+            size -= size_t(nb_read);
+        }
+        close(pipes[rank]);
+        int status;
+        BOOST_REQUIRE(waitpid(pids[rank], &status, 0) == pids[rank]);
+        BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+        BOOST_CHECK_EQUAL(size, size_t(0));
+    }
+
+    // Rank 0 is the plain sequence; the others are reproducible and
+    // don't depend on the number of ranks.
+    PRNG prng;
+    prng.Initialize(master_seed, true);    // quiet == true
+    for (int i = 0 ; i < N ; i++)
+        BOOST_CHECK_EQUAL(values[0][i], prng.Get_Random_Close1_Open2());
+    PRNG prng_rank;
+    prng_rank.Initialize_Rank(master_seed, 2, 2*nb_ranks, true);  // quiet == true
+    for (int i = 0 ; i < N ; i++)
+        BOOST_CHECK_EQUAL(values[2][i], prng_rank.Get_Random_Close1_Open2());
+
+    // Overlapping substreams would share numbers
+    std::vector<std::pair<double, int> > all;
+    for (int rank = 0 ; rank < nb_ranks ; rank++)
+        for (int i = 0 ; i < N ; i++)
+            all.push_back(std::make_pair(values[rank][i], rank));
+    std::sort(all.begin(), all.end());
+    int nb_shared = 0;
+    for (size_t i = 1 ; i < all.size() ; i++)
+    {
+        if (Same_Bits(all[i].first, all[i-1].first) && all[i].second != all[i-1].second)
+            ++nb_shared;
+    }
+    BOOST_CHECK_EQUAL(nb_shared, 0);
+}
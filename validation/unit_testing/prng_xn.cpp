@@ -0,0 +1,92 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <PRNG_xN.hpp>
+
+// Numbers per dSFMT block
+static uint64_t Block_Size(PRNG &prng)
+{
+    return 2 * uint64_t((prng.Get_Mersenne_Exponent() - 128) / 104 + 1);
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_xN_Lanes_Are_Rank_Substreams)
+{
+    const int nb_lanes = 4;
+    const uint64_t n = 3001; // Not a multiple of the block size, drawn in two calls
+    PRNG_xN prngs(nb_lanes);
+    prngs.Initialize(42);
+    BOOST_CHECK_EQUAL(prngs.Get_Nb_Lanes(), nb_lanes);
+
+    std::vector<double> first(nb_lanes * 1001), second(nb_lanes * 2000);
+    prngs.Fill_Lanes(&first[0], 1001, PRNG_Close1_Open2);
+    prngs.Fill_Lanes(&second[0], 2000, PRNG_Close0_Open1);
+
+    for (int l = 0 ; l < nb_lanes ; l++)
+    {
+        PRNG prng;
+        prng.Initialize_Rank(42, l, nb_lanes, true); // quiet == true
+        std::vector<double> expected(n);
+        prng.Fill_Array(&expected[0], n, PRNG_Close1_Open2);
+        for (uint64_t k = 0 ; k < 1001 ; k++)
+            BOOST_REQUIRE_EQUAL(first[l * 1001 + k], expected[k]);
+        for (uint64_t k = 0 ; k < 2000 ; k++)
+            BOOST_REQUIRE_EQUAL(second[l * 2000 + k], expected[1001 + k] - 1.0);
+    }
+
+    // Lane 0 of substream 2 is lane 2
+    PRNG_xN shifted(nb_lanes);
+    shifted.Initialize(42, 2);
+    std::vector<double> lanes(nb_lanes * 100);
+    shifted.Fill_Lanes(&lanes[0], 100, PRNG_Close1_Open2);
+    PRNG prng;
+    prng.Initialize_Rank(42, 2, nb_lanes, true); // quiet == true
+    for (uint64_t k = 0 ; k < 100 ; k++)
+        BOOST_REQUIRE_EQUAL(lanes[k], prng.Get_Random_Close1_Open2());
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_xN_Interleaved_Stream)
+{
+    const int nb_lanes = 8;
+    PRNG_xN prngs(nb_lanes);
+    prngs.Initialize(7);
+
+    std::vector<PRNG> lanes(nb_lanes);
+    for (int l = 0 ; l < nb_lanes ; l++)
+        lanes[l].Initialize_Rank(7, l, nb_lanes, true); // quiet == true
+    const uint64_t block = Block_Size(lanes[0]);
+
+    // Three blocks of all lanes, read two numbers at a time from each
+    const uint64_t n = 3 * block * nb_lanes;
+    std::vector<double> expected(n);
+    for (uint64_t b = 0 ; b < 3 ; b++)
+    {
+        std::vector<double> lane_blocks(nb_lanes * block);
+        for (int l = 0 ; l < nb_lanes ; l++)
+            lanes[l].Fill_Array(&lane_blocks[l * block], block, PRNG_Close1_Open2);
+        for (uint64_t i = 0 ; i < block / 2 ; i++)
+            for (int l = 0 ; l < nb_lanes ; l++)
+            {
+                expected[b * block * nb_lanes + (i * nb_lanes + l) * 2]     = lane_blocks[l * block + 2 * i];
+                expected[b * block * nb_lanes + (i * nb_lanes + l) * 2 + 1] = lane_blocks[l * block + 2 * i + 1];
+            }
+    }
+
+    // One at a time, then in bulk across block boundaries, in other intervals
+    std::vector<double> values(n);
+    for (uint64_t i = 0 ; i < 5 ; i++)
+        values[i] = prngs.Get_Random_Close1_Open2();
+    prngs.Fill_Array(&values[5], block * nb_lanes, PRNG_Open0_Close1);
+    prngs.Fill_Array(&values[5 + block * nb_lanes], n - 5 - block * nb_lanes, PRNG_CloseN1_Open1);
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        double e = expected[i];
+        if (i >= 5 + block * nb_lanes)
+            e = 2.0 * e - 3.0;
+        else if (i >= 5)
+            e = 2.0 - e;
+        BOOST_REQUIRE_EQUAL(values[i], e);
+    }
+}
@@ -0,0 +1,207 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <cmath>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <QRNG.hpp>
+
+#include "Bits.hpp"
+
+BOOST_AUTO_TEST_CASE(Sobol_Reference_Points)
+{
+    // Unscrambled Joe & Kuo points (as SciPy's), coordinate times 2^32
+    const int nb_references = 6;
+    const uint64_t indexes[nb_references]     = {1, 5, 12345, 65535, 69999, 777};
+    const int      dimensions[nb_references]  = {0, 1, 17, 500, 1023, 1023};
+    const double   expected[nb_references]    = {2147483648.0, 3758096384.0, 218890240.0,
+                                                 2011496448.0, 3537076224.0, 1941962752.0};
+
+    Sobol sobol(Sobol::max_dimension);
+    std::vector<double> point(Sobol::max_dimension);
+    for (int r = 0 ; r < nb_references ; r++)
+    {
+        sobol.Set_Index(indexes[r]);
+        sobol.Next_Point(&point[0], PRNG_Close0_Open1);
+        BOOST_CHECK_EQUAL(point[dimensions[r]] * 4294967296.0, expected[r]);
+        BOOST_CHECK_EQUAL(sobol.Get_Index(), indexes[r] + 1);
+    }
+
+    // First points of the first dimensions
+    Sobol sobol_2d(2);
+    const double first_points[4][2] = {{0.0, 0.0}, {0.5, 0.5}, {0.75, 0.25}, {0.25, 0.75}};
+    for (int i = 0 ; i < 4 ; i++)
+    {
+        sobol_2d.Next_Point(&point[0], PRNG_Close0_Open1);
+        BOOST_CHECK_EQUAL(point[0], first_points[i][0]);
+        BOOST_CHECK_EQUAL(point[1], first_points[i][1]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Halton_Reference_Points)
+{
+    // Radical inverses in bases 2, 3 and 5
+    Halton halton(3);
+    const double expected[6][3] = {{0.0,   0.0,     0.0},
+                                   {0.5,   1.0/3.0, 0.2},
+                                   {0.25,  2.0/3.0, 0.4},
+                                   {0.75,  1.0/9.0, 0.6},
+                                   {0.125, 4.0/9.0, 0.8},
+                                   {0.625, 7.0/9.0, 0.04}};
+    double point[3];
+    for (int i = 0 ; i < 6 ; i++)
+    {
+        halton.Next_Point(point, PRNG_Close0_Open1);
+        for (int d = 0 ; d < 3 ; d++)
+            BOOST_CHECK_SMALL(point[d] - expected[i][d], 1.0e-15);
+    }
+}
+
+// **************************************************************
+void Check_Fill_Array_And_Skip(QRNG &qrng_one, QRNG &qrng_bulk, QRNG &qrng_skip)
+{
+    // Bulk structure of arrays fills, one point at a time and direct
+    // access give the same points.
+    const int dimension = qrng_one.Get_Dimension();
+    const int N = 1000;
+    std::vector<double> one(dimension);
+    std::vector<double> bulk(dimension * N);
+    std::vector<double> skip(dimension);
+
+    qrng_one.Skip(37);
+    qrng_bulk.Skip(37);
+    qrng_bulk.Fill_Array(&bulk[0], N, PRNG_Open0_Open1);
+    int nb_errors = 0;
+    for (int i = 0 ; i < N ; i++)
+    {
+        qrng_one.Next_Point(&one[0], PRNG_Open0_Open1);
+        for (int d = 0 ; d < dimension ; d++)
+        {
+            if (!Same_Bits(one[d], bulk[d*N + i]) || !(0.0 < one[d] && one[d] < 1.0))
+                ++nb_errors;
+        }
+    }
+    BOOST_CHECK_EQUAL(nb_errors, 0);
+    BOOST_CHECK_EQUAL(qrng_one.Get_Index(), qrng_bulk.Get_Index());
+
+    qrng_skip.Set_Index(37 + N - 1);
+    qrng_skip.Next_Point(&skip[0], PRNG_Open0_Open1);
+    for (int d = 0 ; d < dimension ; d++)
+        BOOST_CHECK_EQUAL(skip[d], one[d]);
+}
+
+BOOST_AUTO_TEST_CASE(QRNG_Fill_Array_And_Skip)
+{
+    PRNG prng;
+    prng.Initialize(2013, true); // quiet == true
+
+    {
+        Sobol sobol_one(20), sobol_bulk(20), sobol_skip(20);
+        Check_Fill_Array_And_Skip(sobol_one, sobol_bulk, sobol_skip);
+    }
+    {
+        Halton halton_one(20), halton_bulk(20), halton_skip(20);
+        Check_Fill_Array_And_Skip(halton_one, halton_bulk, halton_skip);
+    }
+
+    // Scrambled the same way
+    {
+        Sobol sobol_one(20), sobol_bulk(20), sobol_skip(20);
+        PRNG prng_one, prng_bulk, prng_skip;
+        prng_one.Initialize(1, true);   // quiet == true
+        prng_bulk.Initialize(1, true);  // quiet == true
+        prng_skip.Initialize(1, true);  // quiet == true
+        sobol_one.Scramble(prng_one);
+        sobol_bulk.Scramble(prng_bulk);
+        sobol_skip.Scramble(prng_skip);
+        Check_Fill_Array_And_Skip(sobol_one, sobol_bulk, sobol_skip);
+    }
+    {
+        Halton halton_one(20), halton_bulk(20), halton_skip(20);
+        PRNG prng_one, prng_bulk, prng_skip;
+        prng_one.Initialize(1, true);   // quiet == true
+        prng_bulk.Initialize(1, true);  // quiet == true
+        prng_skip.Initialize(1, true);  // quiet == true
+        halton_one.Scramble(prng_one);
+        halton_bulk.Scramble(prng_bulk);
+        halton_skip.Scramble(prng_skip);
+        Check_Fill_Array_And_Skip(halton_one, halton_bulk, halton_skip);
+    }
+}
+
+// **************************************************************
+int Nb_Empty_Strata(const double *coordinates, const int n, const int nb_strata)
+{
+    std::vector<int> counts(nb_strata, 0);
+    for (int i = 0 ; i < n ; i++)
+        counts[int(coordinates[i] * nb_strata)]++;
+    int nb_empty = 0;
+    for (int k = 0 ; k < nb_strata ; k++)
+        if (counts[k] == 0)
+            ++nb_empty;
+    return nb_empty;
+}
+
+BOOST_AUTO_TEST_CASE(QRNG_Scrambling_Keeps_Stratification)
+{
+    // The first b^m points have one coordinate in each of the b^m
+    // intervals [k/b^m, (k+1)/b^m[, scrambled or not.
+    PRNG prng;
+    prng.Initialize(2014, true); // quiet == true
+
+    const int dimension = 50;
+    const int N = 1024;
+    std::vector<double> array(dimension * N);
+    Sobol sobol(dimension);
+    sobol.Scramble(prng);
+    sobol.Fill_Array(&array[0], N, PRNG_Close0_Open1);
+    for (int d = 0 ; d < dimension ; d++)
+        BOOST_CHECK_EQUAL(Nb_Empty_Strata(&array[d*N], N, N), 0);
+
+    // Bases 2, 3 and 5
+    Halton halton(3);
+    halton.Scramble(prng);
+    const int sizes[3] = {1024, 729, 625};
+    halton.Fill_Array(&array[0], N, PRNG_Close0_Open1);
+    for (int d = 0 ; d < 3 ; d++)
+        BOOST_CHECK_EQUAL(Nb_Empty_Strata(&array[d*N], sizes[d], sizes[d]), 0);
+
+    // Scrambled points differ from unscrambled ones
+    Sobol plain_sobol(dimension);
+    std::vector<double> plain(dimension * N);
+    plain_sobol.Fill_Array(&plain[0], N, PRNG_Close0_Open1);
+    sobol.Set_Index(0);
+    sobol.Fill_Array(&array[0], N, PRNG_Close0_Open1);
+    int nb_same = 0;
+    for (int i = 0 ; i < dimension * N ; i++)
+        if (Same_Bits(array[i], plain[i]))
+            ++nb_same;
+    BOOST_CHECK(nb_same < dimension * N / 100);
+}
+
+BOOST_AUTO_TEST_CASE(QRNG_Integration_Error)
+{
+    // Integral of prod_d 2 x_d over [0,1[^d is 1. With 2^14 points, the
+    // quasi-Monte Carlo error is well below the Monte Carlo one (~1.4e-2).
+    const int dimension = 5;
+    const int N = 16384;
+    std::vector<double> array(dimension * N);
+
+    Sobol sobol(dimension);
+    Halton halton(dimension);
+    QRNG *qrngs[2] = {&sobol, &halton};
+    for (int q = 0 ; q < 2 ; q++)
+    {
+        qrngs[q]->Fill_Array(&array[0], N, PRNG_Open0_Open1);
+        double sum = 0.0;
+        for (int i = 0 ; i < N ; i++)
+        {
+            double product = 1.0;
+            for (int d = 0 ; d < dimension ; d++)
+                product *= 2.0 * array[d*N + i];
+            sum += product;
+        }
+        BOOST_CHECK_SMALL(sum / double(N) - 1.0, 5.0e-3);
+    }
+}
@@ -0,0 +1,224 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Sampling.hpp>
+
+BOOST_AUTO_TEST_CASE(Sampling_Antithetic_Pairs)
+{
+    const int nb_intervals = 5;
+    const int intervals[nb_intervals]    = {PRNG_Close1_Open2, PRNG_Close0_Open1, PRNG_Open0_Close1,
+                                            PRNG_Open0_Open1, PRNG_CloseN1_Open1};
+    // Bounds; (x - low) + (x' - low) is width, one step less or more
+    const double lows[nb_intervals]      = {1.0, 0.0, 0.0, 0.0, -1.0};
+    const double highs[nb_intervals]     = {2.0, 1.0, 1.0, 1.0, 1.0};
+    const double step = DBL_EPSILON;
+    const double unit_sums[nb_intervals] = {1.0 - step, 1.0 - step, 1.0 + step, 1.0, 2.0 - 2.0 * step};
+    const uint64_t n = 10001; // Odd: last number has no pair
+
+    for (int k = 0 ; k < nb_intervals ; k++)
+    {
+        PRNG reference, prng;
+        reference.Initialize(42, true); // quiet == true
+        prng.Initialize(42, true);      // quiet == true
+
+        std::vector<double> expected((n + 1) / 2);
+        reference.Fill_Array(&expected[0], expected.size(), intervals[k]);
+        std::vector<double> values(n);
+        prng::Fill_Antithetic(prng, &values[0], n, intervals[k]);
+
+        for (uint64_t i = 0 ; i < n / 2 ; i++)
+        {
+            BOOST_REQUIRE_EQUAL(values[2*i], expected[i]);
+            BOOST_REQUIRE_EQUAL((values[2*i] - lows[k]) + (values[2*i + 1] - lows[k]), unit_sums[k]);
+            // Same ends as the interval
+            const double mirror = values[2*i + 1];
+            if (intervals[k] == PRNG_Open0_Close1 || intervals[k] == PRNG_Open0_Open1)
+                BOOST_REQUIRE(mirror > lows[k]);
+            else
+                BOOST_REQUIRE(mirror >= lows[k]);
+            if (intervals[k] == PRNG_Open0_Close1)
+                BOOST_REQUIRE(mirror <= highs[k]);
+            else
+                BOOST_REQUIRE(mirror < highs[k]);
+        }
+        BOOST_CHECK_EQUAL(values[n - 1], expected[n / 2]);
+        // Same position in the sequence as the reference
+        BOOST_CHECK_EQUAL(prng.Get_Random(), reference.Get_Random());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Sampling_Stratified)
+{
+    const int nb_strata = 7;
+    const uint64_t n = 7000;
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    std::vector<double> values(n);
+    prng::Fill_Stratified(prng, &values[0], n, nb_strata, PRNG_Close0_Open1);
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        const double stratum = double(i % nb_strata);
+        BOOST_REQUIRE(values[i] >= stratum / nb_strata);
+        BOOST_REQUIRE(values[i] <= (stratum + 1.0) / nb_strata);
+        // Open end of the stratum, as Fill_Stratified() computes it
+        const double upper = (i % nb_strata == nb_strata - 1 ? 1.0 : (1.0 / nb_strata) * (stratum + 1.0));
+        BOOST_REQUIRE(values[i] < upper);
+    }
+
+    prng::Fill_Stratified(prng, &values[0], n, nb_strata, PRNG_CloseN1_Open1);
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        const double stratum = double(i % nb_strata);
+        BOOST_REQUIRE(values[i] >= -1.0 + 2.0 * stratum / nb_strata);
+        BOOST_REQUIRE(values[i] <= -1.0 + 2.0 * (stratum + 1.0) / nb_strata);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Sampling_Latin_Hypercube)
+{
+    const uint64_t n = 1000;
+    const int dimension = 5;
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    std::vector<double> points(n * dimension);
+    prng::Fill_Latin_Hypercube(prng, &points[0], n, dimension, PRNG_Close0_Open1);
+    std::vector<uint64_t> first_strata(n);
+    for (int d = 0 ; d < dimension ; d++)
+    {
+        // Exactly one point per stratum
+        std::vector<int> counts(n, 0);
+        for (uint64_t i = 0 ; i < n ; i++)
+        {
+            const double x = points[d * n + i];
+            BOOST_REQUIRE(x >= 0.0 && x < 1.0);
+            const uint64_t stratum = uint64_t(x * double(n));
+            counts[stratum]++;
+            if (d == 0)
+                first_strata[i] = stratum;
+        }
+        BOOST_CHECK(std::count(counts.begin(), counts.end(), 1) == int(n));
+    }
+
+    // Coordinates are shuffled independently
+    int same_strata = 0;
+    for (uint64_t i = 0 ; i < n ; i++)
+        if (uint64_t(points[n + i] * double(n)) == first_strata[i])
+            same_strata++;
+    BOOST_CHECK(same_strata < 10);
+}
+
+BOOST_AUTO_TEST_CASE(Sampling_Without_Replacement)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    // Selection sampling, Floyd's algorithm (small and hash set)
+    const int nb_cases = 3;
+    const uint64_t ns[nb_cases] = {40, 1000, 100000};
+    const uint64_t ks[nb_cases] = {10, 5, 200};
+    const int nb_trials = 20000;
+    for (int c = 0 ; c < nb_cases ; c++)
+    {
+        const uint64_t n = ns[c];
+        const uint64_t k = ks[c];
+        std::vector<uint64_t> sample(k);
+        int nb_first = 0, nb_last = 0;
+        for (int t = 0 ; t < nb_trials ; t++)
+        {
+            prng::Sample_Without_Replacement(prng, n, k, &sample[0]);
+            for (uint64_t i = 0 ; i < k ; i++)
+            {
+                BOOST_REQUIRE(sample[i] < n);
+                if (i > 0)
+                    BOOST_REQUIRE(sample[i - 1] < sample[i]);
+            }
+            nb_first += (sample[0] == 0 ? 1 : 0);
+            nb_last  += (sample[k - 1] == n - 1 ? 1 : 0);
+        }
+        // Each integer is in the sample with probability k/n
+        const double expected = double(nb_trials) * double(k) / double(n);
+        BOOST_CHECK(std::fabs(nb_first - expected) < 5.0 * std::sqrt(expected) + 1.0);
+        BOOST_CHECK(std::fabs(nb_last  - expected) < 5.0 * std::sqrt(expected) + 1.0);
+    }
+
+    // The whole population
+    std::vector<uint64_t> all(7);
+    prng::Sample_Without_Replacement(prng, 7, 7, &all[0]);
+    for (uint64_t i = 0 ; i < 7 ; i++)
+        BOOST_CHECK_EQUAL(all[i], i);
+}
+
+BOOST_AUTO_TEST_CASE(Sampling_Reservoir)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    const uint64_t n = 1000;
+    const uint64_t k = 10;
+    const int nb_trials = 20000;
+    int nb_head = 0, nb_tail = 0;
+    for (int t = 0 ; t < nb_trials ; t++)
+    {
+        Reservoir<uint64_t> reservoir(prng, k);
+        for (uint64_t i = 0 ; i < n ; i++)
+            reservoir.Add(i);
+        BOOST_REQUIRE_EQUAL(reservoir.Get_Sample().size(), k);
+        for (uint64_t s = 0 ; s < k ; s++)
+        {
+            nb_head += (reservoir.Get_Sample()[s] < 100 ? 1 : 0);
+            nb_tail += (reservoir.Get_Sample()[s] >= n - 100 ? 1 : 0);
+        }
+    }
+    // 100 items, each kept with probability k/n
+    const double expected = double(nb_trials) * 100.0 * double(k) / double(n);
+    BOOST_CHECK(std::fabs(nb_head - expected) < 5.0 * std::sqrt(expected));
+    BOOST_CHECK(std::fabs(nb_tail - expected) < 5.0 * std::sqrt(expected));
+
+    // Skipping gives the same sample, with few random numbers
+    PRNG prng_add, prng_skip;
+    prng_add.Initialize(7, true);  // quiet == true
+    prng_skip.Initialize(7, true); // quiet == true
+    Reservoir<uint64_t> added(prng_add, k), skipped(prng_skip, k);
+    const uint64_t long_n = 10000000;
+    for (uint64_t i = 0 ; i < long_n ; i++)
+        added.Add(i);
+    uint64_t i = 0;
+    while (i < long_n)
+    {
+        const uint64_t nb_skip = std::min(skipped.Nb_To_Skip(), long_n - i);
+        skipped.Skip(nb_skip);
+        i += nb_skip;
+        if (i < long_n)
+            BOOST_REQUIRE(skipped.Add(i++));
+    }
+    BOOST_CHECK_EQUAL(skipped.Get_Nb_Seen(), long_n);
+    BOOST_CHECK(added.Get_Sample() == skipped.Get_Sample());
+    BOOST_CHECK(prng_skip.Get_Nb_Calls() < 1000);
+
+    // Very long streams: the skips grow past 1/DBL_EPSILON items (where
+    // 1 - w is 1) without wrapping the index around
+    PRNG prng_long;
+    prng_long.Initialize(7, true); // quiet == true
+    Reservoir<uint64_t> single(prng_long, 1);
+    single.Add(0);
+    int nb_kept = 0;
+    while (single.Nb_To_Skip() < ~uint64_t(0) - single.Get_Nb_Seen() && nb_kept < 1000)
+    {
+        const uint64_t nb_seen = single.Get_Nb_Seen();
+        single.Skip(single.Nb_To_Skip());
+        BOOST_REQUIRE(single.Add(single.Get_Nb_Seen()));
+        BOOST_REQUIRE(single.Get_Nb_Seen() > nb_seen);
+        nb_kept++;
+    }
+    BOOST_CHECK(single.Get_Nb_Seen() > uint64_t(1) << 60);
+    BOOST_CHECK(nb_kept < 200); // log(n) replacements
+    BOOST_CHECK_EQUAL(single.Get_Sample()[0], single.Get_Nb_Seen() - 1);
+}
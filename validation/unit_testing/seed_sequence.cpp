@@ -0,0 +1,124 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <set>
+#include <cmath>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Seed_Sequence.hpp>
+
+#include "Bits.hpp"
+
+BOOST_AUTO_TEST_CASE(Seed_Sequence_Seed_Sizes)
+{
+    // A 64-bit seed is its low then high 32-bit words; a longer seed
+    // (even with zeros) is a different one.
+    const uint64_t seed = (uint64_t(0x01234567) << 32) | uint64_t(0x89abcdef);
+    const uint32_t words[4] = {0x89abcdef, 0x01234567, 0, 0};
+
+    BOOST_CHECK_EQUAL(Seed_Sequence(seed).Stream_Seed(3), Seed_Sequence(words, 2).Stream_Seed(3));
+    BOOST_CHECK_EQUAL(Seed_Sequence(0, seed).Stream_Seed(3), Seed_Sequence(words, 4).Stream_Seed(3));
+    BOOST_CHECK(Seed_Sequence(seed).Stream_Seed(3) != Seed_Sequence(0, seed).Stream_Seed(3));
+    BOOST_CHECK(Seed_Sequence(seed).Stream_Seed(3) != Seed_Sequence(seed + 1).Stream_Seed(3));
+    BOOST_CHECK(Seed_Sequence(1, seed).Stream_Seed(3) != Seed_Sequence(0, seed).Stream_Seed(3));
+}
+
+BOOST_AUTO_TEST_CASE(Seed_Sequence_Streams_Are_Distinct_And_Mixed)
+{
+    const int nb_streams = 100000;
+    const Seed_Sequence seed_sequence(42);
+
+    // Distinct seeds, and about half of the bits change between
+    // consecutive streams.
+    std::set<uint64_t> seeds;
+    double flipped = 0.0;
+    uint64_t previous = seed_sequence.Stream_Seed(0);
+    seeds.insert(previous);
+    for (int i = 1 ; i < nb_streams ; i++)
+    {
+        const uint64_t stream_seed = seed_sequence.Stream_Seed(uint64_t(i));
+        seeds.insert(stream_seed);
+        flipped += double(__builtin_popcountll(stream_seed ^ previous));
+        previous = stream_seed;
+    }
+    BOOST_CHECK_EQUAL(seeds.size(), size_t(nb_streams));
+    BOOST_CHECK_CLOSE(flipped / double(nb_streams - 1), 32.0, 1.0);
+
+    // Generate() is deterministic and differs between streams
+    uint32_t words_a[7], words_b[7], words_c[7];
+    seed_sequence.Generate(words_a, 7, 5);
+    seed_sequence.Generate(words_b, 7, 5);
+    seed_sequence.Generate(words_c, 7, 6);
+    BOOST_CHECK_EQUAL_COLLECTIONS(words_a, words_a + 7, words_b, words_b + 7);
+    BOOST_CHECK(words_a[0] != words_c[0] || words_a[1] != words_c[1]);
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_Initialize_Array_Same_As_One_By_One)
+{
+    const int nb_prngs = 1000;
+    const Seed_Sequence seed_sequence(2012, 7);
+
+    std::vector<PRNG> prngs(nb_prngs);
+    PRNG::Initialize_Array(&prngs[0], nb_prngs, seed_sequence, 100);
+
+    // First numbers of the streams: independent uniforms
+    double sum = 0.0;
+    double sum_products = 0.0;
+    double previous = 0.0;
+    for (int i = 0 ; i < nb_prngs ; i++)
+    {
+        PRNG prng;
+        prng.Initialize(seed_sequence, uint64_t(100 + i), true); // quiet == true
+        BOOST_CHECK_EQUAL(prngs[i].Get_Seed(), prng.Get_Seed());
+        for (int j = 0 ; j < 10 ; j++)
+            BOOST_CHECK_EQUAL(prngs[i].Get_Random_Close1_Open2(), prng.Get_Random_Close1_Open2());
+
+        const double r = prngs[i].Get_Random_Close0_Open1() - 0.5;
+        sum += r;
+        sum_products += r * previous;
+        previous = r;
+    }
+    BOOST_CHECK_SMALL(sum / double(nb_prngs), 0.05);
+    BOOST_CHECK_SMALL(sum_products / double(nb_prngs), 0.01);
+
+    // Known values of streams 100, 101 and 1099, also after initializing
+    // the same generators again
+    const int streams[3] = {0, 1, nb_prngs - 1};
+    const uint32_t seeds[3] = {2618405919U, 407203732U, 1057658895U};
+    const double firsts[3][3] = {{1.9275968484460677, 1.126254685254247,  1.6582875428975203},
+                                 {1.0708157935447526, 1.8046950974435088, 1.1334468939036597},
+                                 {1.2440709066160311, 1.1603253239718734, 1.2783576674094759}};
+    for (int k = 0 ; k < 2 ; k++)
+    {
+        PRNG::Initialize_Array(&prngs[0], nb_prngs, seed_sequence, 100);
+        for (int s = 0 ; s < 3 ; s++)
+        {
+            BOOST_CHECK_EQUAL(prngs[streams[s]].Get_Seed(), seeds[s]);
+            for (int j = 0 ; j < 3 ; j++)
+                BOOST_CHECK_EQUAL(prngs[streams[s]].Get_Random_Close1_Open2(), firsts[s][j]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PRNG_Initialize_By_Array)
+{
+    const uint32_t key[4] = {0x123, 0x234, 0x345, 0x456};
+    const uint32_t other_key[4] = {0x123, 0x234, 0x345, 0x457};
+
+    PRNG prng_a, prng_b, prng_c;
+    prng_a.Initialize_By_Array(key, 4, true);        // quiet == true
+    prng_b.Initialize_By_Array(key, 4, true);        // quiet == true
+    prng_c.Initialize_By_Array(other_key, 4, true);  // quiet == true
+
+    BOOST_CHECK_EQUAL(prng_a.Get_Seed(), key[0]);
+    int nb_same = 0;
+    for (int i = 0 ; i < 1000 ; i++)
+    {
+        const double r = prng_a.Get_Random();
+        BOOST_CHECK_EQUAL(r, prng_b.Get_Random());
+        if (Same_Bits(r, prng_c.Get_Random()))
+            ++nb_same;
+    }
+    BOOST_CHECK_EQUAL(nb_same, 0);
+}
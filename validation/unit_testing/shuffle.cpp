@@ -0,0 +1,156 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Random_Integers.hpp>
+#include <Shuffle.hpp>
+
+BOOST_AUTO_TEST_CASE(Random_Integers_Bounded)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+    Random_Integers integers(prng);
+
+    const uint64_t bound = 6;
+    const int nb_draws = 600000;
+    std::vector<int> counts(bound, 0);
+    for (int i = 0 ; i < nb_draws ; i++)
+    {
+        const uint64_t x = integers.Next_Bounded(bound);
+        BOOST_REQUIRE(x < bound);
+        counts[x]++;
+    }
+    for (uint64_t b = 0 ; b < bound ; b++)
+        BOOST_CHECK(std::abs(counts[b] - nb_draws / int(bound)) < 1500); // ~5 sigma
+
+    // Bound above 2^63: a third of the numbers are above 2^63
+    const uint64_t large_bound = uint64_t(3) << 62;
+    int nb_high = 0;
+    for (int i = 0 ; i < 100000 ; i++)
+    {
+        const uint64_t x = integers.Next_Bounded(large_bound);
+        BOOST_REQUIRE(x < large_bound);
+        nb_high += int(x >> 63);
+    }
+    BOOST_CHECK(std::abs(nb_high - 33333) < 1000);
+
+    BOOST_CHECK_EQUAL(integers.Next_Bounded(1), uint64_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(Shuffle_Small_Uniform)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    // All 24 orders of 4 entries are equally likely
+    const int nb_trials = 240000;
+    std::vector<int> counts(256, 0);
+    for (int t = 0 ; t < nb_trials ; t++)
+    {
+        uint32_t array[4];
+        prng::Random_Permutation(prng, array, 4);
+        counts[array[0] * 64 + array[1] * 16 + array[2] * 4 + array[3]]++;
+    }
+    double chi2 = 0.0;
+    int nb_orders = 0;
+    for (int c = 0 ; c < 256 ; c++)
+    {
+        if (counts[c] == 0)
+            continue;
+        nb_orders++;
+        chi2 += (counts[c] - 10000.0) * (counts[c] - 10000.0) / 10000.0;
+    }
+    BOOST_CHECK_EQUAL(nb_orders, 24);
+    BOOST_CHECK(chi2 < 60.0); // 23 degrees of freedom
+}
+
+BOOST_AUTO_TEST_CASE(Shuffle_Parallel_Independent_Of_Threads)
+{
+    const uint64_t n = 5 * prng::shuffle_chunk_size + 1234;
+    std::vector<std::vector<uint64_t> > permutations(3);
+    for (int t = 0 ; t < 3 ; t++)
+    {
+        PRNG prng;
+        prng.Initialize(42, true); // quiet == true
+        permutations[t].resize(n);
+        prng::Random_Permutation(prng, &permutations[t][0], n, 2 + 2 * t);
+    }
+    BOOST_CHECK(permutations[0] == permutations[1]);
+    BOOST_CHECK(permutations[0] == permutations[2]);
+
+    // A permutation, mixed across the chunks
+    std::vector<uint64_t> sorted(permutations[0]);
+    std::sort(sorted.begin(), sorted.end());
+    for (uint64_t i = 0 ; i < n ; i++)
+        BOOST_REQUIRE_EQUAL(sorted[i], i);
+    uint64_t nb_low = 0;
+    for (uint64_t i = 0 ; i < n / 2 ; i++)
+        nb_low += (permutations[0][i] < n / 2 ? 1 : 0);
+    BOOST_CHECK(std::fabs(double(nb_low) - double(n) / 4.0) < 5.0 * std::sqrt(double(n) / 16.0));
+    uint64_t nb_fixed = 0;
+    for (uint64_t i = 0 ; i < n ; i++)
+        nb_fixed += (permutations[0][i] == i ? 1 : 0);
+    BOOST_CHECK(nb_fixed < 10);
+
+    // Another state, another permutation
+    PRNG prng;
+    prng.Initialize(43, true); // quiet == true
+    std::vector<uint64_t> other(n);
+    prng::Random_Permutation(prng, &other[0], n, 2);
+    BOOST_CHECK(other != permutations[0]);
+
+    // Single-threaded (Fisher-Yates)
+    prng::Random_Permutation(prng, &other[0], n);
+    sorted = other;
+    std::sort(sorted.begin(), sorted.end());
+    for (uint64_t i = 0 ; i < n ; i++)
+        BOOST_REQUIRE_EQUAL(sorted[i], i);
+}
+
+BOOST_AUTO_TEST_CASE(Shuffle_Merge_Uniform)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    // Chunks of one entry: the order of 4 entries only comes from the two merge levels
+    const int nb_trials = 24000;
+    std::vector<int> counts(256, 0);
+    for (int t = 0 ; t < nb_trials ; t++)
+    {
+        uint32_t array[4];
+        prng::Random_Permutation(prng, array, 4, 2, 1);
+        counts[array[0] * 64 + array[1] * 16 + array[2] * 4 + array[3]]++;
+    }
+    double chi2 = 0.0;
+    int nb_orders = 0;
+    for (int c = 0 ; c < 256 ; c++)
+    {
+        if (counts[c] == 0)
+            continue;
+        nb_orders++;
+        chi2 += (counts[c] - 1000.0) * (counts[c] - 1000.0) / 1000.0;
+    }
+    BOOST_CHECK_EQUAL(nb_orders, 24);
+    BOOST_CHECK(chi2 < 60.0); // 23 degrees of freedom
+
+    // 11 entries in chunks of 2 (the last one shorter): four merge levels,
+    // each value equally likely at each position
+    const uint64_t n = 11;
+    const int nb_shuffles = 11000;
+    std::vector<int> positions(n * n, 0);
+    for (int t = 0 ; t < nb_shuffles ; t++)
+    {
+        uint64_t array[n];
+        prng::Random_Permutation(prng, array, n, 3, 2);
+        for (uint64_t i = 0 ; i < n ; i++)
+            positions[array[i] * n + i]++;
+    }
+    chi2 = 0.0;
+    for (uint64_t c = 0 ; c < n * n ; c++)
+        chi2 += (positions[c] - 1000.0) * (positions[c] - 1000.0) / 1000.0;
+    BOOST_CHECK(chi2 < 170.0); // 100 degrees of freedom, ~5 sigma
+}
@@ -0,0 +1,149 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <cstring>
+
+#include <PseudoRandomNumberGenerator.hpp>
+#include <Vector_Math.hpp>
+
+#include "Bits.hpp"
+
+// Distance in units in the last place between two finite doubles
+static double Ulps(const double a, const double b)
+{
+    if (Same_Bits(a, b))
+        return 0.0;
+    int exponent;
+    std::frexp(b, &exponent);
+    return std::fabs(a - b) / std::ldexp(1.0, exponent - 53);
+}
+
+BOOST_AUTO_TEST_CASE(Vector_Math_Arrays_Same_As_Scalar)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    // Wide range of magnitudes, signs and special values; not a
+    // multiple of any vector width
+    const uint64_t n = 100003;
+    std::vector<double> x(n);
+    prng.Fill_Array(&x[0], n, PRNG_CloseN1_Open1);
+    for (uint64_t i = 0 ; i < n ; i++)
+        x[i] = std::ldexp(x[i], int(i % 2200) - 1100);
+    x[0] = 0.0;
+    x[1] = -0.0;
+    x[2] = std::numeric_limits<double>::infinity();
+    x[3] = -std::numeric_limits<double>::infinity();
+    x[4] = std::numeric_limits<double>::quiet_NaN();
+    x[5] = std::numeric_limits<double>::denorm_min();
+
+    std::vector<double> y(n), sines(n), cosines(n);
+    prng::Log_Array(&x[0], &y[0], n);
+    for (uint64_t i = 0 ; i < n ; i++)
+        BOOST_REQUIRE(Same_Bits(y[i], prng::Log(x[i])));
+    prng::Exp_Array(&x[0], &y[0], n);
+    for (uint64_t i = 0 ; i < n ; i++)
+        BOOST_REQUIRE(Same_Bits(y[i], prng::Exp(x[i])));
+    prng::Sqrt_Array(&x[0], &y[0], n);
+    for (uint64_t i = 0 ; i < n ; i++)
+        BOOST_REQUIRE(Same_Bits(y[i], prng::Sqrt(x[i])));
+    prng::Sincos_Array(&x[0], &sines[0], &cosines[0], n);
+    for (uint64_t i = 0 ; i < n ; i++)
+    {
+        double sine, cosine;
+        prng::Sincos(x[i], sine, cosine);
+        BOOST_REQUIRE(Same_Bits(sines[i], sine));
+        BOOST_REQUIRE(Same_Bits(cosines[i], cosine));
+    }
+
+    // In place
+    std::vector<double> in_place(x);
+    prng::Log_Array(&in_place[0], &in_place[0], n);
+    prng::Log_Array(&x[0], &y[0], n);
+    BOOST_CHECK(std::memcmp(&in_place[0], &y[0], n * sizeof(double)) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(Vector_Math_Accuracy)
+{
+    PRNG prng;
+    prng.Initialize(42, true); // quiet == true
+
+    const int n = 200000;
+    double max_log = 0.0, max_exp = 0.0, max_sin = 0.0, max_cos = 0.0;
+    for (int i = 0 ; i < n ; i++)
+    {
+        const double u = prng.Get_Random();                       // ]0,1]
+        const double x = std::ldexp(u, (i % 2000) - 1000);        // Positive, normal
+        max_log = std::max(max_log, Ulps(prng::Log(x), std::log(x)));
+        const double e = 1400.0 * (u - 0.5);                      // [-700, 700]
+        max_exp = std::max(max_exp, Ulps(prng::Exp(e), std::exp(e)));
+        const double a = 20.0 * (u - 0.5) * (i % 3 == 0 ? 1000.0 : 1.0);
+        double sine, cosine;
+        prng::Sincos(a, sine, cosine);
+        // Absolute error near the zeros
+        max_sin = std::max(max_sin, std::fabs(sine   - std::sin(a)) / std::ldexp(1.0, -53));
+        max_cos = std::max(max_cos, std::fabs(cosine - std::cos(a)) / std::ldexp(1.0, -53));
+    }
+    BOOST_CHECK(max_log <= 1.0);
+    BOOST_CHECK(max_exp <= 1.0);
+    BOOST_CHECK(max_sin <= 2.0);
+    BOOST_CHECK(max_cos <= 2.0);
+
+    // Special values
+    BOOST_CHECK(Same_Bits(prng::Log(0.0), -std::numeric_limits<double>::infinity()));
+    BOOST_CHECK(std::isnan(prng::Log(-1.0)));
+    BOOST_CHECK_EQUAL(prng::Log(1.0), 0.0);
+    BOOST_CHECK(std::fabs(prng::Log(std::numeric_limits<double>::denorm_min()) + 744.4400719213812) < 1e-12);
+    BOOST_CHECK_EQUAL(prng::Exp(0.0), 1.0);
+    BOOST_CHECK(Same_Bits(prng::Exp(710.0), std::numeric_limits<double>::infinity()));
+    BOOST_CHECK_EQUAL(prng::Exp(-800.0), 0.0);
+    BOOST_CHECK(prng::Exp(-745.0) > 0.0);
+    BOOST_CHECK(Ulps(prng::Exp(709.5), std::exp(709.5)) <= 1.0);
+    double sine, cosine;
+    prng::Sincos(std::numeric_limits<double>::infinity(), sine, cosine);
+    BOOST_CHECK(std::isnan(sine) && std::isnan(cosine));
+}
+
+BOOST_AUTO_TEST_CASE(Vector_Math_Fill_Array_Normal)
+{
+    PRNG prng, uniforms;
+    prng.Initialize(42, true);      // quiet == true
+    uniforms.Initialize(42, true);  // quiet == true
+
+    // Same as the scalar reference on the same uniforms (odd n)
+    const uint64_t n = 2001;
+    std::vector<double> normals(n);
+    prng.Fill_Array_Normal(&normals[0], n, 1.0, 2.0);
+    std::vector<double> u1(1001), u2(1001);
+    uniforms.Fill_Array(&u1[0], 512, PRNG_Open0_Close1);
+    uniforms.Fill_Array(&u2[0], 512, PRNG_Close0_Open1);
+    uniforms.Fill_Array(&u1[512], 489, PRNG_Open0_Close1);
+    uniforms.Fill_Array(&u2[512], 489, PRNG_Close0_Open1);
+    for (uint64_t p = 0 ; p < 1001 ; p++)
+    {
+        double z0, z1;
+        prng::Box_Muller(u1[p], u2[p], 1.0, 2.0, z0, z1);
+        BOOST_REQUIRE(Same_Bits(normals[2*p], z0));
+        if (2*p + 1 < n)
+            BOOST_REQUIRE(Same_Bits(normals[2*p + 1], z1));
+    }
+    BOOST_CHECK_EQUAL(prng.Get_Random(), uniforms.Get_Random());
+
+    // Moments
+    const uint64_t nb = 1000000;
+    std::vector<double> z(nb);
+    prng.Fill_Array_Normal(&z[0], nb);
+    double sum = 0.0, sum2 = 0.0, sum4 = 0.0;
+    for (uint64_t i = 0 ; i < nb ; i++)
+    {
+        sum  += z[i];
+        sum2 += z[i] * z[i];
+        sum4 += z[i] * z[i] * z[i] * z[i];
+    }
+    BOOST_CHECK(std::fabs(sum / double(nb)) < 5e-3);
+    BOOST_CHECK(std::fabs(sum2 / double(nb) - 1.0) < 7e-3);
+    BOOST_CHECK(std::fabs(sum4 / double(nb) - 3.0) < 5e-2);
+}